@@ -0,0 +1,408 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include "BatchRunner.hxx"
+#include "InputScript.hxx"
+#include "FSNode.hxx"
+#include "CartDetector.hxx"
+#include "Cart.hxx"
+#include "MD5.hxx"
+#include "Control.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "TIA.hxx"
+#include "TIAConstants.hxx"
+#include "ConsoleTiming.hxx"
+#include "FrameManager.hxx"
+#include "FrameLayoutYStartDetector.hxx"
+#include "System.hxx"
+#include "Joystick.hxx"
+#include "Switches.hxx"
+#include "Event.hxx"
+#include "Random.hxx"
+#include "DispatchResult.hxx"
+
+using namespace std::chrono;
+
+namespace {
+  constexpr uInt32 FRAMES_DEFAULT = 600;
+
+  // Split 'rom[:frames[:script]]'
+  void splitJobSpec(const string& spec, string& rom, string& frames, string& script)
+  {
+    size_t first = spec.find(':');
+    rom = spec.substr(0, first);
+    if(first == string::npos) return;
+
+    size_t second = spec.find(':', first + 1);
+    frames = spec.substr(first + 1, second == string::npos ? string::npos : second - first - 1);
+    if(second == string::npos) return;
+
+    script = spec.substr(second + 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BatchRunner::BatchRunner(int argc, char* argv[])
+  : myNextJob(0),
+    myNextReport(0),
+    myThreads(std::max(std::thread::hardware_concurrency(), 1u)),
+    myDefaultFrames(FRAMES_DEFAULT),
+    myHashInterval(1),
+    myDumpRAM(false),
+    mySeed(0),
+    myFailedJobs(0),
+    myTotalFrames(0),
+    myValid(true)
+{
+  vector<string> specs;
+
+  for (int i = 1; i < argc && myValid; i++) {
+    string arg = argv[i];
+
+    // All options but '-ram' take a value
+    if (arg == "-ram") {
+      myDumpRAM = true;
+      continue;
+    }
+    else if (arg[0] != '-') {
+      specs.push_back(arg);
+      continue;
+    }
+    else if (i + 1 == argc) {
+      myValid = false;
+      break;
+    }
+
+    const string value = argv[++i];
+    const int number = atoi(value.c_str());
+
+    if (arg == "-jobs")
+      myValid = addJobs(value);
+    else if (arg == "-threads" && number > 0)
+      myThreads = number;
+    else if (arg == "-frames" && number > 0)
+      myDefaultFrames = number;
+    else if (arg == "-hash" && number >= 0)
+      myHashInterval = number;
+    else if (arg == "-seed")
+      mySeed = uInt32(strtoul(value.c_str(), nullptr, 10));
+    else
+      myValid = false;
+  }
+
+  // Jobs given on the commandline come after those from a job file, and
+  // use the default frame count from the complete commandline
+  for (const string& spec: specs)
+    myValid = myValid && addJob(spec);
+
+  if (myJobs.empty()) myValid = false;
+
+  // Only the timing matters while detecting the frame layout
+  mySettings.setValue("fastscbios", true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BatchRunner::addJob(const string& spec)
+{
+  string rom, frames, script;
+  splitJobSpec(spec, rom, frames, script);
+
+  if (rom == "") return false;
+
+  myJobs.emplace_back();
+  Job& job(myJobs.back());
+
+  const int count = frames == "" ? 0 : atoi(frames.c_str());
+
+  job.romFile = rom;
+  job.frames = count > 0 ? count : myDefaultFrames;
+  job.scriptFile = script;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BatchRunner::addJobs(const string& filename)
+{
+  ifstream in(filename);
+  if (!in) {
+    cerr << "ERROR: unable to read job file " << filename << endl;
+    return false;
+  }
+
+  string line;
+  while (getline(in, line)) {
+    istringstream buf(line);
+    string spec;
+
+    if (!(buf >> spec) || spec[0] == '#') continue;
+    if (!addJob(spec)) return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BatchRunner::run()
+{
+  if (!myValid) {
+    printUsage();
+    return false;
+  }
+
+  myResults.resize(myJobs.size());
+  for (Result& result: myResults) result.done = false;
+
+  const uInt32 threads = uInt32(std::min<size_t>(myThreads, myJobs.size()));
+  cerr << "running " << myJobs.size() << " jobs on " << threads << " threads..." << endl;
+
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  // Jobs are handed out one at a time from a shared counter, so idle workers
+  // always pick up the next pending job
+  vector<std::thread> workers;
+  for (uInt32 i = 1; i < threads; i++)
+    workers.emplace_back([this]() { work(); });
+
+  work();
+  for (std::thread& worker: workers) worker.join();
+
+  double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now() - tp).count();
+
+  cout << "summary jobs=" << myJobs.size()
+       << " failed=" << myFailedJobs
+       << " frames=" << myTotalFrames
+       << " time=" << realtimeUsed
+       << " fps=" << (myTotalFrames / realtimeUsed) << endl;
+
+  return myFailedJobs == 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BatchRunner::work()
+{
+  for (;;) {
+    const size_t index = myNextJob++;
+    if (index >= myJobs.size()) return;
+
+    Result& result = myResults[index];
+
+    try {
+      if (!runOne(myJobs[index], result) && result.error == "")
+        result.error = "emulation failed";
+    }
+    catch (const std::exception& e) {
+      result.error = e.what();
+    }
+
+    report(index);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BatchRunner::runOne(const Job& job, Result& result)
+{
+  result.frames = 0;
+  result.seconds = 0;
+
+  FilesystemNode imageFile(job.romFile);
+
+  if (!imageFile.isFile()) {
+    result.error = "not a ROM image";
+    return false;
+  }
+
+  ByteBuffer image;
+  uInt32 size = imageFile.read(image);
+  if (size == 0) {
+    result.error = "unable to read ROM";
+    return false;
+  }
+
+  InputScript script;
+  if (!script.load(job.scriptFile, result.error)) return false;
+
+  string md5 = MD5::hash(image, size);
+  string type = "";
+  unique_ptr<Cartridge> cartridge = CartDetector::create(imageFile, image, size, md5, type, mySettings);
+
+  if (!cartridge) {
+    result.error = "unable to determine cartridge type";
+    return false;
+  }
+
+  result.md5 = md5;
+  result.cartType = cartridge->detectedType();
+
+  // The ROM image is not needed anymore once the cartridge holds its copy
+  image.reset();
+
+  IO consoleIO;
+  Random rng(mySeed);
+  Event event;
+  ConsoleTiming consoleTiming = ConsoleTiming::ntsc;
+
+  M6502 cpu(mySettings);
+  M6532 riot(consoleIO, mySettings);
+  TIA tia(consoleIO, [&consoleTiming]() { return consoleTiming; }, mySettings);
+  System system(rng, cpu, riot, tia, *cartridge);
+
+  consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
+  consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
+  consoleIO.mySwitches = make_unique<Switches>(event, myProps, mySettings);
+
+  tia.bindToControllers();
+  cartridge->setStartBankFromPropsFunc([]() { return -1; });
+  system.initialize();
+
+  FrameLayout frameLayout = FrameLayout::ntsc;
+  uInt32 yStart = 0;
+  {
+    FrameLayoutYStartDetector detector;
+    tia.setFrameManager(&detector);
+    tia.setHeadless(true);
+    system.reset();
+
+    for (uInt32 i = 0; i < FrameLayoutYStartDetector::maxFrames && !detector.isStable(); ++i)
+      tia.update();
+
+    frameLayout = detector.detectedLayout();
+    yStart = detector.detectedYStart();
+  }
+
+  consoleTiming = frameLayout == FrameLayout::pal ? ConsoleTiming::pal : ConsoleTiming::ntsc;
+  result.layout = frameLayout == FrameLayout::pal ? "PAL" : "NTSC";
+  result.yStart = yStart;
+
+  FrameManager frameManager;
+  tia.setFrameManager(&frameManager);
+  tia.setLayout(frameLayout);
+  tia.setYStart(yStart);
+
+  system.reset();
+
+  DispatchResult dispatchResult;
+  dispatchResult.setOk(0);
+
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  for (uInt32 frame = 0; frame < job.frames; frame++) {
+    script.apply(frame, event);
+    consoleIO.myLeftControl->update();
+    consoleIO.myRightControl->update();
+    consoleIO.mySwitches->update();
+
+    // Only draw the frames that are hashed
+    const bool hash = myHashInterval > 0 && (frame + 1) % myHashInterval == 0;
+    tia.setHeadless(!hash);
+
+    const uInt32 framesBefore = tia.framesSinceLastRender();
+    do {
+      tia.update(dispatchResult);
+    } while (dispatchResult.getStatus() == DispatchResult::Status::ok &&
+             tia.framesSinceLastRender() == framesBefore);
+
+    if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
+      result.error = "emulation failed in frame " + std::to_string(frame);
+      return false;
+    }
+
+    if (hash) {
+      tia.acquireLatestFrame();
+      result.frameHashes.emplace_back(frame,
+        MD5::hash(tia.frameBuffer(), TIAConstants::H_PIXEL * tia.height()));
+    }
+
+    result.frames++;
+  }
+
+  result.seconds = duration_cast<duration<double>>(high_resolution_clock::now() - tp).count();
+  memcpy(result.ram, riot.getRAM(), sizeof(result.ram));
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BatchRunner::report(size_t index)
+{
+  std::lock_guard<std::mutex> lock(myReportMutex);
+
+  myResults[index].done = true;
+
+  for (; myNextReport < myResults.size() && myResults[myNextReport].done; myNextReport++) {
+    const size_t i = myNextReport;
+    Result& result = myResults[i];
+
+    cout << "job " << i << " " << myJobs[i].romFile;
+
+    if (result.error != "") {
+      cout << " error: " << result.error << endl;
+      myFailedJobs++;
+      continue;
+    }
+
+    cout << " md5=" << result.md5
+         << " type=" << result.cartType
+         << " layout=" << result.layout
+         << " ystart=" << result.yStart
+         << " frames=" << result.frames
+         << " time=" << result.seconds
+         << " fps=" << (result.seconds > 0 ? result.frames / result.seconds : 0)
+         << endl;
+
+    for (const auto& frameHash: result.frameHashes)
+      cout << "frame " << i << " " << frameHash.first << " " << frameHash.second << endl;
+
+    if (myDumpRAM) {
+      cout << "ram " << i << " " << std::hex << std::setfill('0');
+      for (uInt8 byte: result.ram) cout << std::setw(2) << int(byte);
+      cout << std::dec << endl;
+    }
+
+    myTotalFrames += result.frames;
+
+    // Reported results are not needed anymore
+    vector<std::pair<uInt32, string>>().swap(result.frameHashes);
+  }
+
+  cout.flush();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BatchRunner::printUsage() const
+{
+  cerr << "Usage: stella-batch [options] <rom>[:<frames>[:<script>]] ..." << endl
+       << endl
+       << "Options:" << endl
+       << "  -jobs <file>     Read additional jobs from <file>, one per line" << endl
+       << "  -threads <n>     Number of worker threads (default: all cores)" << endl
+       << "  -frames <n>      Frames to run for jobs without a frame count (default: "
+       << FRAMES_DEFAULT << ")" << endl
+       << "  -hash <n>        Report the hash of every <n>th frame; 0 disables drawing" << endl
+       << "                   completely (default: 1)" << endl
+       << "  -ram             Report the RIOT RAM at the end of each job" << endl
+       << "  -seed <n>        Seed for the random number generator (default: 0)" << endl
+       << endl
+       << "The script holds the input for the job, one '<frame> [<input> ...]' entry per" << endl
+       << "line. Valid inputs are p0.up, p0.down, p0.left, p0.right, p0.fire (same for p1)," << endl
+       << "reset and select." << endl;
+}
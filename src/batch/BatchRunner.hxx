@@ -0,0 +1,140 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BATCH_RUNNER
+#define BATCH_RUNNER
+
+class Control;
+class Switches;
+
+#include <atomic>
+#include <mutex>
+
+#include "bspf.hxx"
+#include "Settings.hxx"
+#include "ConsoleIO.hxx"
+#include "Props.hxx"
+
+/**
+  Runs a batch of jobs on independent headless consoles, spread across all
+  cores.  Each job runs a ROM for a number of frames with scripted input
+  (see InputScript), and reports frame hashes, the RIOT RAM and timing.
+
+  The consoles are assembled from the emulation core only (like the
+  ProfilingRunner), so this works without SDL and without an OSystem.  The
+  settings and properties are shared by all consoles and must not be changed
+  while the jobs run.
+*/
+class BatchRunner {
+  public:
+
+    BatchRunner(int argc, char* argv[]);
+
+    bool run();
+
+  private:
+
+    struct Job {
+      string romFile;
+      uInt32 frames;
+      string scriptFile;
+    };
+
+    struct Result {
+      bool done;
+      string error;
+
+      string md5;
+      string cartType;
+      string layout;
+      uInt32 yStart;
+      uInt32 frames;
+      double seconds;
+
+      vector<std::pair<uInt32, string>> frameHashes;
+      uInt8 ram[128];
+    };
+
+    struct IO: public ConsoleIO {
+        Controller& leftController() const override { return *myLeftControl; }
+        Controller& rightController() const override { return *myRightControl; }
+        Switches& switches() const override { return *mySwitches; }
+
+        unique_ptr<Controller> myLeftControl;
+        unique_ptr<Controller> myRightControl;
+        unique_ptr<Switches> mySwitches;
+    };
+
+  private:
+
+    bool addJob(const string& spec);
+
+    bool addJobs(const string& filename);
+
+    void work();
+
+    bool runOne(const Job& job, Result& result);
+
+    void report(size_t index);
+
+    void printUsage() const;
+
+  private:
+
+    vector<Job> myJobs;
+
+    vector<Result> myResults;
+
+    // Index of the next job to hand out to a worker
+    std::atomic<size_t> myNextJob;
+
+    // Index of the next result to print; results are printed in job order
+    size_t myNextReport;
+
+    std::mutex myReportMutex;
+
+    uInt32 myThreads;
+
+    uInt32 myDefaultFrames;
+
+    // Hash every n-th frame (0: no hashes, run fully headless)
+    uInt32 myHashInterval;
+
+    bool myDumpRAM;
+
+    uInt32 mySeed;
+
+    uInt32 myFailedJobs;
+
+    uInt64 myTotalFrames;
+
+    bool myValid;
+
+    Settings mySettings;
+
+    Properties myProps;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BatchRunner() = delete;
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner(BatchRunner&&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+    BatchRunner& operator=(BatchRunner&&) = delete;
+};
+
+#endif // BATCH_RUNNER
@@ -0,0 +1,130 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Benchmark.hxx"
+#include "Audio.hxx"
+#include "AudioQueue.hxx"
+#include "SimpleResampler.hxx"
+#include "LanczosResampler.hxx"
+
+namespace {
+  // TIA sample rate (two samples per line) and the size of the fragments
+  // it produces
+  constexpr uInt32 TIA_SAMPLE_RATE = 31440;
+  constexpr uInt32 TIA_FRAGMENT_SIZE = 512;
+
+  constexpr uInt32 OUTPUT_SAMPLE_RATE = 48000;
+  constexpr uInt32 OUTPUT_FRAGMENT_SIZE = 1024;
+
+  /**
+    An Audio instance with a queue, and both channels playing a tone.
+  */
+  shared_ptr<Audio> playingAudio(bool stereo)
+  {
+    shared_ptr<Audio> audio = make_shared<Audio>();
+    shared_ptr<AudioQueue> queue = make_shared<AudioQueue>(TIA_FRAGMENT_SIZE, 30, stereo);
+
+    // Nobody consumes the samples
+    queue->ignoreOverflows(true);
+
+    audio->setAudioQueue(queue);
+    audio->reset();
+
+    audio->channel0().audc(0x04);
+    audio->channel0().audf(0x08);
+    audio->channel0().audv(0x0f);
+    audio->channel1().audc(0x08);
+    audio->channel1().audf(0x1f);
+    audio->channel1().audv(0x0a);
+
+    return audio;
+  }
+
+  /**
+    Benchmark a resampler from TIA audio to the output rate.  The input is a
+    fixed fragment of noise.
+  */
+  template<class T, typename... Args>
+  Benchmark::Batch resampler(bool stereo, Args... args)
+  {
+    shared_ptr<vector<Int16>> input =
+      make_shared<vector<Int16>>(TIA_FRAGMENT_SIZE * (stereo ? 2 : 1));
+
+    uInt32 seed = 1;
+    for (Int16& sample: *input) {
+      seed = seed * 1103515245 + 12345;
+      sample = Int16(seed >> 16);
+    }
+
+    shared_ptr<T> resampler = make_shared<T>(
+      Resampler::Format(TIA_SAMPLE_RATE, TIA_FRAGMENT_SIZE, stereo),
+      Resampler::Format(OUTPUT_SAMPLE_RATE, OUTPUT_FRAGMENT_SIZE, true),
+      [input]() { return input->data(); },
+      args...
+    );
+
+    return [resampler](uInt64 samples) {
+      float fragment[2 * OUTPUT_FRAGMENT_SIZE];
+      const uInt64 fragments = samples / OUTPUT_FRAGMENT_SIZE + 1;
+
+      for (uInt64 i = 0; i < fragments; i++)
+        resampler->fillFragment(fragment, 2 * OUTPUT_FRAGMENT_SIZE);
+
+      Benchmark::consume(uInt64(fragment[0] * 1000));
+
+      return fragments * OUTPUT_FRAGMENT_SIZE;
+    };
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addAudioBenchmarks(Benchmark& benchmark)
+{
+  // Audio::tick() is called for each color clock
+  for (bool stereo: { false, true }) {
+    shared_ptr<Audio> audio = playingAudio(stereo);
+
+    benchmark.add(stereo ? "audio.tick.stereo" : "audio.tick", "clock",
+      [audio](uInt64 clocks) {
+        for (uInt64 i = 0; i < clocks; i++) audio->tick();
+
+        return clocks;
+      }
+    );
+  }
+
+  // While the TIA catches up with the CPU, it clocks the audio in bulk
+  {
+    shared_ptr<Audio> audio = playingAudio(false);
+
+    benchmark.add("audio.tick.bulk", "clock", [audio](uInt64 clocks) {
+      const uInt64 lines = clocks / 228 + 1;
+      for (uInt64 i = 0; i < lines; i++) audio->tick(228);
+
+      return lines * 228;
+    });
+  }
+
+  benchmark.add("audio.resample.simple", "sample",
+                resampler<SimpleResampler>(false));
+  benchmark.add("audio.resample.lanczos2", "sample",
+                resampler<LanczosResampler>(false, 2u));
+  benchmark.add("audio.resample.lanczos3", "sample",
+                resampler<LanczosResampler>(false, 3u));
+  benchmark.add("audio.resample.lanczos3.stereo", "sample",
+                resampler<LanczosResampler>(true, 3u));
+}
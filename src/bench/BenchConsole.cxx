@@ -0,0 +1,112 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "BenchConsole.hxx"
+#include "FSNode.hxx"
+#include "CartDetector.hxx"
+#include "Cart.hxx"
+#include "MD5.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "TIA.hxx"
+#include "FrameManager.hxx"
+#include "System.hxx"
+#include "Joystick.hxx"
+#include "Switches.hxx"
+#include "DispatchResult.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BenchConsole::BenchConsole(const ByteBuffer& image, uInt32 size, const string& name)
+  : myRandom(0),
+    myConsoleTiming(ConsoleTiming::ntsc)
+{
+  string md5 = MD5::hash(image, size);
+  myCart = CartDetector::create(FilesystemNode(name), image, size, md5, "", mySettings);
+
+  if (!myCart) throw runtime_error("unable to determine cartridge type");
+
+  myCpu = make_unique<M6502>(mySettings);
+  myRiot = make_unique<M6532>(myIO, mySettings);
+  myTIA = make_unique<TIA>(myIO, [this]() { return myConsoleTiming; }, mySettings);
+  mySystem = make_unique<System>(myRandom, *myCpu, *myRiot, *myTIA, *myCart);
+
+  myIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, myEvent, *mySystem);
+  myIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, myEvent, *mySystem);
+  myIO.mySwitches = make_unique<Switches>(myEvent, myProperties, mySettings);
+
+  myTIA->bindToControllers();
+  myCart->setStartBankFromPropsFunc([]() { return -1; });
+  mySystem->initialize();
+
+  myFrameManager = make_unique<FrameManager>();
+  myTIA->setFrameManager(myFrameManager.get());
+  myTIA->setLayout(FrameLayout::ntsc);
+  myTIA->setHeadless(true);
+
+  mySystem->reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BenchConsole::~BenchConsole()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ByteBuffer BenchConsole::image4K(const vector<uInt8>& code)
+{
+  ByteBuffer image = make_unique<uInt8[]>(4096);
+
+  std::fill_n(image.get(), 4096, 0x00);
+  std::copy(code.begin(), code.end(), image.get());
+
+  // Reset and break vectors
+  image[0xffc] = image[0xffe] = 0x00;
+  image[0xffd] = image[0xfff] = 0xf0;
+
+  return image;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 BenchConsole::runCycles(uInt64 cycles)
+{
+  DispatchResult result;
+  uInt64 executed = 0;
+
+  // Execution stops at the end of each frame
+  while (executed < cycles) {
+    myCpu->execute(cycles - executed, result);
+    if (result.getStatus() != DispatchResult::Status::ok)
+      throw runtime_error("emulation failed");
+
+    executed += result.getCycles();
+  }
+
+  return executed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BenchConsole::runFrame()
+{
+  DispatchResult result;
+  const uInt32 framesBefore = myTIA->framesSinceLastRender();
+
+  do {
+    myTIA->update(result);
+    if (result.getStatus() != DispatchResult::Status::ok)
+      throw runtime_error("emulation failed");
+  } while (myTIA->framesSinceLastRender() == framesBefore);
+}
@@ -0,0 +1,110 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BENCH_CONSOLE_HXX
+#define BENCH_CONSOLE_HXX
+
+class Cartridge;
+class M6502;
+class M6532;
+class TIA;
+class System;
+class FrameManager;
+
+#include "bspf.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
+#include "ConsoleIO.hxx"
+#include "Event.hxx"
+#include "Random.hxx"
+#include "ConsoleTiming.hxx"
+
+/**
+  A minimal console without any frontend, for benchmarking the core.  It
+  is put together the same way as in stella-batch, always uses the NTSC
+  frame layout and starts out headless.
+*/
+class BenchConsole
+{
+  public:
+    /**
+      Create a console for the given ROM image; the bankswitching scheme is
+      autodetected (the name only matters for its extension).  A
+      runtime_error is thrown if the image is invalid.
+    */
+    BenchConsole(const ByteBuffer& image, uInt32 size, const string& name = "bench.bin");
+    ~BenchConsole();
+
+    /**
+      Build a 4K ROM image from 6502 code that starts at $F000.  The reset
+      and break vectors point to $F000, the remaining space is filled with
+      BRK.
+    */
+    static ByteBuffer image4K(const vector<uInt8>& code);
+
+    /**
+      Run the CPU (and with it the rest of the system) for at least the
+      given number of CPU cycles.
+
+      @return  The number of cycles that were actually run
+    */
+    uInt64 runCycles(uInt64 cycles);
+
+    /**
+      Run until the TIA has completed the next frame.
+    */
+    void runFrame();
+
+    TIA& tia() { return *myTIA; }
+    System& system() { return *mySystem; }
+
+  private:
+    struct IO: public ConsoleIO {
+        Controller& leftController() const override { return *myLeftControl; }
+        Controller& rightController() const override { return *myRightControl; }
+        Switches& switches() const override { return *mySwitches; }
+
+        unique_ptr<Controller> myLeftControl;
+        unique_ptr<Controller> myRightControl;
+        unique_ptr<Switches> mySwitches;
+    };
+
+  private:
+    Settings mySettings;
+    Properties myProperties;
+    Event myEvent;
+    Random myRandom;
+    ConsoleTiming myConsoleTiming;
+    IO myIO;
+
+    unique_ptr<Cartridge> myCart;
+    unique_ptr<M6502> myCpu;
+    unique_ptr<M6532> myRiot;
+    unique_ptr<TIA> myTIA;
+    unique_ptr<System> mySystem;
+    unique_ptr<FrameManager> myFrameManager;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BenchConsole() = delete;
+    BenchConsole(const BenchConsole&) = delete;
+    BenchConsole(BenchConsole&&) = delete;
+    BenchConsole& operator=(const BenchConsole&) = delete;
+    BenchConsole& operator=(BenchConsole&&) = delete;
+};
+
+#endif
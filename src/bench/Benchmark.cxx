@@ -0,0 +1,233 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#include "Benchmark.hxx"
+
+using namespace std::chrono;
+
+namespace {
+  constexpr uInt32 SAMPLES_DEFAULT = 7;
+  constexpr uInt32 BATCH_MS_DEFAULT = 20;
+
+  double secondsFor(const Benchmark::Batch& batch, uInt64& operations)
+  {
+    time_point<high_resolution_clock> tp = high_resolution_clock::now();
+    operations = batch(operations);
+
+    return duration_cast<duration<double>>(high_resolution_clock::now() - tp).count();
+  }
+}
+
+volatile uInt64 Benchmark::ourSink = 0;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Benchmark::Benchmark(int argc, char* argv[])
+  : mySamples(SAMPLES_DEFAULT),
+    myBatchSeconds(BATCH_MS_DEFAULT / 1000.),
+    myList(false),
+    myValid(true)
+{
+  for (int i = 1; i < argc && myValid; i++) {
+    const string arg = argv[i];
+
+    if (arg == "-list") {
+      myList = true;
+      continue;
+    }
+    else if (arg[0] != '-') {
+      myFilter = arg;
+      continue;
+    }
+    else if (i + 1 == argc) {
+      myValid = false;
+      break;
+    }
+
+    const string value = argv[++i];
+    const int number = atoi(value.c_str());
+
+    if (arg == "-csv")
+      myCsvFile = value;
+    else if (arg == "-rom")
+      myRoms.push_back(value);
+    else if (arg == "-baseline")
+      myBaselineFile = value;
+    else if (arg == "-samples" && number > 0)
+      mySamples = number;
+    else if (arg == "-batch" && number > 0)
+      myBatchSeconds = number / 1000.;
+    else
+      myValid = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Benchmark::add(const string& name, const string& unit, Batch batch)
+{
+  myEntries.push_back({name, unit, batch});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Benchmark::run()
+{
+  if (!myValid) {
+    printUsage();
+    return false;
+  }
+
+  if (myList) {
+    for (const Entry& entry : myEntries) cout << entry.name << endl;
+    return true;
+  }
+
+  if (myBaselineFile != "" && !loadBaseline()) return false;
+
+  vector<Result> results;
+
+  cout << std::left << std::setw(32) << "benchmark" << std::right
+       << std::setw(14) << "ns/op" << std::setw(9) << "spread";
+  if (!myBaseline.empty()) cout << std::setw(14) << "baseline" << std::setw(9) << "change";
+  cout << "  unit" << endl;
+
+  for (const Entry& entry : myEntries) {
+    if (entry.name.find(myFilter) == string::npos) continue;
+
+    Result result;
+    result.name = entry.name;
+    result.unit = entry.unit;
+    result.nsPerOp = measure(entry.batch, result.spread);
+    results.push_back(result);
+
+    cout << std::left << std::setw(32) << result.name << std::right << std::fixed
+         << std::setprecision(2) << std::setw(14) << result.nsPerOp
+         << std::setprecision(1) << std::setw(8) << (100 * result.spread) << "%";
+
+    if (!myBaseline.empty()) {
+      auto baseline = myBaseline.find(result.name);
+
+      if (baseline != myBaseline.end() && baseline->second > 0)
+        cout << std::setprecision(2) << std::setw(14) << baseline->second
+             << std::setprecision(1) << std::setw(8) << std::showpos
+             << (100 * (result.nsPerOp / baseline->second - 1)) << "%" << std::noshowpos;
+      else
+        cout << std::setw(14) << "-" << std::setw(9) << "-";
+    }
+
+    cout << "  " << result.unit << std::defaultfloat << std::setprecision(6) << endl;
+  }
+
+  return myCsvFile == "" || saveCsv(results);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double Benchmark::measure(const Batch& batch, double& spread) const
+{
+  // Warm up, then grow the batch until it takes long enough to time it
+  // reliably
+  uInt64 operations = 1;
+  double seconds = secondsFor(batch, operations);
+
+  while (seconds < myBatchSeconds && operations < (uInt64(1) << 40)) {
+    operations = seconds > myBatchSeconds / 16
+      ? uInt64(operations * myBatchSeconds / seconds) + 1
+      : std::max<uInt64>(operations, 1) * 2;
+
+    seconds = secondsFor(batch, operations);
+  }
+
+  const uInt64 batchSize = operations;
+
+  vector<double> samples;
+  for (uInt32 i = 0; i < mySamples; i++) {
+    operations = batchSize;
+    seconds = secondsFor(batch, operations);
+
+    samples.push_back(operations > 0 ? 1e9 * seconds / operations : 0);
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  const double median = samples[samples.size() / 2];
+  spread = median > 0 ? (samples.back() - samples.front()) / median : 0;
+
+  return median;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Benchmark::loadBaseline()
+{
+  ifstream in(myBaselineFile);
+  if (!in) {
+    cerr << "ERROR: unable to read " << myBaselineFile << endl;
+    return false;
+  }
+
+  // Same format as written by saveCsv(); the header is skipped
+  string line;
+  getline(in, line);
+
+  while (getline(in, line)) {
+    std::replace(line.begin(), line.end(), ',', ' ');
+
+    istringstream buf(line);
+    string name;
+    double nsPerOp;
+
+    if (buf >> name >> nsPerOp) myBaseline[name] = nsPerOp;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Benchmark::saveCsv(const vector<Result>& results) const
+{
+  ofstream out(myCsvFile);
+  if (!out) {
+    cerr << "ERROR: unable to write " << myCsvFile << endl;
+    return false;
+  }
+
+  out << "benchmark,ns_per_op,spread,unit" << endl;
+  for (const Result& result : results)
+    out << result.name << "," << result.nsPerOp << "," << result.spread << ","
+        << result.unit << endl;
+
+  return bool(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Benchmark::printUsage() const
+{
+  cerr << "Usage: stella-bench [options] [<filter>]" << endl
+       << endl
+       << "Runs the benchmarks whose names contain <filter> (default: all)." << endl
+       << endl
+       << "Options:" << endl
+       << "  -list            List the benchmarks and exit" << endl
+       << "  -rom <file>      Also benchmark complete frames of this ROM" << endl
+       << "  -csv <file>      Write the results to <file>" << endl
+       << "  -baseline <file> Compare against results written with -csv before" << endl
+       << "  -samples <n>     Number of timed batches per benchmark (default: "
+       << SAMPLES_DEFAULT << ")" << endl
+       << "  -batch <ms>      Duration of a single batch (default: "
+       << BATCH_MS_DEFAULT << ")" << endl;
+}
@@ -0,0 +1,138 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BENCHMARK_HXX
+#define BENCHMARK_HXX
+
+#include <functional>
+#include <map>
+
+#include "bspf.hxx"
+
+/**
+  Runs micro-benchmarks of the hot paths of the emulation core.
+
+  Each benchmark performs a batch of operations on request.  The batch size
+  is calibrated so that a batch takes a few milliseconds, and the result is
+  the median time per operation over several batches.  Results can be saved
+  as CSV ('-csv') and compared against an earlier run ('-baseline'), so
+  regressions between commits show up on the same machine.
+*/
+class Benchmark
+{
+  public:
+    // Perform (about) the given number of operations, and return the number
+    // that was actually performed
+    using Batch = std::function<uInt64(uInt64)>;
+
+    Benchmark(int argc, char* argv[]);
+
+    /**
+      Add a benchmark.
+
+      @param name   A unique, stable name like 'cpu.lda.imm'
+      @param unit   What one operation is, e.g. 'instruction' or 'frame'
+      @param batch  Performs a batch of operations
+    */
+    void add(const string& name, const string& unit, Batch batch);
+
+    /**
+      The ROM images given with '-rom', for benchmarking complete frames.
+    */
+    const vector<string>& roms() const { return myRoms; }
+
+    /**
+      Run all benchmarks matching the filter, and print the results.
+
+      @return  False if the options were invalid or a file could not be
+               read or written
+    */
+    bool run();
+
+    /**
+      Keep the compiler from optimizing away a computation whose result is
+      not used otherwise.
+    */
+    static void consume(uInt64 value) { ourSink = ourSink + value; }
+
+  private:
+    struct Entry {
+      string name;
+      string unit;
+      Batch batch;
+    };
+
+    struct Result {
+      string name;
+      string unit;
+      double nsPerOp;
+      double spread;  // relative spread (max - min) / median of the samples
+    };
+
+  private:
+    double measure(const Batch& batch, double& spread) const;
+
+    bool loadBaseline();
+
+    bool saveCsv(const vector<Result>& results) const;
+
+    void printUsage() const;
+
+  private:
+    vector<Entry> myEntries;
+
+    // Only benchmarks whose names contain this string are run
+    string myFilter;
+
+    string myCsvFile;
+
+    vector<string> myRoms;
+
+    // Results of an earlier run (ns per operation), by name
+    string myBaselineFile;
+    std::map<string, double> myBaseline;
+
+    // Number of timed batches per benchmark
+    uInt32 mySamples;
+
+    // Target duration of a single batch
+    double myBatchSeconds;
+
+    bool myList;
+
+    bool myValid;
+
+    static volatile uInt64 ourSink;
+
+  private:
+    // Following constructors and assignment operators not supported
+    Benchmark() = delete;
+    Benchmark(const Benchmark&) = delete;
+    Benchmark(Benchmark&&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+    Benchmark& operator=(Benchmark&&) = delete;
+};
+
+// The benchmarks of the different parts of the core
+void addCpuBenchmarks(Benchmark& benchmark);
+void addTiaBenchmarks(Benchmark& benchmark);
+void addAudioBenchmarks(Benchmark& benchmark);
+void addVideoBenchmarks(Benchmark& benchmark);
+void addUtilityBenchmarks(Benchmark& benchmark);
+void addRomBenchmarks(Benchmark& benchmark);
+
+#endif
@@ -0,0 +1,150 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Benchmark.hxx"
+#include "BenchConsole.hxx"
+#include "Thumbulator.hxx"
+
+namespace {
+  // An instruction sequence that is repeated over the whole ROM
+  struct Kernel {
+    const char* name;
+    vector<uInt8> code;
+    uInt32 cycles;        // CPU cycles of one copy of 'code'
+    uInt32 instructions;  // instructions in one copy of 'code'
+    bool decimal;
+  };
+
+  constexpr uInt16 SUBROUTINE = 0xff0;
+
+  /**
+    Build a ROM that sets up the registers, the stack and a pointer to $F000
+    at $80, and then runs the kernel unrolled in an endless loop.  There is
+    an RTS at $FFF0 for JSR.
+  */
+  ByteBuffer kernelImage(const Kernel& kernel, uInt32& copies)
+  {
+    vector<uInt8> code = {
+      0x78,                                     // SEI
+      uInt8(kernel.decimal ? 0xf8 : 0xd8),      // SED / CLD
+      0xa2, 0xff, 0x9a,                         // LDX #$FF; TXS
+      0xa9, 0x00, 0x85, 0x80,                   // LDA #$00; STA $80
+      0xa9, 0xf0, 0x85, 0x81,                   // LDA #$F0; STA $81
+      0xa2, 0x00, 0xa0, 0x00,                   // LDX #0; LDY #0
+      0xa9, 0x01                                // LDA #1
+    };
+
+    const uInt16 loop = uInt16(0xf000 + code.size());
+
+    copies = uInt32((SUBROUTINE - 3 - code.size()) / kernel.code.size());
+    for (uInt32 i = 0; i < copies; i++)
+      code.insert(code.end(), kernel.code.begin(), kernel.code.end());
+
+    code.insert(code.end(), { 0x4c, uInt8(loop & 0xff), uInt8(loop >> 8) });  // JMP loop
+
+    code.resize(SUBROUTINE, 0x00);
+    code.push_back(0x60);                                                     // RTS
+
+    return BenchConsole::image4K(code);
+  }
+
+  // Thumb code run by the ARM benchmark, at the DPC+ entry point $C08: add
+  // a counter and a word loaded from RAM to a sum that is stored to RAM,
+  // 255 times, then return to the driver
+  constexpr uInt32 ARM_ENTRY = 0xc08;
+  constexpr uInt16 ARM_CODE[] = {
+    0x2301,   //       movs r3, #1
+    0x079b,   //       lsls r3, r3, #30     r3 = RAM
+    0x20ff,   //       movs r0, #255
+    0x2100,   //       movs r1, #0
+    0x1809,   // loop: adds r1, r1, r0
+    0x681a,   //       ldr  r2, [r3, #0]
+    0x1889,   //       adds r1, r1, r2
+    0x6059,   //       str  r1, [r3, #4]
+    0x3801,   //       subs r0, #1
+    0xd1f9,   //       bne  loop
+    0x4770    //       bx   lr
+  };
+  constexpr uInt32 ARM_INSTRUCTIONS = 4 + 255 * 6 + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addCpuBenchmarks(Benchmark& benchmark)
+{
+  // All benchmarks include clocking the TIA and the RIOT alongside the CPU,
+  // as in the actual emulation
+  const vector<Kernel> kernels = {
+    { "nop",       { 0xea },             2, 1, false },
+    { "lda.imm",   { 0xa9, 0x01 },       2, 1, false },
+    { "lda.zp",    { 0xa5, 0x80 },       3, 1, false },
+    { "lda.zpx",   { 0xb5, 0x80 },       4, 1, false },
+    { "lda.abs",   { 0xad, 0x00, 0xf0 }, 4, 1, false },
+    { "lda.absx",  { 0xbd, 0x00, 0xf0 }, 4, 1, false },
+    { "lda.absy",  { 0xb9, 0x00, 0xf0 }, 4, 1, false },
+    { "lda.indx",  { 0xa1, 0x80 },       6, 1, false },
+    { "lda.indy",  { 0xb1, 0x80 },       5, 1, false },
+    { "sta.zp",    { 0x85, 0x90 },       3, 1, false },
+    { "sta.abs",   { 0x8d, 0x90, 0x00 }, 4, 1, false },
+    { "inc.zp",    { 0xe6, 0x90 },       5, 1, false },
+    { "asl.a",     { 0x0a },             2, 1, false },
+    { "adc.imm",   { 0x69, 0x01 },       2, 1, false },
+    { "adc.dec",   { 0x69, 0x01 },       2, 1, true  },
+    { "bne.taken", { 0xd0, 0x00 },       3, 1, false },
+    { "pha.pla",   { 0x48, 0x68 },       7, 2, false },
+    { "jsr.rts",   { 0x20, SUBROUTINE & 0xff, 0xf0 | SUBROUTINE >> 8 }, 12, 2, false },
+    { "sta.tia",   { 0x85, 0x09 },       3, 1, false },
+    { "lda.riot",  { 0xad, 0x84, 0x02 }, 4, 1, false }
+  };
+
+  for (const Kernel& kernel: kernels) {
+    uInt32 copies;
+    ByteBuffer image = kernelImage(kernel, copies);
+    shared_ptr<BenchConsole> console = make_shared<BenchConsole>(image, 4096);
+
+    // One pass through the loop, including the JMP back
+    const uInt64 loopCycles = copies * kernel.cycles + 3;
+    const uInt64 loopInstructions = copies * kernel.instructions + 1;
+
+    benchmark.add(string("cpu.") + kernel.name, "instruction",
+      [console, loopCycles, loopInstructions](uInt64 instructions) {
+        const uInt64 cycles = console->runCycles(instructions * loopCycles / loopInstructions + 1);
+
+        return cycles * loopInstructions / loopCycles;
+      }
+    );
+  }
+
+  // The Thumbulator is set up like in DPC+, but without a cartridge
+  benchmark.add("arm.loop", "instruction", [](uInt64 instructions) {
+    unique_ptr<uInt16[]> rom = make_unique<uInt16[]>(ROMSIZE / 2);
+    unique_ptr<uInt16[]> ram = make_unique<uInt16[]>(RAMSIZE / 2);
+
+    std::fill_n(rom.get(), ROMSIZE / 2, 0);
+    std::fill_n(ram.get(), RAMSIZE / 2, 0);
+    std::copy(std::begin(ARM_CODE), std::end(ARM_CODE), rom.get() + ARM_ENTRY / 2);
+
+    Thumbulator thumb(rom.get(), ram.get(), 0x1000, true,
+                      Thumbulator::ConfigureFor::DPCplus, nullptr);
+
+    const uInt64 runs = instructions / ARM_INSTRUCTIONS + 1;
+    for (uInt64 i = 0; i < runs; i++) thumb.run();
+
+    Benchmark::consume(ram[2] | ram[3] << 16);
+
+    return runs * ARM_INSTRUCTIONS;
+  });
+}
@@ -0,0 +1,170 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Benchmark.hxx"
+#include "BenchConsole.hxx"
+#include "FSNode.hxx"
+#include "TIA.hxx"
+#include "DelayQueue.hxx"
+
+namespace {
+  // A display kernel: code that runs once before the first frame, and code
+  // that runs on each of the 256 visible lines of the frame
+  struct Kernel {
+    const char* name;
+    vector<uInt8> setup;
+    vector<uInt8> line;
+  };
+
+  /**
+    Build a ROM that draws 262 line NTSC frames: three lines of VSYNC, then
+    the kernel on 256 lines, and three more lines.  X counts the lines
+    down, so it can be used as the value to write.
+  */
+  ByteBuffer kernelImage(const Kernel& kernel)
+  {
+    vector<uInt8> code = {
+      0x78, 0xd8, 0xa2, 0xff, 0x9a              // SEI; CLD; LDX #$FF; TXS
+    };
+    code.insert(code.end(), kernel.setup.begin(), kernel.setup.end());
+
+    const uInt16 frame = uInt16(0xf000 + code.size());
+    code.insert(code.end(), {
+      0xa9, 0x02, 0x85, 0x00,                   // LDA #2; STA VSYNC
+      0x85, 0x02, 0x85, 0x02, 0x85, 0x02,       // STA WSYNC (3x)
+      0xa9, 0x00, 0x85, 0x00,                   // LDA #0; STA VSYNC
+      0xa2, 0x00                                // LDX #0
+    });
+
+    const size_t line = code.size();
+    code.insert(code.end(), kernel.line.begin(), kernel.line.end());
+    code.insert(code.end(), { 0x85, 0x02, 0xca });   // STA WSYNC; DEX
+    code.insert(code.end(), { 0xd0, uInt8(line - (code.size() + 2)) });  // BNE line
+
+    code.insert(code.end(), {
+      0x85, 0x02, 0x85, 0x02, 0x85, 0x02,       // STA WSYNC (3x)
+      0x4c, uInt8(frame & 0xff), uInt8(frame >> 8)   // JMP frame
+    });
+
+    return BenchConsole::image4K(code);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addTiaBenchmarks(Benchmark& benchmark)
+{
+  const vector<uInt8> spriteSetup = {
+    0xa9, 0x10, 0x85, 0x20,                     // LDA #$10; STA HMP0
+    0xa9, 0xf0, 0x85, 0x21,                     // LDA #$F0; STA HMP1
+    0xa9, 0x1e, 0x85, 0x06,                     // LDA #$1E; STA COLUP0
+    0xa9, 0x44, 0x85, 0x07                      // LDA #$44; STA COLUP1
+  };
+
+  const vector<Kernel> kernels = {
+    { "blank", { }, { } },
+    { "colubk", { }, {
+      0x86, 0x09                                // STX COLUBK
+    } },
+    { "playfield", { }, {
+      0x86, 0x08, 0x86, 0x0d,                   // STX COLUPF; STX PF0
+      0x86, 0x0e, 0x86, 0x0f                    // STX PF1; STX PF2
+    } },
+    { "sprites", spriteSetup, {
+      0x85, 0x2a,                               // STA HMOVE
+      0x86, 0x1b, 0x86, 0x1c                    // STX GRP0; STX GRP1
+    } },
+    { "rainbow", { }, {
+      0xc8, 0x84, 0x09, 0xc8, 0x84, 0x09,       // (INY; STY COLUBK) x 8
+      0xc8, 0x84, 0x09, 0xc8, 0x84, 0x09,
+      0xc8, 0x84, 0x09, 0xc8, 0x84, 0x09,
+      0xc8, 0x84, 0x09, 0xc8, 0x84, 0x09
+    } },
+    { "mixed", spriteSetup, {
+      0x85, 0x2a, 0x86, 0x09,                   // STA HMOVE; STX COLUBK
+      0x86, 0x0d, 0x86, 0x0e, 0x86, 0x0f,       // STX PF0; STX PF1; STX PF2
+      0x86, 0x1b, 0x86, 0x1c,                   // STX GRP0; STX GRP1
+      0x86, 0x1d, 0x86, 0x1f                    // STX ENAM0; STX ENABL
+    } }
+  };
+
+  for (const Kernel& kernel: kernels) {
+    for (bool headless: { false, true }) {
+      ByteBuffer image = kernelImage(kernel);
+      shared_ptr<BenchConsole> console = make_shared<BenchConsole>(image, 4096);
+
+      console->tia().setHeadless(headless);
+
+      benchmark.add(string("tia.") + kernel.name + (headless ? ".headless" : ""), "frame",
+        [console](uInt64 frames) {
+          for (uInt64 i = 0; i < frames; i++) console->runFrame();
+
+          return frames;
+        }
+      );
+    }
+  }
+
+  // The TIA clocks its delay queue every color clock, and on average there
+  // is a write every few clocks
+  benchmark.add("tia.delayqueue", "clock", [](uInt64 clocks) {
+    DelayQueue<16, 16> queue;
+    uInt64 sum = 0;
+
+    for (uInt64 i = 0; i < clocks; i++) {
+      if ((i & 3) == 0) queue.push(uInt8(i >> 2) & 0x3f, uInt8(i), uInt8(1 + (i >> 2) % 4));
+
+      queue.execute([&sum](uInt8 address, uInt8 value) { sum += address + value; });
+    }
+
+    Benchmark::consume(sum);
+
+    return clocks;
+  });
+
+  benchmark.add("tia.delayqueue.idle", "clock", [](uInt64 clocks) {
+    DelayQueue<16, 16> queue;
+    uInt64 sum = 0;
+
+    for (uInt64 i = 0; i < clocks; i++)
+      queue.execute([&sum](uInt8 address, uInt8 value) { sum += address + value; });
+
+    Benchmark::consume(sum);
+
+    return clocks;
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addRomBenchmarks(Benchmark& benchmark)
+{
+  for (const string& rom: benchmark.roms()) {
+    FilesystemNode node(rom);
+    ByteBuffer image;
+    const uInt32 size = node.isFile() ? node.read(image) : 0;
+
+    if (size == 0) throw runtime_error("unable to read " + rom);
+
+    shared_ptr<BenchConsole> console = make_shared<BenchConsole>(image, size, rom);
+    console->tia().setHeadless(false);
+
+    benchmark.add("rom." + node.getName(), "frame", [console](uInt64 frames) {
+      for (uInt64 i = 0; i < frames; i++) console->runFrame();
+
+      return frames;
+    });
+  }
+}
@@ -0,0 +1,115 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Benchmark.hxx"
+#include "BenchConsole.hxx"
+#include "FSNode.hxx"
+#include "CartDetector.hxx"
+#include "Cart.hxx"
+#include "MD5.hxx"
+#include "Serializer.hxx"
+#include "System.hxx"
+
+namespace {
+  /**
+    A ROM image of the given size with pseudo-random contents.
+  */
+  shared_ptr<ByteBuffer> randomImage(uInt32 size)
+  {
+    shared_ptr<ByteBuffer> image = make_shared<ByteBuffer>(make_unique<uInt8[]>(size));
+
+    uInt32 seed = size;
+    for (uInt32 i = 0; i < size; i++) {
+      seed = seed * 1103515245 + 12345;
+      (*image)[i] = uInt8(seed >> 16);
+    }
+
+    return image;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addUtilityBenchmarks(Benchmark& benchmark)
+{
+  // Snapshots are taken every frame while rewind is enabled
+  {
+    ByteBuffer image = BenchConsole::image4K({
+      0xe6, 0x80, 0x85, 0x09,                   // INC $80; STA COLUBK
+      0x4c, 0x00, 0xf0                          // JMP $F000
+    });
+    shared_ptr<BenchConsole> console = make_shared<BenchConsole>(image, 4096);
+    shared_ptr<Serializer> state = make_shared<Serializer>();
+
+    console->runFrame();
+
+    benchmark.add("state.save", "state", [console, state](uInt64 states) {
+      for (uInt64 i = 0; i < states; i++) {
+        state->rewind();
+        if (!console->system().save(*state)) throw runtime_error("saving state failed");
+      }
+
+      return states;
+    });
+
+    // Like restoring a rewind keyframe: copy the snapshot into the stream
+    // and load it
+    console->system().save(*state);
+    shared_ptr<vector<uInt8>> snapshot =
+      make_shared<vector<uInt8>>(state->data(), state->data() + state->size());
+
+    benchmark.add("state.load", "state", [console, state, snapshot](uInt64 states) {
+      for (uInt64 i = 0; i < states; i++) {
+        state->rewind();
+        state->putByteArray(snapshot->data(), uInt32(snapshot->size()));
+        if (!console->system().load(*state)) throw runtime_error("loading state failed");
+      }
+
+      return states;
+    });
+  }
+
+  // Loading a ROM: hashing it, then detecting the bankswitching scheme and
+  // creating the cartridge
+  for (uInt32 size: { 4096u, 8192u, 32768u }) {
+    shared_ptr<ByteBuffer> image = randomImage(size);
+    const string suffix = std::to_string(size / 1024) + "k";
+
+    benchmark.add("md5." + suffix, "image", [image, size](uInt64 images) {
+      for (uInt64 i = 0; i < images; i++)
+        Benchmark::consume(MD5::hash(*image, size)[0]);
+
+      return images;
+    });
+
+    const string md5 = MD5::hash(*image, size);
+
+    benchmark.add("cart.create." + suffix, "image", [image, size, md5](uInt64 images) {
+      const FilesystemNode file("bench.bin");
+      Settings settings;
+
+      for (uInt64 i = 0; i < images; i++) {
+        string cartMD5 = md5;
+        unique_ptr<Cartridge> cart =
+          CartDetector::create(file, *image, size, cartMD5, "", settings);
+
+        Benchmark::consume(cart ? 1 : 0);
+      }
+
+      return images;
+    });
+  }
+}
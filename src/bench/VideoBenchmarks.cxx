@@ -0,0 +1,91 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Benchmark.hxx"
+#include "AtariNTSC.hxx"
+#include "TIAConstants.hxx"
+
+namespace {
+  // Visible lines of a typical NTSC frame
+  constexpr uInt32 HEIGHT = 210;
+  constexpr uInt32 WIDTH = TIAConstants::H_PIXEL;
+  constexpr uInt32 OUT_WIDTH = AtariNTSC::outWidth(WIDTH);
+
+  /**
+    A Blargg filter with a synthetic palette, and buffers for rendering a
+    frame of vertical color bars.
+  */
+  struct Filter {
+    AtariNTSC ntsc;
+    uInt8 in[WIDTH * HEIGHT];
+    uInt32 out[OUT_WIDTH * HEIGHT];
+    uInt32 rgbIn[OUT_WIDTH * HEIGHT];
+    uInt8 phosphor[256][256];
+
+    Filter(const AtariNTSC::Setup& setup, bool threads)
+    {
+      uInt8 palette[AtariNTSC::palette_size * 3];
+      for (uInt32 i = 0; i < AtariNTSC::palette_size * 3; i++)
+        palette[i] = uInt8(i * 37);
+
+      // Blend the current and the previous value like a phosphor blend of 75%
+      for (uInt32 c = 0; c < 256; c++)
+        for (uInt32 p = 0; p < 256; p++)
+          phosphor[c][p] = uInt8(std::max(c, p * 3 / 4));
+
+      ntsc.initialize(setup, palette);
+      ntsc.setPhosphorPalette(phosphor);
+      ntsc.enableThreading(threads);
+
+      for (uInt32 y = 0; y < HEIGHT; y++)
+        for (uInt32 x = 0; x < WIDTH; x++)
+          in[y * WIDTH + x] = uInt8((x / 8 + y / 16) * 2);
+
+      std::fill_n(rgbIn, OUT_WIDTH * HEIGHT, 0);
+    }
+  };
+
+  Benchmark::Batch render(const AtariNTSC::Setup& setup, bool threads, bool phosphor)
+  {
+    shared_ptr<Filter> filter = make_shared<Filter>(setup, threads);
+
+    return [filter, phosphor](uInt64 frames) {
+      for (uInt64 i = 0; i < frames; i++)
+        filter->ntsc.render(filter->in, WIDTH, HEIGHT, filter->out, OUT_WIDTH * 4,
+                            phosphor ? filter->rgbIn : nullptr);
+
+      Benchmark::consume(filter->out[OUT_WIDTH * HEIGHT / 2]);
+
+      return frames;
+    };
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void addVideoBenchmarks(Benchmark& benchmark)
+{
+  // The TV effects of TIASurface in Blargg mode, minus the blit.  The other
+  // modes of TIASurface need an SDL backend.
+  benchmark.add("ntsc.composite", "frame",
+                render(AtariNTSC::TV_Composite, false, false));
+  benchmark.add("ntsc.composite.phosphor", "frame",
+                render(AtariNTSC::TV_Composite, false, true));
+  benchmark.add("ntsc.composite.threads", "frame",
+                render(AtariNTSC::TV_Composite, true, false));
+  benchmark.add("ntsc.rgb", "frame",
+                render(AtariNTSC::TV_RGB, false, false));
+}
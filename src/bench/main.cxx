@@ -0,0 +1,40 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "bspf.hxx"
+#include "Benchmark.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int ac, char* av[])
+{
+  try {
+    Benchmark benchmark(ac, av);
+
+    addCpuBenchmarks(benchmark);
+    addTiaBenchmarks(benchmark);
+    addAudioBenchmarks(benchmark);
+    addVideoBenchmarks(benchmark);
+    addUtilityBenchmarks(benchmark);
+    addRomBenchmarks(benchmark);
+
+    return benchmark.run() ? 0 : 1;
+  }
+  catch (const std::exception& e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return 1;
+  }
+}
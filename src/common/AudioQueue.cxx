@@ -17,8 +17,9 @@
 
 #include "AudioQueue.hxx"
 
-using std::mutex;
-using std::lock_guard;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
@@ -26,9 +27,11 @@ AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
     myIsStereo(isStereo),
     myFragmentQueue(capacity),
     myAllFragments(capacity + 2),
-    mySize(0),
-    myNextFragment(0),
+    myWriteIndex(0),
+    myReadIndex(0),
     myIgnoreOverflows(true),
+    myUnderruns(0),
+    myOverruns(0),
     myOverflowLogger("audio buffer overflow", 1)
 {
   const uInt8 sampleSize = myIsStereo ? 2 : 1;
@@ -52,11 +55,13 @@ uInt32 AudioQueue::capacity() const
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 AudioQueue::size()
+uInt32 AudioQueue::size() const
 {
-  lock_guard<mutex> guard(myMutex);
+  const uInt32 writeIndex = myWriteIndex.load(memory_order_acquire);
+  const uInt32 readIndex = myReadIndex.load(memory_order_acquire);
 
-  return mySize;
+  return writeIndex >= readIndex ?
+    writeIndex - readIndex : writeIndex + 2 * capacity() - readIndex;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -74,8 +79,6 @@ uInt32 AudioQueue::fragmentSize() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::enqueue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   Int16* newFragment;
 
   if (!fragment) {
@@ -87,27 +90,34 @@ Int16* AudioQueue::enqueue(Int16* fragment)
     return newFragment;
   }
 
-  const uInt8 capacity = uInt8(myFragmentQueue.size());
-  const uInt8 fragmentIndex = (myNextFragment + mySize) % capacity;
-
-  newFragment = myFragmentQueue.at(fragmentIndex);
-  myFragmentQueue.at(fragmentIndex) = fragment;
+  if (size() == capacity()) {
+    // The queued fragments belong to the consumer, so drop this one and
+    // refill it
+    myOverruns.fetch_add(1, memory_order_relaxed);
+    if (!myIgnoreOverflows.load(memory_order_relaxed)) myOverflowLogger.log();
 
-  if (mySize < capacity) ++mySize;
-  else {
-    myNextFragment = (myNextFragment + 1) % capacity;
-    if (!myIgnoreOverflows) myOverflowLogger.log();
+    return fragment;
   }
 
+  const uInt32 writeIndex = myWriteIndex.load(memory_order_relaxed);
+  const uInt32 fragmentIndex = writeIndex % capacity();
+
+  newFragment = myFragmentQueue[fragmentIndex];
+  myFragmentQueue[fragmentIndex] = fragment;
+
+  myWriteIndex.store(nextIndex(writeIndex), memory_order_release);
+
   return newFragment;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::dequeue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
+  if (size() == 0) {
+    myUnderruns.fetch_add(1, memory_order_relaxed);
 
-  if (mySize == 0) return nullptr;
+    return nullptr;
+  }
 
   if (!fragment) {
     if (!myFirstFragmentForDequeue) throw runtime_error("dequeue called empty");
@@ -116,11 +126,13 @@ Int16* AudioQueue::dequeue(Int16* fragment)
     myFirstFragmentForDequeue = nullptr;
   }
 
-  Int16* nextFragment = myFragmentQueue.at(myNextFragment);
-  myFragmentQueue.at(myNextFragment) = fragment;
+  const uInt32 readIndex = myReadIndex.load(memory_order_relaxed);
+  const uInt32 fragmentIndex = readIndex % capacity();
 
-  --mySize;
-  myNextFragment = (myNextFragment + 1) % myFragmentQueue.size();
+  Int16* nextFragment = myFragmentQueue[fragmentIndex];
+  myFragmentQueue[fragmentIndex] = fragment;
+
+  myReadIndex.store(nextIndex(readIndex), memory_order_release);
 
   return nextFragment;
 }
@@ -128,8 +140,6 @@ Int16* AudioQueue::dequeue(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::closeSink(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   if (myFirstFragmentForDequeue && fragment)
     throw new runtime_error("attempt to return unknown buffer on closeSink");
 
@@ -140,5 +150,5 @@ void AudioQueue::closeSink(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
-  myIgnoreOverflows = shouldIgnoreOverflows;
+  myIgnoreOverflows.store(shouldIgnoreOverflows, memory_order_relaxed);
 }
@@ -18,7 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
-#include <mutex>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -31,8 +31,12 @@
   queue and returns the used fragment in this process.
 
   The queue needs to be threadsafe as the (SDL) audio driver runs on a
-  separate thread. Samples are stored as signed 16 bit integers
-  (platform endian).
+  separate thread. There is exactly one producer (enqueue) and one consumer
+  (dequeue), so the queue is implemented as a wait-free ring buffer: the
+  producer only advances the write index, and the consumer only advances the
+  read index. If the queue is full, the newly enqueued fragment is dropped
+  instead of the oldest one, as the consumer owns the latter. Samples are
+  stored as signed 16 bit integers (platform endian).
 */
 class AudioQueue
 {
@@ -53,9 +57,9 @@ class AudioQueue
     uInt32 capacity() const;
 
     /**
-      Size getter.
+      Size getter (the number of queued fragments).
      */
-    uInt32 size();
+    uInt32 size() const;
 
     /**
       Stereo / mono getter.
@@ -87,7 +91,8 @@ class AudioQueue
 
     /**
       Return the currently playing fragment without drawing a new one. This is called
-      if the sink is closed and prepares the queue to be reopened.
+      if the sink is closed and prepares the queue to be reopened. The consumer
+      must not be running concurrently.
      */
     void closeSink(Int16* fragment);
 
@@ -96,6 +101,25 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      The number of dequeue calls that found the queue empty.
+     */
+    uInt32 underruns() const { return myUnderruns.load(std::memory_order_relaxed); }
+
+    /**
+      The number of fragments that were dropped because the queue was full.
+     */
+    uInt32 overruns() const { return myOverruns.load(std::memory_order_relaxed); }
+
+  private:
+
+    /**
+      Advance a read or write index.
+     */
+    uInt32 nextIndex(uInt32 index) const {
+      return index + 1 == 2 * capacity() ? 0 : index + 1;
+    }
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -104,7 +128,9 @@ class AudioQueue
     // Are we using stereo samples?
     bool myIsStereo;
 
-    // The fragment queue
+    // The fragment queue. The slots between the read and write index hold
+    // queued fragments and belong to the consumer, the other slots hold free
+    // fragments and belong to the producer.
     vector<Int16*> myFragmentQueue;
 
     // All fragments, including the two fragments that are in circulation.
@@ -113,14 +139,11 @@ class AudioQueue
     // We allocate a consecutive slice of memory for the fragments.
     unique_ptr<Int16[]> myFragmentBuffer;
 
-    // The nubmer if queued fragments
-    uInt32 mySize;
-
-    // The next fragment.
-    uInt32 myNextFragment;
-
-    // We need a mutex for thread safety.
-    std::mutex myMutex;
+    // Write (owned by the producer) and read (owned by the consumer) index.
+    // Both run modulo twice the capacity, so a full queue can be told apart
+    // from an empty one.
+    std::atomic<uInt32> myWriteIndex;
+    std::atomic<uInt32> myReadIndex;
 
     // The first (empty) enqueue call returns this fragment.
     Int16* myFirstFragmentForEnqueue;
@@ -128,7 +151,11 @@ class AudioQueue
     Int16* myFirstFragmentForDequeue;
 
     // Log overflows?
-    bool myIgnoreOverflows;
+    std::atomic<bool> myIgnoreOverflows;
+
+    // Statistics
+    std::atomic<uInt32> myUnderruns;
+    std::atomic<uInt32> myOverruns;
 
     StaggeredLogger myOverflowLogger;
 
@@ -31,7 +31,8 @@ FBSurfaceSDL2::FBSurfaceSDL2(FrameBufferSDL2& buffer,
     myTexAccess(SDL_TEXTUREACCESS_STREAMING),
     myInterpolate(false),
     myBlendEnabled(false),
-    myBlendAlpha(255)
+    myBlendAlpha(255),
+    myTrackDirtyRows(false)
 {
   createSurface(width, height, data);
 }
@@ -139,9 +140,14 @@ bool FBSurfaceSDL2::render()
     SDL_Texture* texture = myTexture;
 
     if(myTexAccess == SDL_TEXTUREACCESS_STREAMING) {
-      SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+      if(myTrackDirtyRows)
+        uploadDirtyRows();
+      else
+        SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+
       myTexture = mySecondaryTexture;
       mySecondaryTexture = texture;
+      std::swap(myDirtyRows, mySecondaryDirtyRows);
     }
 
     SDL_RenderCopy(myFB.myRenderer, texture, &mySrcR, &myDstR);
@@ -157,6 +163,55 @@ void FBSurfaceSDL2::invalidate()
   ASSERT_MAIN_THREAD;
 
   SDL_FillRect(mySurface, nullptr, 0);
+  markDirtyRows(0, mySurface->h);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::trackDirtyRows(bool enable)
+{
+  // Changes made while tracking was disabled haven't been recorded
+  if(enable && !myTrackDirtyRows)
+    markDirtyRows(0, mySurface->h);
+
+  myTrackDirtyRows = enable;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::markDirtyRows(uInt32 y, uInt32 h)
+{
+  const uInt32 end = std::min(y + h, uInt32(myDirtyRows.size()));
+
+  for(uInt32 row = y; row < end; ++row)
+    myDirtyRows[row] = mySecondaryDirtyRows[row] = 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::uploadDirtyRows()
+{
+  const uInt32 first = mySrcR.y, last = std::min(uInt32(mySrcR.y + mySrcR.h),
+                                                 uInt32(myDirtyRows.size()));
+
+  // Upload each run of consecutive dirty rows with a single update
+  for(uInt32 y = first; y < last; )
+  {
+    if(!myDirtyRows[y]) { ++y; continue; }
+
+    uInt32 end = y;
+    while(end < last && myDirtyRows[end])
+      myDirtyRows[end++] = 0;
+
+    SDL_Rect rect;
+    rect.x = mySrcR.x;
+    rect.y = y;
+    rect.w = mySrcR.w;
+    rect.h = end - y;
+
+    SDL_UpdateTexture(myTexture, &rect,
+        static_cast<uInt8*>(mySurface->pixels) + y * mySurface->pitch +
+        mySrcR.x * mySurface->format->BytesPerPixel, mySurface->pitch);
+
+    y = end;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -191,6 +246,10 @@ void FBSurfaceSDL2::reload()
   if(myTexAccess == SDL_TEXTUREACCESS_STATIC)
     SDL_UpdateTexture(myTexture, nullptr, myStaticData.get(), myStaticPitch);
 
+  // The new textures have undefined content
+  myDirtyRows.assign(mySurface->h, 1);
+  mySecondaryDirtyRows.assign(mySurface->h, 1);
+
   SDL_Texture* textures[] = {myTexture, mySecondaryTexture};
   for (SDL_Texture* texture: textures) {
     if (!texture) continue;
@@ -59,6 +59,8 @@ class FBSurfaceSDL2 : public FBSurface
     void free() override;
     void reload() override;
     void resize(uInt32 width, uInt32 height) override;
+    void trackDirtyRows(bool enable) override;
+    void markDirtyRows(uInt32 y, uInt32 h) override;
 
   protected:
     void applyAttributes(bool immediate) override;
@@ -66,6 +68,12 @@ class FBSurfaceSDL2 : public FBSurface
   private:
     void createSurface(uInt32 width, uInt32 height, const uInt32* data);
 
+    /**
+      Upload the rows of the source rectangle that are marked as dirty for
+      the current texture.
+    */
+    void uploadDirtyRows();
+
     // Following constructors and assignment operators not supported
     FBSurfaceSDL2() = delete;
     FBSurfaceSDL2(const FBSurfaceSDL2&) = delete;
@@ -93,6 +101,12 @@ class FBSurfaceSDL2 : public FBSurface
     uInt32 myStaticPitch;              // The number of bytes in a row of static data
 
     Common::Rect mySrcGUIR, myDstGUIR;
+
+    // Only upload modified rows?
+    bool myTrackDirtyRows;
+    // The rows modified since the last upload to each of the two streaming
+    // textures (they are swapped along with the textures)
+    vector<uInt8> myDirtyRows, mySecondaryDirtyRows;
 };
 
 #endif
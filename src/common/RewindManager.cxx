@@ -16,8 +16,11 @@
 //============================================================================
 
 #include <cmath>
+#include <chrono>
 
 #include "OSystem.hxx"
+#include "Console.hxx"
+#include "Cart.hxx"
 #include "Serializer.hxx"
 #include "StateManager.hxx"
 #include "TIA.hxx"
@@ -25,10 +28,113 @@
 
 #include "RewindManager.hxx"
 
+namespace {
+
+  // Maximum number of states between two keyframes
+  constexpr uInt32 MAX_KEYFRAME_DISTANCE = 60;
+
+  // Shorter runs of unchanged bytes are stored as part of the changed data
+  constexpr size_t MIN_MATCH = 4;
+
+  void putCount(ByteArray& out, size_t count)
+  {
+    while(count >= 0x80)
+    {
+      out.push_back(uInt8(count | 0x80));
+      count >>= 7;
+    }
+    out.push_back(uInt8(count));
+  }
+
+  size_t getCount(const uInt8*& in)
+  {
+    size_t count = 0;
+    for(uInt32 shift = 0; ; shift += 7)
+    {
+      const uInt8 b = *in++;
+      count |= size_t(b & 0x7f) << shift;
+      if(!(b & 0x80))
+        return count;
+    }
+  }
+
+  /**
+    Encode the difference of data to base (both of the same size) as a list
+    of (unchanged count, changed count, changed bytes) runs.  The given spans
+    are known to be unchanged and are not compared.
+  */
+  void encodeDelta(const uInt8* data, const uInt8* base, size_t size,
+                   const vector<Serializer::Span>& unchangedSpans, ByteArray& delta)
+  {
+    delta.clear();
+
+    auto span = unchangedSpans.cbegin();
+    size_t i = 0;
+    while(i < size)
+    {
+      // Unchanged bytes, compared eight at a time where possible
+      const size_t unchangedStart = i;
+      size_t limit;
+      for(;;)
+      {
+        for(; span != unchangedSpans.cend() && span->first <= i; ++span)
+          i = std::max(i, span->second);
+        limit = span != unchangedSpans.cend() ? span->first : size;
+
+        for(uInt64 a, b; i + 8 <= limit; i += 8)
+        {
+          memcpy(&a, data + i, 8);  memcpy(&b, base + i, 8);
+          if(a != b) break;
+        }
+        while(i < limit && data[i] == base[i]) ++i;
+
+        if(i < limit || i == size) break;
+      }
+      const size_t unchanged = i - unchangedStart;
+
+      // Changed bytes, up to the next run of MIN_MATCH unchanged ones
+      const size_t changedStart = i;
+      while(i < limit)
+      {
+        size_t j = i;
+        while(j < limit && j - i < MIN_MATCH && data[j] == base[j]) ++j;
+        if(j > i && (j - i == MIN_MATCH || j == limit))
+          break;
+        i = j + 1;
+      }
+
+      putCount(delta, unchanged);
+      putCount(delta, i - changedStart);
+      delta.insert(delta.end(), data + changedStart, data + i);
+    }
+  }
+
+  void decodeDelta(const ByteArray& delta, const uInt8* base, Serializer& out)
+  {
+    const uInt8* in = delta.data();
+    const uInt8* end = in + delta.size();
+
+    while(in < end)
+    {
+      const size_t unchanged = getCount(in);
+      out.putByteArray(base, uInt32(unchanged));
+      base += unchanged;
+
+      const size_t changed = getCount(in);
+      out.putByteArray(in, uInt32(changed));
+      in += changed;
+      base += changed;
+    }
+  }
+
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 RewindManager::RewindManager(OSystem& system, StateManager& statemgr)
   : myOSystem(system),
-    myStateManager(statemgr)
+    myStateManager(statemgr),
+    myEncodeTime(0),
+    myDecodeTime(0)
 {
   setup();
 }
@@ -113,27 +219,93 @@ bool RewindManager::addState(const string& message, bool timeMachine)
   }
 
   // Remove all future states
+  if(myStateList.currentIsValid())
+    for(auto it = myStateList.last(); &*it != &myStateList.current(); --it)
+      releaseState(*it);
   myStateList.removeToLast();
 
   // Make sure we never run out of space
   if(myStateList.full())
     compressStates();
 
+  myStateData.rewind();  // rewind Serializer internal buffers
+  if(!myStateManager.saveState(myStateData) ||
+     !myOSystem.console().tia().saveDisplay(myStateData))
+    return false;
+
+  const RewindState* previous =
+    myStateList.currentIsValid() ? &myStateList.current() : nullptr;
+
   // Add new state at the end of the list (queue adds at end)
   // This updates the 'current' iterator inside the list
   myStateList.addLast();
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
 
-  s.rewind();  // rewind Serializer internal buffers
-  if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
+  encodeState(state, previous);
+  state.message = message;
+  state.cycles = myOSystem.console().tia().cycles();
+  myLastTimeMachineAdd = timeMachine;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::encodeState(RewindState& state, const RewindState* previous)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  const uInt8* data = myStateData.data();
+  const size_t size = myStateData.size();
+
+  state.delta.clear();
+
+  // Try to encode against the keyframe of the previous state
+  if(previous && previous->keyframe && previous->distance + 1 < MAX_KEYFRAME_DISTANCE &&
+     previous->keyframe->size() == size)
+  {
+    // Cart RAM which is marked as unchanged is identical to the keyframe
+    // with which the cart started tracking RAM changes
+    static const vector<Serializer::Span> NO_SPANS;
+    const bool incremental = previous->keyframe == myRAMTrackingKeyframe.lock();
+
+    encodeDelta(data, previous->keyframe->data(), size,
+                incremental ? myStateData.unchangedSpans() : NO_SPANS, state.delta);
+
+    // Start a new keyframe when the delta doesn't save enough
+    if(state.delta.size() <= size / 2)
+    {
+      state.keyframe = previous->keyframe;
+      state.distance = previous->distance + 1;
+    }
+    else
+      state.delta.clear();
+  }
+
+  if(state.delta.empty())
   {
-    state.message = message;
-    state.cycles = myOSystem.console().tia().cycles();
-    myLastTimeMachineAdd = timeMachine;
-    return true;
+    state.keyframe = make_shared<ByteArray>(data, data + size);
+    state.distance = 0;
+
+    // Start tracking cart RAM changes relative to the new keyframe
+    myOSystem.console().cartridge().clearRAMChanged();
+    myRAMTrackingKeyframe = state.keyframe;
   }
-  return false;
+
+  myEncodeTime = uInt32(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::high_resolution_clock::now() - start).count());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::decodeState(const RewindState& state)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  myStateData.rewind();  // rewind Serializer internal buffers
+  if(state.distance == 0)
+    myStateData.putByteArray(state.keyframe->data(), uInt32(state.keyframe->size()));
+  else
+    decodeDelta(state.delta, state.keyframe->data(), myStateData);
+
+  myDecodeTime = uInt32(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::high_resolution_clock::now() - start).count());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -155,10 +327,6 @@ uInt32 RewindManager::rewindStates(uInt32 numStates)
         // ...except when the last state was added automatically,
         // because that already happened one interval before
         myLastTimeMachineAdd = false;
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -189,10 +357,6 @@ uInt32 RewindManager::unwindStates(uInt32 numStates)
       // Set internal current iterator to nextCycles state (forward in time),
       // since we will now process this state
       myStateList.moveToNext();
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -250,17 +414,35 @@ void RewindManager::compressStates()
     }
     --idx;
   }
-   myStateList.remove(removeIter); // remove
+  releaseState(*removeIter);
+  myStateList.remove(removeIter); // remove
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::releaseState(const RewindState& state)
+{
+  // The list only hands out const iterators, but its nodes aren't const
+  RewindState& removed = const_cast<RewindState&>(state);
+  removed.keyframe.reset();
+  removed.delta.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::clear()
+{
+  for(auto it = myStateList.cbegin(); it != myStateList.cend(); ++it)
+    releaseState(*it);
+  myStateList.clear();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
 {
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
 
-  myStateManager.loadState(s);
-  myOSystem.console().tia().loadDisplay(s);
+  decodeState(state);
+  myStateManager.loadState(myStateData);
+  myOSystem.console().tia().loadDisplay(myStateData);
 
   Int64 diff = startCycles - state.cycles;
   stringstream message;
@@ -339,3 +521,23 @@ IntArray RewindManager::cyclesList() const
 
   return arr;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t RewindManager::memoryUsage() const
+{
+  size_t size = 0;
+  const ByteArray* keyframe = nullptr;
+
+  // States based on the same keyframe are always adjacent
+  for(auto it = myStateList.cbegin(); it != myStateList.cend(); ++it)
+  {
+    size += it->delta.size();
+    if(it->keyframe.get() != keyframe)
+    {
+      keyframe = it->keyframe.get();
+      size += keyframe->size();
+    }
+  }
+
+  return size;
+}
@@ -22,6 +22,7 @@ class OSystem;
 class StateManager;
 
 #include "LinkedObjectPool.hxx"
+#include "Serializer.hxx"
 #include "bspf.hxx"
 
 /**
@@ -41,6 +42,12 @@ class StateManager;
   If the list is full, states are either removed at the beginning (compression
   off) or at selective positions (compression on).
 
+  In order to keep memory usage low, only keyframes are stored completely.
+  All other states are stored as a delta against the most recent keyframe
+  and are decoded when they are loaded.  Keyframes are shared between the
+  states based on them, so any state can be removed from the list without
+  affecting the others.
+
   @author  Stephen Anthony
 */
 class RewindManager
@@ -139,7 +146,7 @@ class RewindManager
     bool atFirst() const { return myStateList.atFirst(); }
     bool atLast() const  { return myStateList.atLast();  }
     void resize(uInt32 size) { myStateList.resize(size); }
-    void clear() { myStateList.clear(); }
+    void clear();
 
     /**
       Convert the cycles into a unit string.
@@ -159,6 +166,15 @@ class RewindManager
     */
     IntArray cyclesList() const;
 
+    /**
+      Statistics for the Time Machine: the memory used by all states (in
+      bytes), and the time (in microseconds) spent to encode the last
+      added and to decode the last loaded state.
+    */
+    size_t memoryUsage() const;
+    uInt32 encodeTime() const { return myEncodeTime; }
+    uInt32 decodeTime() const { return myDecodeTime; }
+
   private:
     OSystem& myOSystem;
     StateManager& myStateManager;
@@ -170,16 +186,30 @@ class RewindManager
     double myFactor;
     bool   myLastTimeMachineAdd;
 
+    // Statistics (in microseconds)
+    uInt32 myEncodeTime;
+    uInt32 myDecodeTime;
+
+    // The states are saved to and loaded from here
+    Serializer myStateData;
+
+    // The keyframe since which the cart tracks changes to its RAM
+    std::weak_ptr<ByteArray> myRAMTrackingKeyframe;
+
     struct RewindState {
-      Serializer data;  // actual save state
+      shared_ptr<ByteArray> keyframe; // complete state this state is based on
+      ByteArray delta;  // delta against the keyframe (empty for keyframes)
+      uInt32 distance;  // number of states since the keyframe (0 for keyframes)
       string message;   // describes save state origin
       uInt64 cycles;    // cycles since emulation started
 
       // We do nothing on object instantiation or copy
       // The goal of LinkedObjectPool is to not do any allocations at all
-      RewindState() : cycles(0) { }
-      RewindState(const RewindState& rs) : cycles(rs.cycles) { }
-      RewindState& operator= (const RewindState& rs) { cycles = rs.cycles; return *this; }
+      RewindState() : distance(0), cycles(0) { }
+      RewindState(const RewindState& rs) : distance(rs.distance), cycles(rs.cycles) { }
+      RewindState& operator= (const RewindState& rs) {
+        distance = rs.distance;  cycles = rs.cycles;  return *this;
+      }
 
       // Output object info; used for debugging only
       friend ostream& operator<<(ostream& os, const RewindState& s) {
@@ -196,6 +226,23 @@ class RewindManager
     */
     void compressStates();
 
+    /**
+      Release the data of a state which is removed from the list, so that
+      its keyframe doesn't stay alive until the node is reused.
+    */
+    static void releaseState(const RewindState& state);
+
+    /**
+      Store the state in myStateData either as a new keyframe, or as a delta
+      against the keyframe of the previous state.
+    */
+    void encodeState(RewindState& state, const RewindState* previous);
+
+    /**
+      Restore the complete state into myStateData.
+    */
+    void decodeState(const RewindState& state);
+
     /**
       Load the current state and get the message string for the rewind/unwind
 
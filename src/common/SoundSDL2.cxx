@@ -175,7 +175,14 @@ void SoundSDL2::close()
 
   mute(true);
 
-  if (myAudioQueue) myAudioQueue->closeSink(myCurrentFragment);
+  if (myAudioQueue) {
+    myAudioQueue->closeSink(myCurrentFragment);
+
+    ostringstream buf;
+    buf << "Audio queue: " << myAudioQueue->underruns() << " underruns, "
+        << myAudioQueue->overruns() << " overruns";
+    Logger::log(buf.str(), 2);
+  }
   myAudioQueue.reset();
   myCurrentFragment = nullptr;
 }
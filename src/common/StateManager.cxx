@@ -15,6 +15,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <chrono>
+
 #include "OSystem.hxx"
 #include "Settings.hxx"
 #include "Console.hxx"
@@ -22,6 +24,9 @@
 #include "Control.hxx"
 #include "Switches.hxx"
 #include "System.hxx"
+#include "TIA.hxx"
+#include "EmulationTiming.hxx"
+#include "DispatchResult.hxx"
 #include "Serializable.hxx"
 #include "RewindManager.hxx"
 
@@ -34,7 +39,9 @@
 StateManager::StateManager(OSystem& osystem)
   : myOSystem(osystem),
     myCurrentSlot(0),
-    myActiveMode(Mode::Off)
+    myActiveMode(Mode::Off),
+    myRunAheadFrames(0),
+    myRunAheadTime(0)
 {
   myRewindManager = make_unique<RewindManager>(myOSystem, *this);
   reset();
@@ -361,6 +368,63 @@ bool StateManager::saveState(Serializer& out)
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateManager::runAhead()
+{
+  if(myRunAheadFrames == 0 || !myOSystem.hasConsole() ||
+     myOSystem.console().tia().isHeadless())
+    return false;
+
+  Console& console = myOSystem.console();
+
+  // Devices which write to the outside world (EEPROMs, files, the serial
+  // port) would see the speculative frames, and can't be rolled back
+  if(console.leftController().hasExternalState() ||
+     console.rightController().hasExternalState() ||
+     console.cartridge().hasExternalState())
+    return false;
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  TIA& tia = console.tia();
+
+  myRunAheadState.rewind();
+  if(!saveState(myRunAheadState))
+    return false;
+
+  // The audio of the real frames has already been queued, keep it clean
+  const bool audioOutput = tia.isAudioOutputEnabled();
+  tia.enableAudioOutput(false);
+
+  DispatchResult dispatchResult;
+  const uInt64 maxCycles = console.emulationTiming().maxCyclesPerTimeslice();
+  const uInt32 lastFrame = tia.framesSinceLastRender() + myRunAheadFrames;
+
+  // Only the last frame is presented, so the others don't need to be drawn
+  tia.setHeadless(myRunAheadFrames > 1);
+
+  while(tia.framesSinceLastRender() < lastFrame)
+  {
+    tia.update(dispatchResult, maxCycles);
+
+    // Never enter the debugger for a frame that didn't really happen
+    if(dispatchResult.getStatus() != DispatchResult::Status::ok)
+      break;
+
+    if(tia.framesSinceLastRender() + 1 == lastFrame)
+      tia.setHeadless(false);
+  }
+
+  tia.setHeadless(false);
+  tia.enableAudioOutput(audioOutput);
+
+  const bool restored = loadState(myRunAheadState);
+
+  myRunAheadTime = uInt32(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::high_resolution_clock::now() - start).count());
+
+  return restored;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StateManager::reset()
 {
@@ -368,6 +432,12 @@ void StateManager::reset()
   myActiveMode = myOSystem.settings().getBool(
     myOSystem.settings().getBool("dev.settings") ? "dev.timemachine" : "plr.timemachine") ? Mode::TimeMachine : Mode::Off;
 
+  // Negative values disable run-ahead, too large ones are clamped
+  const Int32 runAheadFrames = myOSystem.hasConsole() ?
+    atoi(myOSystem.console().properties().get(PropType::Display_RunAhead).c_str()) : 0;
+  setRunAheadFrames(uInt32(std::max(runAheadFrames, 0)));
+  myRunAheadTime = 0;
+
 #if 0
   myCurrentSlot = 0;
 
@@ -40,6 +40,9 @@ class StateManager
       MoviePlayback
     };
 
+    // The maximum number of frames to run ahead
+    static constexpr uInt32 MAX_RUN_AHEAD_FRAMES = 4;
+
     /**
       Create a new statemananger class.
     */
@@ -136,6 +139,30 @@ class StateManager
     */
     bool saveState(Serializer& out);
 
+    /**
+      Emulate the configured number of frames ahead of the current state and
+      roll back afterwards.  As the frame buffers are not part of the state,
+      the newest frame pending in the TIA then already reflects the current
+      input.  Audio generated while running ahead is discarded.
+
+      @return  True if frames were run ahead and the state was restored
+    */
+    bool runAhead();
+
+    /**
+      Set/answer the number of frames to run ahead (0 disables run-ahead).
+    */
+    void setRunAheadFrames(uInt32 frames) {
+      myRunAheadFrames = BSPF::clamp(frames, 0u, MAX_RUN_AHEAD_FRAMES);
+    }
+    uInt32 runAheadFrames() const { return myRunAheadFrames; }
+
+    /**
+      Answer the time (in microseconds) used by the last run-ahead, including
+      saving and restoring the state.
+    */
+    uInt32 runAheadTime() const { return myRunAheadTime; }
+
     /**
       Resets manager to defaults.
     */
@@ -171,6 +198,12 @@ class StateManager
     // Stored savestates to be later rewound
     unique_ptr<RewindManager> myRewindManager;
 
+    // Number of frames to run ahead, the snapshot to roll back to, and the
+    // time (in microseconds) the last run-ahead took
+    uInt32 myRunAheadFrames;
+    Serializer myRunAheadState;
+    uInt32 myRunAheadTime;
+
   private:
     // Following constructors and assignment operators not supported
     StateManager() = delete;
@@ -17,30 +17,105 @@
 
 #include "ConvolutionBuffer.hxx"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+  #define CONVOLUTION_SSE
+  #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define CONVOLUTION_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace {
+
+  /**
+    Multiply a and b elementwise in groups of four floats and sum the products
+    separately for each of the four lanes. Lanes 0 and 2 hold the left, lanes 1
+    and 3 the right channel of an interleaved stereo buffer.
+   */
+  inline void dotProduct4(const float* a, const float* b, uInt32 groups, float* lanes)
+  {
+#if defined(CONVOLUTION_SSE)
+    __m128 acc = _mm_setzero_ps();
+
+    for (uInt32 i = 0; i < groups; ++i, a += 4, b += 4)
+      acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+
+    _mm_storeu_ps(lanes, acc);
+#elif defined(CONVOLUTION_NEON)
+    float32x4_t acc = vdupq_n_f32(0.f);
+
+    for (uInt32 i = 0; i < groups; ++i, a += 4, b += 4)
+      acc = vmlaq_f32(acc, vld1q_f32(a), vld1q_f32(b));
+
+    vst1q_f32(lanes, acc);
+#else
+    lanes[0] = lanes[1] = lanes[2] = lanes[3] = 0.f;
+
+    for (uInt32 i = 0; i < groups; ++i, a += 4, b += 4)
+      for (uInt32 j = 0; j < 4; ++j) lanes[j] += a[j] * b[j];
+#endif
+  }
+
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ConvolutionBuffer::ConvolutionBuffer(uInt32 size)
+ConvolutionBuffer::ConvolutionBuffer(uInt32 size, uInt32 channels)
   : myFirstIndex(0),
-    mySize(size)
+    myLength(size * channels)
 {
-  myData = make_unique<float[]>(mySize);
-  memset(myData.get(), 0, mySize * sizeof(float));
+  myData = make_unique<float[]>(2 * myLength);
+  memset(myData.get(), 0, 2 * myLength * sizeof(float));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ConvolutionBuffer::shift(float nextValue)
 {
-  myData[myFirstIndex] = nextValue;
-  myFirstIndex = (myFirstIndex + 1) % mySize;
+  myData[myFirstIndex] = myData[myFirstIndex + myLength] = nextValue;
+
+  if (++myFirstIndex == myLength) myFirstIndex = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float ConvolutionBuffer::convoluteWith(float* kernel) const
+void ConvolutionBuffer::shift(float nextValueL, float nextValueR)
 {
-  float result = 0.;
+  myData[myFirstIndex] = myData[myFirstIndex + myLength] = nextValueL;
+  myData[myFirstIndex + 1] = myData[myFirstIndex + myLength + 1] = nextValueR;
 
-  for (uInt32 i = 0; i < mySize; ++i) {
-    result += kernel[i] * myData[(myFirstIndex + i) % mySize];
-  }
+  myFirstIndex += 2;
+  if (myFirstIndex == myLength) myFirstIndex = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+float ConvolutionBuffer::convoluteWith(const float* kernel) const
+{
+  const float* data = myData.get() + myFirstIndex;
+  const uInt32 groups = myLength >> 2;
+  float lanes[4];
+
+  dotProduct4(data, kernel, groups, lanes);
+
+  float result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  for (uInt32 i = groups << 2; i < myLength; ++i)
+    result += kernel[i] * data[i];
 
   return result;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConvolutionBuffer::convoluteWith(const float* kernel, float& resultL, float& resultR) const
+{
+  const float* data = myData.get() + myFirstIndex;
+  const uInt32 groups = myLength >> 2;
+  float lanes[4];
+
+  dotProduct4(data, kernel, groups, lanes);
+
+  resultL = lanes[0] + lanes[2];
+  resultR = lanes[1] + lanes[3];
+
+  // The length is even, so at most one stereo sample remains
+  if (groups << 2 < myLength) {
+    resultL += kernel[myLength - 2] * data[myLength - 2];
+    resultR += kernel[myLength - 1] * data[myLength - 1];
+  }
+}
@@ -20,15 +20,41 @@
 
 #include "bspf.hxx"
 
+/**
+  A ring buffer of the most recent samples of one or two (interleaved)
+  channels that can be convoluted with a kernel.
+
+  The ring is stored twice in a row (mirrored), so the window starting at the
+  oldest sample is always contiguous and the convolution is a plain dot product
+  that can be vectorized. Stereo samples are interleaved, and both channels are
+  convoluted in the same pass with a kernel in which every tap is duplicated.
+*/
 class ConvolutionBuffer
 {
   public:
 
-    explicit ConvolutionBuffer(uInt32 size);
+    ConvolutionBuffer(uInt32 size, uInt32 channels);
 
+    /**
+      Push the next sample of a mono buffer.
+     */
     void shift(float nextValue);
 
-    float convoluteWith(float* kernel) const;
+    /**
+      Push the next sample of a stereo buffer.
+     */
+    void shift(float nextValueL, float nextValueR);
+
+    /**
+      Convolute a mono buffer with a kernel of size taps.
+     */
+    float convoluteWith(const float* kernel) const;
+
+    /**
+      Convolute a stereo buffer with a kernel of 2 * size taps, every tap of
+      which is duplicated (k0, k0, k1, k1, ...).
+     */
+    void convoluteWith(const float* kernel, float& resultL, float& resultR) const;
 
   private:
 
@@ -36,7 +62,8 @@ class ConvolutionBuffer
 
     uInt32 myFirstIndex;
 
-    uInt32 mySize;
+    // The number of floats in the window (size * channels)
+    uInt32 myLength;
 
   private:
 
@@ -71,6 +71,7 @@ LanczosResampler::LanczosResampler(
   // -> we find N from fully reducing the fraction.
   myPrecomputedKernelCount(reducedDenominator(formatFrom.sampleRate, formatTo.sampleRate)),
   myKernelSize(2 * kernelParameter),
+  myKernelStride(formatFrom.stereo ? 2 * myKernelSize : myKernelSize),
   myCurrentKernelIndex(0),
   myKernelParameter(kernelParameter),
   myCurrentFragment(nullptr),
@@ -81,15 +82,8 @@ LanczosResampler::LanczosResampler(
   myHighPass(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myTimeIndex(0)
 {
-  myPrecomputedKernels = make_unique<float[]>(myPrecomputedKernelCount * myKernelSize);
-
-  if (myFormatFrom.stereo)
-  {
-    myBufferL = make_unique<ConvolutionBuffer>(myKernelSize);
-    myBufferR = make_unique<ConvolutionBuffer>(myKernelSize);
-  }
-  else
-    myBuffer = make_unique<ConvolutionBuffer>(myKernelSize);
+  myPrecomputedKernels = make_unique<float[]>(myPrecomputedKernelCount * myKernelStride);
+  myBuffer = make_unique<ConvolutionBuffer>(myKernelSize, myFormatFrom.stereo ? 2 : 1);
 
   precomputeKernels();
 }
@@ -101,15 +95,20 @@ void LanczosResampler::precomputeKernels()
   uInt32 timeIndex = 0;
 
   for (uInt32 i = 0; i < myPrecomputedKernelCount; ++i) {
-    float* kernel = myPrecomputedKernels.get() + myKernelSize * i;
+    float* kernel = myPrecomputedKernels.get() + myKernelStride * i;
     // The kernel is normalized such to be evaluate on time * formatFrom.sampleRate
     float center =
       static_cast<float>(timeIndex) / static_cast<float>(myFormatTo.sampleRate);
 
     for (uInt32 j = 0; j < 2 * myKernelParameter; ++j) {
-      kernel[j] = lanczosKernel(
+      float tap = lanczosKernel(
           center - static_cast<float>(j) + static_cast<float>(myKernelParameter) - 1.f, myKernelParameter
         ) * CLIPPING_FACTOR;
+
+      if (myFormatFrom.stereo)
+        kernel[2*j] = kernel[2*j + 1] = tap;
+      else
+        kernel[j] = tap;
     }
 
     // Next step: time += 1 / formatTo.sampleRate
@@ -148,12 +147,12 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   for (uInt32 i = 0; i < outputSamples; ++i) {
-    float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
-    myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
+    const float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelStride);
+    if (++myCurrentKernelIndex == myPrecomputedKernelCount) myCurrentKernelIndex = 0;
 
     if (myFormatFrom.stereo) {
-      float sampleL = myBufferL->convoluteWith(kernel);
-      float sampleR = myBufferR->convoluteWith(kernel);
+      float sampleL, sampleR;
+      myBuffer->convoluteWith(kernel, sampleL, sampleR);
 
       if (myFormatTo.stereo) {
         fragment[2*i] = sampleL;
@@ -185,8 +184,10 @@ inline void LanczosResampler::shiftSamples(uInt32 samplesToShift)
 {
   while (samplesToShift-- > 0) {
     if (myFormatFrom.stereo) {
-      myBufferL->shift(myHighPassL.apply(myCurrentFragment[2*myFragmentIndex] / static_cast<float>(0x7fff)));
-      myBufferR->shift(myHighPassR.apply(myCurrentFragment[2*myFragmentIndex + 1] / static_cast<float>(0x7fff)));
+      myBuffer->shift(
+        myHighPassL.apply(myCurrentFragment[2*myFragmentIndex] / static_cast<float>(0x7fff)),
+        myHighPassR.apply(myCurrentFragment[2*myFragmentIndex + 1] / static_cast<float>(0x7fff))
+      );
     }
     else
       myBuffer->shift(myHighPass.apply(myCurrentFragment[myFragmentIndex] / static_cast<float>(0x7fff)));
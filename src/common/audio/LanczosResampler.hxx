@@ -45,14 +45,15 @@ class LanczosResampler : public Resampler
 
     uInt32 myPrecomputedKernelCount;
     uInt32 myKernelSize;
+    // The number of floats per precomputed kernel; for stereo input every tap
+    // is stored twice in order to match the interleaved convolution buffer.
+    uInt32 myKernelStride;
     uInt32 myCurrentKernelIndex;
     unique_ptr<float[]> myPrecomputedKernels;
 
     uInt32 myKernelParameter;
 
     unique_ptr<ConvolutionBuffer> myBuffer;
-    unique_ptr<ConvolutionBuffer> myBufferL;
-    unique_ptr<ConvolutionBuffer> myBufferR;
 
     Int16* myCurrentFragment;
     uInt32 myFragmentIndex;
@@ -15,6 +15,7 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <chrono>
 #include <thread>
 #include "AtariNTSC.hxx"
 
@@ -30,6 +31,26 @@
   #endif
 #endif
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::AtariNTSC()
+  : myWorkerThreads(0),
+    myTotalThreads(1),
+    myJob(),
+    myGeneration(0),
+    myTerminate(false),
+    myNextBand(0),
+    myPendingBands(0),
+    myLastRenderTime(0)
+{
+  enableThreading(false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::~AtariNTSC()
+{
+  stopThreads();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::initialize(const Setup& setup, const uInt8* palette)
 {
@@ -67,9 +88,15 @@ void AtariNTSC::initializePalette(const uInt8* palette)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::enableThreading(bool enable)
+void AtariNTSC::enableThreading(bool enable, uInt32 num_threads)
 {
+  // Tear down any previous pool before creating a new one
+  stopThreads();
+
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
+  if(enable && num_threads > 0)
+    systemThreads = num_threads + 1;
+
   if(systemThreads <= 1)
   {
     myWorkerThreads = 0;
@@ -77,49 +104,140 @@ void AtariNTSC::enableThreading(bool enable)
   }
   else
   {
-    systemThreads = std::max(1u, std::min(4u, systemThreads - 1));
+    // Leave one core for the emulation thread
+    systemThreads = std::max(1u, systemThreads - 1);
 
     myWorkerThreads = systemThreads - 1;
     myTotalThreads  = systemThreads;
 
-    myThreads = make_unique<std::thread[]>(myWorkerThreads);
+    myTerminate = false;
+    myThreads.reserve(myWorkerThreads);
+    for(uInt32 i = 0; i < myWorkerThreads; ++i)
+      myThreads.emplace_back(&AtariNTSC::threadMain, this);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::stopThreads()
+{
+  if(myThreads.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myTerminate = true;
   }
+  myWorkCondition.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+  myThreads.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::threadMain()
+{
+  uInt32 lastGeneration = 0;
+
+  for(;;)
+  {
+    RenderJob job;
+    uInt32 generation;
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myWorkCondition.wait(lock, [&] {
+        return myTerminate || myGeneration != lastGeneration;
+      });
+      if(myTerminate)
+        return;
+
+      job = myJob;
+      generation = lastGeneration = myGeneration;
+    }
+    renderBands(job, generation);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderBands(const RenderJob& job, uInt32 generation)
+{
+  const uInt64 tag = uInt64(generation) << 32;
+  uInt64 next = myNextBand.load();
+
+  // Grab bands until either the frame is done or a new frame was started
+  while((next & ~0xFFFFFFFFull) == tag && uInt32(next) < job.bands)
+  {
+    if(!myNextBand.compare_exchange_weak(next, next + 1))
+      continue;
+
+    renderBand(job, uInt32(next));
+
+    // The thread finishing the last band releases the barrier
+    if(myPendingBands.fetch_sub(1) == 1)
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myDoneCondition.notify_one();
+    }
+    next = myNextBand.load();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderBand(const RenderJob& job, uInt32 band)
+{
+  const uInt32 yStart = job.in_height * band / job.bands;
+  const uInt32 yEnd = job.in_height * (band + 1) / job.bands;
+
+  job.rgb_in == nullptr ?
+    renderThread(job.atari_in, job.in_width, yStart, yEnd, job.rgb_out, job.out_pitch) :
+    renderWithPhosphorThread(job.atari_in, job.in_width, yStart, yEnd, job.rgb_in,
+                             job.rgb_out, job.out_pitch);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
   void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  RenderJob job = { atari_in, in_width, in_height, rgb_out, out_pitch, rgb_in, 1 };
+
+  if(myWorkerThreads == 0)
+    renderBand(job, 0);
+  else
   {
-    myThreads[i] = std::thread([=] {
-    rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
+    job.bands = std::min(in_height, myTotalThreads * BANDS_PER_THREAD);
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myJob = job;
+      // Generation 0 is reserved for 'no frame yet'
+      if(++myGeneration == 0)  ++myGeneration;
+      myPendingBands = job.bands;
+      myNextBand = uInt64(myGeneration) << 32;
+    }
+    myWorkCondition.notify_all();
+
+    // Make the calling thread busy too...
+    renderBands(job, myGeneration);
+
+    // ...and wait until the workers have finished the remaining bands
+    std::unique_lock<std::mutex> lock(myMutex);
+    myDoneCondition.wait(lock, [&] { return myPendingBands == 0; });
   }
-  // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
 
   // Copy phosphor values into out buffer
   if(rgb_in != nullptr)
     memcpy(rgb_out, rgb_in, in_height * out_pitch);
+
+  myLastRenderTime = uInt32(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::high_resolution_clock::now() - start).count());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
-  const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
-  void* rgb_out, const uInt32 out_pitch)
+  const uInt32 yStart, const uInt32 yEnd, void* rgb_out, const uInt32 out_pitch)
 {
-  // Adapt parameters to thread number
-  const uInt32 yStart = in_height * threadNum / numThreads;
-  const uInt32 yEnd = in_height * (threadNum + 1) / numThreads;
+  // Adapt parameters to band
   atari_in += in_width * yStart;
   rgb_out  = static_cast<char*>(rgb_out) + out_pitch * yStart;
 
@@ -185,12 +303,10 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
-  const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
-  uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch)
+  const uInt32 yStart, const uInt32 yEnd, uInt32* rgb_in, void* rgb_out,
+  const uInt32 out_pitch)
 {
-  // Adapt parameters to thread number
-  const uInt32 yStart = in_height * threadNum / numThreads;
-  const uInt32 yEnd = in_height * (threadNum + 1) / numThreads;
+  // Adapt parameters to band
   uInt32 bufofs = AtariNTSC::outWidth(in_width) * yStart;
   uInt32* out = static_cast<uInt32*>(rgb_out);
   atari_in += in_width * yStart;
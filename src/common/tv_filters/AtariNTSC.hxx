@@ -40,7 +40,10 @@
 #ifndef ATARI_NTSC_HXX
 #define ATARI_NTSC_HXX
 
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "bspf.hxx"
@@ -51,7 +54,8 @@ class AtariNTSC
     static constexpr uInt32 palette_size = 256, entry_size = 2 * 14;
 
     // By default, threading is turned off
-    AtariNTSC() { enableThreading(false); }
+    AtariNTSC();
+    ~AtariNTSC();
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -82,8 +86,17 @@ class AtariNTSC
     void initialize(const Setup& setup, const uInt8* palette);
     void initializePalette(const uInt8* palette);
 
-    // Set up threading
-    void enableThreading(bool enable);
+    // Set up threading; the worker pool is created once here and reused
+    // for every subsequent frame.
+    //  Num_threads is the total number of threads (including the calling
+    //  thread) to render with; 0 means autodetect.
+    void enableThreading(bool enable, uInt32 num_threads = 0);
+
+    // Number of threads (including the calling thread) used for rendering
+    uInt32 numThreads() const { return myTotalThreads; }
+
+    // Time (in microseconds) spent in the last call to render()
+    uInt32 lastRenderTime() const { return myLastRenderTime; }
 
     // Set phosphor palette, for use in Blargg + phosphor mode
     void setPhosphorPalette(uInt8 palette[256][256]) {
@@ -112,11 +125,28 @@ class AtariNTSC
     }
 
   private:
-    // Threaded rendering
+    // Parameters of the frame currently being rendered
+    struct RenderJob
+    {
+      const uInt8* atari_in;
+      uInt32 in_width, in_height;
+      void* rgb_out;
+      uInt32 out_pitch;
+      uInt32* rgb_in;
+      uInt32 bands;
+    };
+
+    // Worker pool handling
+    void threadMain();
+    void stopThreads();
+    void renderBands(const RenderJob& job, uInt32 generation);
+    void renderBand(const RenderJob& job, uInt32 band);
+
+    // Render rows [yStart, yEnd) of the image
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
-      const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
+      const uInt32 yStart, const uInt32 yEnd, void* rgb_out, const uInt32 out_pitch);
     void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
-      const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
+      const uInt32 yStart, const uInt32 yEnd, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
 
     /**
       Used to calculate an averaged color for the 'phosphor' effect.
@@ -165,11 +195,32 @@ class AtariNTSC
     uInt32 myColorTable[palette_size][entry_size];
     uInt8 myPhosphorPalette[256][256];
 
-    // Rendering threads
-    unique_ptr<std::thread[]> myThreads;
+    // Rendering threads; these live as long as threading is enabled
+    vector<std::thread> myThreads;
     // Number of rendering and total threads
     uInt32 myWorkerThreads, myTotalThreads;
 
+    // Each frame is split into this many row bands per thread, so that
+    // idle threads can pick up the remaining work
+    static constexpr uInt32 BANDS_PER_THREAD = 4;
+
+    // Guards myJob, myGeneration and myTerminate, and is used together with
+    // the conditions below for waking the workers and the final barrier
+    std::mutex myMutex;
+    std::condition_variable myWorkCondition, myDoneCondition;
+    RenderJob myJob;
+    uInt32 myGeneration;
+    bool myTerminate;
+
+    // Next band to render (low 32 bits), tagged with the frame generation
+    // (high 32 bits) so that late workers can't grab bands of a later frame
+    std::atomic<uInt64> myNextBand;
+    // Number of bands not yet finished in the current frame
+    std::atomic<uInt32> myPendingBands;
+
+    // Duration of the last render() call
+    uInt32 myLastRenderTime;
+
     struct init_t
     {
       float to_rgb [burst_count * 6];
@@ -291,6 +342,13 @@ class AtariNTSC
       out [1] = (unsigned char) (clamped >> 11);\
       out [2] = (unsigned char) (clamped >>  1);\
     }
+
+  private:
+    // Following constructors and assignment operators not supported
+    AtariNTSC(const AtariNTSC&) = delete;
+    AtariNTSC(AtariNTSC&&) = delete;
+    AtariNTSC& operator=(const AtariNTSC&) = delete;
+    AtariNTSC& operator=(AtariNTSC&&) = delete;
 };
 
 #endif
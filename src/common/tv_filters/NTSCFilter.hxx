@@ -121,11 +121,15 @@ class NTSCFilter
     }
 
     // Enable threading for the NTSC rendering
-    inline void enableThreading(bool enable)
+    inline void enableThreading(bool enable, uInt32 numThreads = 0)
     {
-      myNTSC.enableThreading(enable);
+      myNTSC.enableThreading(enable, numThreads);
     }
 
+    // Number of threads and time (in microseconds) used to render the last frame
+    inline uInt32 numThreads() const { return myNTSC.numThreads(); }
+    inline uInt32 lastRenderTime() const { return myNTSC.lastRenderTime(); }
+
   private:
     // Convert from atari_ntsc_setup_t values to equivalent adjustables
     void convertToAdjustable(Adjustable& adjustable,
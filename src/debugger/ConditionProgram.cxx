@@ -0,0 +1,363 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Debugger.hxx"
+#include "Expression.hxx"
+#include "ConditionProgram.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Expression::compile(ConditionProgram& program) const
+{
+  program.emitExpression(*this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ConditionProgram::ConditionProgram()
+  : myDepth(0),
+    myFoldBarrier(0),
+    myDebugger(nullptr),
+    myCpuDebug(nullptr),
+    myCartDebug(nullptr),
+    myTiaDebug(nullptr)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::compile(const vector<unique_ptr<Expression>>& conditions)
+{
+  myCode.clear();
+  myStack.clear();
+  myDepth = 0;
+  myFoldBarrier = 0;
+
+  if(conditions.empty())
+    return;
+
+  myDebugger  = &Debugger::debugger();
+  myCpuDebug  = &myDebugger->cpuDebug();
+  myCartDebug = &myDebugger->cartDebug();
+  myTiaDebug  = &myDebugger->tiaDebug();
+
+  for(const auto& condition: conditions)
+  {
+    condition->compile(*this);
+    emit(Op::EndCondition, -1);
+    myFoldBarrier = uInt32(myCode.size());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 ConditionProgram::evaluate()
+{
+  const Instruction* const code = myCode.data();
+  const uInt32 size = uInt32(myCode.size());
+  Int32* const stack = myStack.data();
+
+  Int32 condition = 0;
+  Int32 top = -1;  // index of the top of the stack
+
+  for(uInt32 pc = 0; pc < size; ++pc)
+  {
+    const Instruction& i = code[pc];
+
+    switch(i.op)
+    {
+      case Op::Const:       stack[++top] = i.value;                           break;
+      case Op::Expression:  stack[++top] = i.expression->evaluate();          break;
+      case Op::LoadByte:    stack[++top] = *i.byte;                           break;
+      case Op::LoadWord:    stack[++top] = *i.word;                           break;
+      case Op::CpuMethod:   stack[++top] = (myCpuDebug->*i.cpuMethod)();      break;
+      case Op::CartMethod:  stack[++top] = (myCartDebug->*i.cartMethod)();    break;
+      case Op::TiaMethod:   stack[++top] = (myTiaDebug->*i.tiaMethod)();      break;
+
+      case Op::Peek:   stack[top] = myDebugger->peek(stack[top]);             break;
+      case Op::DPeek:  stack[top] = myDebugger->dpeekAsInt(stack[top]);       break;
+      case Op::Negate: stack[top] = -stack[top];                              break;
+      case Op::BinNot: stack[top] = ~stack[top];                              break;
+      case Op::LogNot: stack[top] = !stack[top];                              break;
+      case Op::LoByte: stack[top] = 0xff & stack[top];                        break;
+      case Op::HiByte: stack[top] = 0xff & (stack[top] >> 8);                 break;
+      case Op::Bool:   stack[top] = stack[top] != 0;                          break;
+
+      case Op::Plus:          --top; stack[top] = stack[top] + stack[top + 1];  break;
+      case Op::Minus:         --top; stack[top] = stack[top] - stack[top + 1];  break;
+      case Op::Mult:          --top; stack[top] = stack[top] * stack[top + 1];  break;
+      case Op::BinAnd:        --top; stack[top] = stack[top] & stack[top + 1];  break;
+      case Op::BinOr:         --top; stack[top] = stack[top] | stack[top + 1];  break;
+      case Op::BinXor:        --top; stack[top] = stack[top] ^ stack[top + 1];  break;
+      case Op::Equals:        --top; stack[top] = stack[top] == stack[top + 1]; break;
+      case Op::NotEquals:     --top; stack[top] = stack[top] != stack[top + 1]; break;
+      case Op::Less:          --top; stack[top] = stack[top] < stack[top + 1];  break;
+      case Op::LessEquals:    --top; stack[top] = stack[top] <= stack[top + 1]; break;
+      case Op::Greater:       --top; stack[top] = stack[top] > stack[top + 1];  break;
+      case Op::GreaterEquals: --top; stack[top] = stack[top] >= stack[top + 1]; break;
+
+      // The divisor is below the dividend
+      case Op::Div:
+      case Op::Mod:
+        --top; stack[top] = apply(i.op, stack[top + 1], stack[top]);
+        break;
+
+      case Op::ShiftLeft:
+      case Op::ShiftRight:
+        --top; stack[top] = apply(i.op, stack[top], stack[top + 1]);
+        break;
+
+      // The value is kept when jumping, and dropped otherwise
+      case Op::JumpIfZero:
+        if(stack[top] == 0) pc = i.value - 1;
+        else                --top;
+        break;
+
+      case Op::JumpIfNonZero:
+        if(stack[top] != 0) { stack[top] = 1; pc = i.value - 1; }
+        else                --top;
+        break;
+
+      case Op::SkipIfZero:
+        if(stack[top] == 0) pc = i.value - 1;
+        break;
+
+      case Op::EndCondition:
+        if(stack[top--]) return condition;
+        ++condition;
+        break;
+    }
+  }
+
+  return -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitConst(Int32 value)
+{
+  emit(Op::Const, 1).value = value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitExpression(const Expression& expression)
+{
+  emit(Op::Expression, 1).expression = &expression;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitCpuMethod(CpuMethod method)
+{
+  if(const uInt8* byte = myCpuDebug->byteRegister(method))
+    emit(Op::LoadByte, 1).byte = byte;
+  else if(const uInt16* word = myCpuDebug->wordRegister(method))
+    emit(Op::LoadWord, 1).word = word;
+  else
+    emit(Op::CpuMethod, 1).cpuMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitCartMethod(CartMethod method)
+{
+  emit(Op::CartMethod, 1).cartMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitTiaMethod(TiaMethod method)
+{
+  emit(Op::TiaMethod, 1).tiaMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitOperator(Op op)
+{
+  Int32 lhs, rhs;
+
+  if(isUnary(op))
+  {
+    if(isFoldable(op) && popConst(rhs))
+      emitConst(apply(op, rhs));
+    else
+      emit(op, 0);
+  }
+  else
+  {
+    if(isFoldable(op) && popConst(rhs))
+    {
+      if(popConst(lhs))
+      {
+        emitConst(apply(op, lhs, rhs));
+        return;
+      }
+      emitConst(rhs);
+    }
+    emit(op, -1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitLogAnd(const Expression& lhs, const Expression& rhs)
+{
+  Int32 value;
+
+  lhs.compile(*this);
+  if(popConst(value))
+  {
+    // Like the tree, skip the right hand side if the result is known
+    if(value == 0)
+      emitConst(0);
+    else
+    {
+      rhs.compile(*this);
+      emitOperator(Op::Bool);
+    }
+    return;
+  }
+
+  const uInt32 jump = uInt32(myCode.size());
+  emit(Op::JumpIfZero, -1);
+  rhs.compile(*this);
+  emitOperator(Op::Bool);
+  patchJump(jump);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitLogOr(const Expression& lhs, const Expression& rhs)
+{
+  Int32 value;
+
+  lhs.compile(*this);
+  if(popConst(value))
+  {
+    if(value != 0)
+      emitConst(1);
+    else
+    {
+      rhs.compile(*this);
+      emitOperator(Op::Bool);
+    }
+    return;
+  }
+
+  const uInt32 jump = uInt32(myCode.size());
+  emit(Op::JumpIfNonZero, -1);
+  rhs.compile(*this);
+  emitOperator(Op::Bool);
+  patchJump(jump);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::emitDivision(Op op, const Expression& lhs, const Expression& rhs)
+{
+  Int32 divisor, dividend;
+
+  rhs.compile(*this);
+  if(popConst(divisor))
+  {
+    if(divisor == 0)
+    {
+      emitConst(0);
+      return;
+    }
+
+    emitConst(divisor);
+    lhs.compile(*this);
+    if(popConst(dividend) && popConst(divisor))
+      emitConst(apply(op, dividend, divisor));
+    else
+      emit(op, -1);
+    return;
+  }
+
+  // A zero divisor is left on the stack as the result
+  const uInt32 jump = uInt32(myCode.size());
+  emit(Op::SkipIfZero, 0);
+  lhs.compile(*this);
+  emit(op, -1);
+  patchJump(jump);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ConditionProgram::Instruction& ConditionProgram::emit(Op op, Int32 depthChange)
+{
+  myDepth += depthChange;
+  if(size_t(myDepth) > myStack.size())
+    myStack.resize(myDepth);
+
+  Instruction instruction;
+  instruction.op = op;
+  instruction.value = 0;
+  instruction.expression = nullptr;
+  myCode.push_back(instruction);
+
+  return myCode.back();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ConditionProgram::popConst(Int32& value)
+{
+  if(myCode.size() <= myFoldBarrier || myCode.back().op != Op::Const)
+    return false;
+
+  value = myCode.back().value;
+  myCode.pop_back();
+  --myDepth;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConditionProgram::patchJump(uInt32 index)
+{
+  myFoldBarrier = uInt32(myCode.size());
+  myCode[index].value = Int32(myFoldBarrier);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 ConditionProgram::apply(Op op, Int32 value)
+{
+  switch(op)
+  {
+    case Op::Negate:  return -value;
+    case Op::BinNot:  return ~value;
+    case Op::LogNot:  return !value;
+    case Op::LoByte:  return 0xff & value;
+    case Op::HiByte:  return 0xff & (value >> 8);
+    case Op::Bool:    return value != 0;
+    default:          return 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 ConditionProgram::apply(Op op, Int32 lhs, Int32 rhs)
+{
+  switch(op)
+  {
+    case Op::Plus:          return lhs + rhs;
+    case Op::Minus:         return lhs - rhs;
+    case Op::Mult:          return lhs * rhs;
+    case Op::Div:           return rhs == 0 ? 0 : lhs / rhs;
+    case Op::Mod:           return rhs == 0 ? 0 : lhs % rhs;
+    case Op::BinAnd:        return lhs & rhs;
+    case Op::BinOr:         return lhs | rhs;
+    case Op::BinXor:        return lhs ^ rhs;
+    case Op::ShiftLeft:     return lhs << rhs;
+    case Op::ShiftRight:    return lhs >> rhs;
+    case Op::Equals:        return lhs == rhs;
+    case Op::NotEquals:     return lhs != rhs;
+    case Op::Less:          return lhs < rhs;
+    case Op::LessEquals:    return lhs <= rhs;
+    case Op::Greater:       return lhs > rhs;
+    case Op::GreaterEquals: return lhs >= rhs;
+    default:                return 0;
+  }
+}
@@ -0,0 +1,154 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CONDITION_PROGRAM_HXX
+#define CONDITION_PROGRAM_HXX
+
+class Debugger;
+class Expression;
+
+#include "bspf.hxx"
+#include "CartDebug.hxx"
+#include "CpuDebug.hxx"
+#include "TIADebug.hxx"
+
+/**
+  A list of conditions (breakifs, savestateifs, trapifs), compiled from their
+  expression trees into a flat stack machine program.  All conditions are
+  evaluated in a single loop, without virtual calls.  Constant subexpressions
+  are folded at compile time, and CPU registers are read directly.
+
+  Expressions that can't be compiled (e.g. user defined functions, which
+  can be redefined at any time) are still evaluated as trees.
+*/
+class ConditionProgram
+{
+  public:
+    enum class Op: uInt8 {
+      // Operands
+      Const, Expression, LoadByte, LoadWord, CpuMethod, CartMethod, TiaMethod,
+      // Unary operators
+      Peek, DPeek, Negate, BinNot, LogNot, LoByte, HiByte, Bool,
+      // Binary operators
+      Plus, Minus, Mult, Div, Mod, BinAnd, BinOr, BinXor, ShiftLeft, ShiftRight,
+      Equals, NotEquals, Less, LessEquals, Greater, GreaterEquals,
+      // Control flow
+      JumpIfZero, JumpIfNonZero, SkipIfZero, EndCondition
+    };
+
+  public:
+    ConditionProgram();
+
+    /**
+      Compile the given conditions, replacing the current program.
+     */
+    void compile(const vector<unique_ptr<Expression>>& conditions);
+
+    /**
+      Evaluate the conditions in order.
+
+      @return  The index of the first condition that is true, or -1
+     */
+    Int32 evaluate();
+
+    /**
+      The following methods are used by Expression::compile() to generate
+      code; the value of each (sub-)expression is left on the stack.
+     */
+    void emitConst(Int32 value);
+    void emitExpression(const Expression& expression);
+    void emitCpuMethod(CpuMethod method);
+    void emitCartMethod(CartMethod method);
+    void emitTiaMethod(TiaMethod method);
+
+    /**
+      Apply a unary or binary operator to the value(s) on top of the stack.
+     */
+    void emitOperator(Op op);
+
+    /**
+      Short-circuit evaluation of '&&' and '||'.
+     */
+    void emitLogAnd(const Expression& lhs, const Expression& rhs);
+    void emitLogOr(const Expression& lhs, const Expression& rhs);
+
+    /**
+      Division and modulo ('op' is Op::Div or Op::Mod); division by zero
+      gives zero, without evaluating the left hand side.
+     */
+    void emitDivision(Op op, const Expression& lhs, const Expression& rhs);
+
+  private:
+    struct Instruction
+    {
+      Op op;
+      Int32 value;  // Constant or jump target
+      union {
+        const Expression* expression;
+        const uInt8* byte;
+        const uInt16* word;
+        CpuMethod cpuMethod;
+        CartMethod cartMethod;
+        TiaMethod tiaMethod;
+      };
+    };
+
+    /**
+      Append an instruction that changes the stack depth by 'depthChange'.
+     */
+    Instruction& emit(Op op, Int32 depthChange);
+
+    /**
+      Remove a constant that was just emitted, and return its value.
+     */
+    bool popConst(Int32& value);
+
+    /**
+      Point the jump at the given index to the current end of the program.
+     */
+    void patchJump(uInt32 index);
+
+    static bool isUnary(Op op) { return op >= Op::Peek && op <= Op::Bool; }
+    static bool isFoldable(Op op) { return op >= Op::Negate && op <= Op::GreaterEquals; }
+
+    static Int32 apply(Op op, Int32 value);
+    static Int32 apply(Op op, Int32 lhs, Int32 rhs);
+
+  private:
+    vector<Instruction> myCode;
+    vector<Int32> myStack;
+
+    // Stack depth while compiling
+    Int32 myDepth;
+    // Constants emitted before this index must not be folded, as they may
+    // be reached through a jump
+    uInt32 myFoldBarrier;
+
+    Debugger* myDebugger;
+    CpuDebug* myCpuDebug;
+    CartDebug* myCartDebug;
+    TIADebug* myTiaDebug;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ConditionProgram(const ConditionProgram&) = delete;
+    ConditionProgram(ConditionProgram&&) = delete;
+    ConditionProgram& operator=(const ConditionProgram&) = delete;
+    ConditionProgram& operator=(ConditionProgram&&) = delete;
+};
+
+#endif
@@ -148,6 +148,23 @@ int CpuDebug::icycles() const
   return mySystem.m6502().icycles;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* CpuDebug::byteRegister(CpuMethod method) const
+{
+  if(method == &CpuDebug::a)            return &my6502.A;
+  else if(method == &CpuDebug::x)       return &my6502.X;
+  else if(method == &CpuDebug::y)       return &my6502.Y;
+  else if(method == &CpuDebug::sp)      return &my6502.SP;
+  else if(method == &CpuDebug::icycles) return &my6502.icycles;
+  else                                  return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt16* CpuDebug::wordRegister(CpuMethod method) const
+{
+  return method == &CpuDebug::pc ? &my6502.PC : nullptr;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CpuDebug::setPC(int pc)
 {
@@ -65,6 +65,11 @@ class CpuDebug : public DebuggerSystem
 
     int icycles() const;
 
+    // The registers read by the given method, for direct access in compiled
+    // debugger conditions (nullptr if the value must be computed)
+    const uInt8* byteRegister(CpuMethod method) const;
+    const uInt16* wordRegister(CpuMethod method) const;
+
     void setPC(int pc);
     void setSP(int sp);
     void setPS(int ps);
@@ -37,6 +37,8 @@
 #include "PackedBitArray.hxx"
 #include "TimerManager.hxx"
 #include "Vec.hxx"
+#include "Cart.hxx"
+#include "Thumbulator.hxx"
 
 #include "Base.hxx"
 using Common::Base;
@@ -697,6 +699,58 @@ void DebuggerParser::executeA()
   debugger.cpuDebug().setA(uInt8(args[0]));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "armprofile"
+void DebuggerParser::executeArmprofile()
+{
+  Thumbulator* thumbulator = debugger.myOSystem.console().cartridge().thumbulator();
+  if(!thumbulator)
+  {
+    commandResult << red("cartridge has no ARM");
+    return;
+  }
+
+  uInt32 count = 10;
+  if(argCount == 1)
+  {
+    if(argStrings[0] == "on" || argStrings[0] == "reset")
+    {
+      thumbulator->enableProfiling(true);
+      if(thumbulator->profile())
+        commandResult << "ARM profile reset";
+      else
+        commandResult << red("ARM profiling not supported");
+      return;
+    }
+    else if(argStrings[0] == "off")
+    {
+      thumbulator->enableProfiling(false);
+      commandResult << "ARM profiling disabled";
+      return;
+    }
+    else if(args[0] > 0)
+      count = args[0];
+    else
+    {
+      outputCommandError("invalid argument", myCommand);
+      return;
+    }
+  }
+
+  const Thumbulator::Profile* profile = thumbulator->profile();
+  if(!profile)
+  {
+    commandResult << "ARM profiling disabled, enable it with 'armprofile on'";
+    return;
+  }
+
+  profile->print(commandResult, count);
+  if(profile->runs > 0)
+    commandResult << std::fixed << std::setprecision(3)
+                  << (profile->seconds * 1000000 / profile->runs) << " us host time per run"
+                  << std::defaultfloat << std::setprecision(6);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "base"
 void DebuggerParser::executeBase()
@@ -2233,6 +2287,18 @@ DebuggerParser::Command DebuggerParser::commands[NumCommands] = {
     std::mem_fn(&DebuggerParser::executeA)
   },
 
+  {
+    "armprofile",
+    "Profile ARM code [on|off|reset], or list <xx> hot functions",
+    "Lists the ARM functions (of DPC+, CDF and BUS carts) that took the most\n"
+    "cycles since profiling was turned on or reset (default 10 functions)\n"
+    "Example: armprofile on, armprofile, armprofile 20, armprofile off",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeArmprofile)
+  },
+
   {
     "base",
     "Set default number base to <base>",
@@ -88,7 +88,7 @@ class DebuggerParser
     };
 
     // List of commands available
-    static constexpr uInt32 NumCommands = 92;
+    static constexpr uInt32 NumCommands = 93;
     struct Command {
       string cmdString;
       string description;
@@ -140,6 +140,7 @@ class DebuggerParser
 
     // List of available command methods
     void executeA();
+    void executeArmprofile();
     void executeBase();
     void executeBreak();
     void executeBreakif();
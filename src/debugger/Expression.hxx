@@ -18,6 +18,8 @@
 #ifndef EXPRESSION_HXX
 #define EXPRESSION_HXX
 
+class ConditionProgram;
+
 #include "bspf.hxx"
 
 /**
@@ -37,6 +39,12 @@ class Expression
 
     virtual Int32 evaluate() const { return 0; }
 
+    /**
+      Append code that computes the value of this expression to the
+      program.  By default, the program will call evaluate().
+    */
+    virtual void compile(ConditionProgram& program) const;
+
   protected:
     unique_ptr<Expression> myLHS, myRHS;
 
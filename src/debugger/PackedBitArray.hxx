@@ -25,24 +25,30 @@
 class PackedBitArray
 {
   public:
-    PackedBitArray() : myInitialized(false) { }
+    PackedBitArray() : myCount(0), myInitialized(false) { }
 
     bool isSet(uInt16 bit) const   { return myBits[bit];  }
     bool isClear(uInt16 bit) const { return !myBits[bit]; }
 
-    void set(uInt16 bit)    { myBits[bit] = true;  }
-    void clear(uInt16 bit)  { myBits[bit] = false; }
-    void toggle(uInt16 bit) { myBits.flip(bit);    }
+    void set(uInt16 bit)    { if(!myBits[bit]) { myBits[bit] = true;  ++myCount; } }
+    void clear(uInt16 bit)  { if(myBits[bit])  { myBits[bit] = false; --myCount; } }
+    void toggle(uInt16 bit) { myBits[bit] ? clear(bit) : set(bit); }
 
     void initialize() { myInitialized = true; }
-    void clearAll() { myInitialized = false; myBits.reset(); }
+    void clearAll() { myInitialized = false; myBits.reset(); myCount = 0; }
 
     bool isInitialized() const { return myInitialized; }
 
+    // Answers whether any bit is set
+    bool isAnySet() const { return myCount > 0; }
+
   private:
     // The actual bits
     std::bitset<0x10000> myBits;
 
+    // The number of bits set
+    uInt32 myCount;
+
     // Indicates whether we should treat this bitset as initialized
     bool myInitialized;
 
@@ -23,28 +23,37 @@
 class TrapArray
 {
 public:
-  TrapArray() : myInitialized(false) {}
+  TrapArray() : myTotal(0), myInitialized(false) {}
 
   bool isSet(const uInt16 address) const { return myCount[address]; }
   bool isClear(const uInt16 address) const { return myCount[address] == 0; }
 
-  void add(const uInt16 address) { myCount[address]++; }
-  void remove(const uInt16 address) { myCount[address]--; }
+  void add(const uInt16 address) { myCount[address]++; myTotal++; }
+  void remove(const uInt16 address) { if(myCount[address]) { myCount[address]--; myTotal--; } }
   //void toggle(uInt16 address) { myCount[address] ? remove(address) : add(address); } // TODO condition
 
   void initialize() { 
     if(!myInitialized)
+    {
       memset(myCount, 0, sizeof(myCount));
+      myTotal = 0;
+    }
     myInitialized = true; 
   }
-  void clearAll() { myInitialized = false; memset(myCount, 0, sizeof(myCount)); }
+  void clearAll() { myInitialized = false; memset(myCount, 0, sizeof(myCount)); myTotal = 0; }
 
   bool isInitialized() const { return myInitialized; }
 
+  // Answers whether a trap is set at any address
+  bool isAnySet() const { return myTotal > 0; }
+
 private:
   // The actual counts
   uInt8 myCount[0x10000];
 
+  // The total of all counts
+  uInt32 myTotal;
+
   // Indicates whether we should treat this array as initialized
   bool myInitialized;
 
@@ -18,6 +18,8 @@
 #include "EditTextWidget.hxx"
 #include "GuiObject.hxx"
 #include "OSystem.hxx"
+#include "Console.hxx"
+#include "Cart.hxx"
 #include "CartDebug.hxx"
 #include "StringParser.hxx"
 #include "Widget.hxx"
@@ -131,6 +133,8 @@ uInt8 CartRamWidget::InternalRamWidget::getValue(int addr) const
 void CartRamWidget::InternalRamWidget::setValue(int addr, uInt8 value)
 {
   myCart.internalRamSetValue(addr, value);
+  // The cart doesn't see this write, so we must tell it
+  instance().console().cartridge().setRAMChanged();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
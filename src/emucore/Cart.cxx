@@ -21,6 +21,7 @@
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "CartDebug.hxx"
+  #include "M6502.hxx"
 #endif
 
 #include "Cart.hxx"
@@ -29,6 +30,7 @@
 Cartridge::Cartridge(const Settings& settings, const string& md5)
   : mySettings(settings),
     myBankChanged(true),
+    myRAMChanged(true),
     myCodeAccessBase(nullptr),
     myStartBank(0),
     myBankLocked(false)
@@ -91,12 +93,18 @@ uInt8 Cartridge::peekRAM(uInt8& dest, uInt16 address)
   if(!bankLocked() && !mySystem->autodetectMode())
   {
     // Record access here; final determination will happen in ::pokeRAM()
-    myRAMAccesses.push_back(address);
+    // The accesses are only cleared while the CPU checks for them
+    if(mySystem->m6502().readFromWritePortBreak())
+      myRAMAccesses.push_back(address);
     dest = value;
+    myRAMChanged = true;
   }
 #else
   if(!mySystem->autodetectMode())
+  {
     dest = value;
+    myRAMChanged = true;
+  }
 #endif
   return value;
 }
@@ -115,6 +123,16 @@ void Cartridge::pokeRAM(uInt8& dest, uInt16 address, uInt8 value)
   }
 #endif
   dest = value;
+  myRAMChanged = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::saveRAM(Serializer& out, const uInt8* ram, uInt32 size) const
+{
+  if(myRAMChanged)
+    out.putByteArray(ram, size);
+  else
+    out.putUnchangedByteArray(ram, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -162,3 +180,39 @@ bool Cartridge::randomStartBank() const
 {
   return mySettings.getBool(mySettings.getBool("dev.settings") ? "dev.bankrandom" : "plr.bankrandom");
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Cartridge::BankSegment::Layout
+    Cartridge::romBankLayout(uInt8* image, uInt16 bankSize, uInt16 hotspots)
+{
+  uInt8* codeAccessBase = myCodeAccessBase.get();
+
+  return [this, image, codeAccessBase, bankSize, hotspots](uInt16 bank, uInt16 address) {
+    const uInt32 offset = bank * uInt32(bankSize) + (address & (bankSize - 1));
+    System::PageAccess access(this, System::PageAccessType::READ);
+
+    if(address < (hotspots & ~System::PAGE_MASK))
+      access.directPeekBase = &image[offset];
+    if(codeAccessBase)
+      access.codeAccessBase = &codeAccessBase[offset];
+
+    return access;
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::BankSegment::initialize(System& system, uInt16 start, uInt16 end,
+                                        uInt16 banks, const Layout& layout)
+{
+  mySystem = &system;
+  myStart = start;
+  myPages = (end - start) >> System::PAGE_SHIFT;
+  myBanks = banks;
+
+  myAccesses.clear();
+  myAccesses.reserve(myPages * myBanks);
+
+  for(uInt16 bank = 0; bank < myBanks; ++bank)
+    for(uInt16 addr = myStart; addr < end; addr += System::PAGE_SIZE)
+      myAccesses.push_back(layout(bank, addr));
+}
@@ -23,9 +23,11 @@ class Properties;
 class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
+class Thumbulator;
 
 #include "bspf.hxx"
 #include "Device.hxx"
+#include "System.hxx"
 #include "Settings.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "Font.hxx"
@@ -106,6 +108,18 @@ class Cartridge : public Device
     */
     virtual bool bankChanged();
 
+    /**
+      Incremental snapshots: carts with large amounts of internal RAM track
+      whether it was (possibly) written since the last time ramChanged() was
+      cleared.  Such carts save their RAM with saveRAM(), so that unchanged
+      RAM doesn't need to be compared when creating a snapshot.  Any code
+      writing the RAM from outside of the cart (e.g. the debugger) must
+      call setRAMChanged().
+    */
+    bool ramChanged() const { return myRAMChanged; }
+    void setRAMChanged()    { myRAMChanged = true;  }
+    void clearRAMChanged()  { myRAMChanged = false; }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       To be called at the start of each instruction.
@@ -194,6 +208,13 @@ class Cartridge : public Device
     */
     virtual void setNVRamFile(const string& nvramdir, const string& romfile) { }
 
+    /**
+      Answers whether the cartridge keeps state outside of its save state,
+      e.g. in a file written during emulation.  Such state can't be rolled
+      back by loading a state.
+    */
+    virtual bool hasExternalState() const { return false; }
+
     /**
       Thumbulator only supports 16-bit ARM code.  Some Harmony/Melody drivers,
       such as BUS and CDF, feature 32-bit ARM code subroutines.  This is used
@@ -201,6 +222,14 @@ class Cartridge : public Device
     */
     virtual uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) { return 0; }
 
+    /**
+      Get the ARM emulator of carts that run code on a Harmony/Melody,
+      e.g. to profile it.
+
+      @return  The Thumbulator, or nullptr if the cart has no ARM
+    */
+    virtual Thumbulator* thumbulator() const { return nullptr; }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get optional debugger widget responsible for displaying info about the cart.
@@ -226,6 +255,117 @@ class Cartridge : public Device
   #endif
 
   protected:
+    /**
+      A bankswitched window of the cartridge address space.  The page
+      accessing methods of all its banks are built once when the cart is
+      installed, so that switching banks only copies them into the system.
+    */
+    class BankSegment
+    {
+      public:
+        // Returns the accessing methods of the page at 'address' while
+        // 'bank' is mapped into the segment
+        using Layout = std::function<System::PageAccess(uInt16 bank, uInt16 address)>;
+
+        BankSegment() : mySystem(nullptr), myStart(0), myPages(0), myBanks(0) { }
+
+        /**
+          Build the page accessing methods of every bank.
+
+          @param system  The system the cart is installed in
+          @param start   The address of the first page of the segment
+          @param end     The address following the last page of the segment
+          @param banks   The number of banks that can be mapped
+          @param layout  Returns the accessing methods of each page
+        */
+        void initialize(System& system, uInt16 start, uInt16 end, uInt16 banks,
+                        const Layout& layout);
+
+        /**
+          Map the given bank into the system.
+
+          @param bank  The bank to map, wrapped around to a valid one
+        */
+        void map(uInt16 bank) const {
+          mySystem->setPageAccesses(myStart, &myAccesses[(bank % myBanks) * myPages],
+                                    myPages);
+        }
+
+      private:
+        System* mySystem;
+        uInt16 myStart, myPages, myBanks;
+
+        // The accessing methods of all pages, bank after bank
+        vector<System::PageAccess> myAccesses;
+
+      private:
+        // Following constructors and assignment operators not supported
+        BankSegment(const BankSegment&) = delete;
+        BankSegment(BankSegment&&) = delete;
+        BankSegment& operator=(const BankSegment&) = delete;
+        BankSegment& operator=(BankSegment&&) = delete;
+    };
+
+    /**
+      The 20 kHz oscillator that clocks the music mode data fetchers of
+      DPC+, CDF and BUS carts.  The 6507 runs at 1193191.66666667 Hz
+      (3579575 / 3 Hz), so each of its cycles is exactly 2400 / 143183 OSC
+      clocks.  The clocks are counted with integer math; a clock counts
+      once it has been passed, not when it is reached.
+    */
+    class MusicOscillator
+    {
+      public:
+        MusicOscillator() : myFraction(0) { }
+
+        void reset() { myFraction = 0; }
+
+        /**
+          Advance the oscillator.
+
+          @param cycles  The number of 6507 cycles since the last update
+          @return  The number of whole OSC clocks that passed
+        */
+        uInt32 clock(uInt32 cycles) {
+          const uInt64 clocks = uInt64(cycles) * CLOCKS_PER_CYCLE + myFraction;
+          const uInt32 wholeClocks = clocks > 0 ? uInt32((clocks - 1) / CYCLES_DIVISOR) : 0;
+
+          myFraction = uInt32(clocks - uInt64(wholeClocks) * CYCLES_DIVISOR);
+
+          return wholeClocks;
+        }
+
+        /**
+          The fraction of a clock that has not been counted yet (0..1), as
+          stored in states.
+        */
+        double fraction() const { return double(myFraction) / CYCLES_DIVISOR; }
+        void setFraction(double fraction) {
+          fraction = std::min(std::max(fraction, 0.0), 1.0);
+          myFraction = uInt32(fraction * CYCLES_DIVISOR + 0.5);
+        }
+
+      private:
+        static constexpr uInt32 CLOCKS_PER_CYCLE = 2400;
+        static constexpr uInt32 CYCLES_DIVISOR = 143183;
+
+        // In units of 1 / CYCLES_DIVISOR clocks, 0..CYCLES_DIVISOR
+        uInt32 myFraction;
+    };
+
+    /**
+      The usual layout of ROM banks: 'bankSize' bytes from 'image' are read
+      directly, except for the pages holding the hotspots, which go through
+      peek().  Code access is tracked in myCodeAccessBase.
+
+      @param image     The ROM image, bank after bank
+      @param bankSize  The size of a bank, a power of two
+      @param hotspots  The address of the first hotspot; the pages from
+                       there on go through peek()
+    */
+    BankSegment::Layout romBankLayout(uInt8* image, uInt16 bankSize,
+                                      uInt16 hotspots = 0x2000);
+
     /**
       Get a random value to use when a read from the write port happens.
       Sometimes a RWP means that RAM should be overwritten, sometimes not.
@@ -250,6 +390,16 @@ class Cartridge : public Device
     */
     void pokeRAM(uInt8& dest, uInt16 address, uInt8 value);
 
+    /**
+      Save the internal RAM of the cart.  If it was not written since
+      ramChanged() was last cleared, it is marked as unchanged.
+
+      @param out   The Serializer object to use
+      @param ram   Pointer to the RAM array
+      @param size  The size of the RAM array
+    */
+    void saveRAM(Serializer& out, const uInt8* ram, uInt32 size) const;
+
     /**
       Create an array that holds code-access information for every byte
       of the ROM (indicated by 'size').  Note that this is only used by
@@ -304,6 +454,10 @@ class Cartridge : public Device
     // Indicates if the bank has changed somehow (a bankswitch has occurred)
     bool myBankChanged;
 
+    // Indicates if the internal RAM was (possibly) written since the last
+    // snapshot keyframe
+    bool myRAMChanged;
+
     // The array containing information about every byte of ROM indicating
     // whether it is used as code.
     ByteBuffer myCodeAccessBase;
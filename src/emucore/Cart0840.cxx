@@ -58,6 +58,10 @@ void Cartridge0840::install(System& system)
   for(uInt16 addr = 0x0800; addr < 0x0FFF; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Build the page accesses of all ROM banks
+  myBankSegment.initialize(system, 0x1000, 0x2000, bankCount(),
+                           romBankLayout(myImage, 4096));
+
   // Install pages for bank 0
   bank(startBank());
 }
@@ -131,16 +135,9 @@ bool Cartridge0840::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the ROM bank into the system
+  myBankSegment.map(bank);
 
-  // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
@@ -156,6 +156,9 @@ class Cartridge0840 : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // Previous Device's page access
     System::PageAccess myHotSpotPageAccess[8];
 
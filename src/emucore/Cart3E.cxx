@@ -64,6 +64,27 @@ void Cartridge3E::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Build the page accesses of all ROM banks for the first segment
+  myROMSegment.initialize(system, 0x1000, 0x1800, mySize >> 11,
+                          romBankLayout(myImage.get(), 2048));
+
+  // Build the page accesses of all RAM banks for the first segment: the
+  // read port is mapped directly, while writes go through poke(), since
+  // we need to inspect all accesses to check if RWP happens
+  myRAMSegment.initialize(system, 0x1000, 0x1800, 32,
+    [this](uInt16 bank, uInt16 address) {
+      const uInt32 offset = (bank << 10) + (address & 0x03FF);
+      System::PageAccess access(this, address < 0x1400 ?
+        System::PageAccessType::READ : System::PageAccessType::WRITE);
+
+      if(address < 0x1400)
+        access.directPeekBase = &myRAM[offset];
+      if(myCodeAccessBase)
+        access.codeAccessBase = &myCodeAccessBase[mySize + offset];
+
+      return access;
+    });
+
   // Install pages for the startup bank into the first segment
   bank(startBank());
 }
@@ -137,18 +158,8 @@ bool Cartridge3E::bank(uInt16 bank)
       myCurrentBank = bank % (mySize >> 11);
     }
 
-    uInt32 offset = myCurrentBank << 11;
-
-    // Setup the page access methods for the current bank
-    System::PageAccess access(this, System::PageAccessType::READ);
-
     // Map ROM image into the system
-    for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
-    {
-      access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
-      mySystem->setPageAccess(addr, access);
-    }
+    myROMSegment.map(myCurrentBank);
   }
   else
   {
@@ -156,30 +167,8 @@ bool Cartridge3E::bank(uInt16 bank)
     bank %= 32;
     myCurrentBank = bank + 256;
 
-    uInt32 offset = bank << 10;
-
-    // Setup the page access methods for the current bank
-    System::PageAccess access(this, System::PageAccessType::READ);
-
-    // Map read-port RAM image into the system
-    for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
-    {
-      access.directPeekBase = &myRAM[offset + (addr & 0x03FF)];
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
-      mySystem->setPageAccess(addr, access);
-    }
-
-    access.directPeekBase = nullptr;
-    access.type = System::PageAccessType::WRITE;
-
-    // Map write-port RAM image into the system
-    // Map access to this class, since we need to inspect all accesses to
-    // check if RWP happens
-    for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
-    {
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
-      mySystem->setPageAccess(addr, access);
-    }
+    // Map RAM image into the system
+    myRAMSegment.map(bank);
   }
   return myBankChanged = true;
 }
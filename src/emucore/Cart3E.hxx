@@ -191,6 +191,9 @@ class Cartridge3E : public Cartridge
     // Indicates which bank is currently active for the first segment
     uInt16 myCurrentBank;
 
+    // The page accesses of all ROM and RAM banks for the first segment
+    BankSegment myROMSegment, myRAMSegment;
+
   private:
     // Following constructors and assignment operators not supported
     Cartridge3E() = delete;
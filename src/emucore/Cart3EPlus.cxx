@@ -37,6 +37,7 @@ Cartridge3EPlus::Cartridge3EPlus(const ByteBuffer& image, uInt32 size,
 void Cartridge3EPlus::reset()
 {
   initializeRAM(myRAM, RAM_TOTAL_SIZE);
+  myRAMChanged = true;
 
   // Remember startup bank (0 per spec, rather than last per 3E scheme).
   // Set this to go to 3rd 1K Bank.
@@ -278,6 +279,7 @@ bool Cartridge3EPlus::patch(uInt16 address, uInt8 value)
     uInt32 byteOffset = address & BITMASK_RAM_BANK;
     uInt32 baseAddress = ((whichBankIsThere & BIT_BANK_MASK) << RAM_BANK_TO_POWER) + byteOffset;
     myRAM[baseAddress] = value;     // write to RAM
+    myRAMChanged = true;
 
     // TODO: Stephen -- should we set 'myBankChanged' true when there's a RAM write?
 
@@ -307,7 +309,7 @@ bool Cartridge3EPlus::save(Serializer& out) const
   try
   {
     out.putShortArray(bankInUse, 8);
-    out.putByteArray(myRAM, RAM_TOTAL_SIZE);
+    saveRAM(out, myRAM, RAM_TOTAL_SIZE);
   }
   catch (...)
   {
@@ -324,6 +326,7 @@ bool Cartridge3EPlus::load(Serializer& in)
   {
     in.getShortArray(bankInUse, 8);
     in.getByteArray(myRAM, RAM_TOTAL_SIZE);
+    myRAMChanged = true;
   }
   catch (...)
   {
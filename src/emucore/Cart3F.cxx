@@ -62,6 +62,10 @@ void Cartridge3F::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Build the page accesses of all ROM banks for the first segment
+  myBankSegment.initialize(system, 0x1000, 0x1800, mySize >> 11,
+                           romBankLayout(myImage.get(), 2048));
+
   bank(startBank());
 }
 
@@ -109,18 +113,9 @@ bool Cartridge3F::bank(uInt16 bank)
     myCurrentBank = bank % (mySize >> 11);
   }
 
-  uInt32 offset = myCurrentBank << 11;
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
   // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  myBankSegment.map(myCurrentBank);
+
   return myBankChanged = true;
 }
 
@@ -165,6 +165,9 @@ class Cartridge3F : public Cartridge
     // Indicates which bank is currently active for the first segment
     uInt16 myCurrentBank;
 
+    // The page accesses of all ROM banks for the first segment
+    BankSegment myBankSegment;
+
   private:
     // Following constructors and assignment operators not supported
     Cartridge3F() = delete;
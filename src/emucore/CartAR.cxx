@@ -59,6 +59,11 @@ void CartridgeAR::reset()
   memset(myImage, 0, 6 * 1024);
 #endif
 
+  // The load images are constant while running, so they are tracked like
+  // RAM for incremental snapshots; only resetting or loading a state
+  // changes them
+  myRAMChanged = true;
+
   // Initialize SC BIOS ROM
   initializeROM();
 
@@ -306,20 +311,23 @@ void CartridgeAR::initializeROM()
   // contents placed in the ourDummyROMCode array), the offsets will
   // almost definitely change
 
+  // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
+  memset(myImage + (3<<11), 0x02, 2048);
+
+  // Copy the "dummy" Supercharger BIOS code into the ROM area
+  // The copy is patched below, so that the (shared) original is never
+  // modified by the cartridge instances
+  uInt8* bios = myImage + (3<<11);
+  memcpy(bios, ourDummyROMCode, sizeof(ourDummyROMCode));
+
   // The scrom.asm code checks a value at offset 109 as follows:
   //   0xFF -> do a complete jump over the SC BIOS progress bars code
   //   0x00 -> show SC BIOS progress bars as normal
-  ourDummyROMCode[109] = mySettings.getBool("fastscbios") ? 0xFF : 0x00;
+  bios[109] = mySettings.getBool("fastscbios") ? 0xFF : 0x00;
 
   // The accumulator should contain a random value after exiting the
   // SC BIOS code - a value placed in offset 281 will be stored in A
-  ourDummyROMCode[281] = mySystem->randGenerator().next();
-
-  // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
-  memset(myImage + (3<<11), 0x02, 2048);
-
-  // Copy the "dummy" Supercharger BIOS code into the ROM area
-  memcpy(myImage + (3<<11), ourDummyROMCode, sizeof(ourDummyROMCode));
+  bios[281] = mySystem->randGenerator().next();
 
   // Finally set 6502 vectors to point to initial load code at 0xF80A of BIOS
   myImage[(3<<11) + 2044] = 0x0A;
@@ -448,7 +456,7 @@ bool CartridgeAR::save(Serializer& out) const
 
     // All of the 8448 byte loads associated with the game
     // Note that the size of this array is myNumberOfLoadImages * 8448
-    out.putByteArray(myLoadImages.get(), myNumberOfLoadImages * 8448);
+    saveRAM(out, myLoadImages.get(), myNumberOfLoadImages * 8448);
 
     // Indicates how many 8448 loads there are
     out.putByte(myNumberOfLoadImages);
@@ -494,6 +502,7 @@ bool CartridgeAR::load(Serializer& in)
     // All of the 8448 byte loads associated with the game
     // Note that the size of this array is myNumberOfLoadImages * 8448
     in.getByteArray(myLoadImages.get(), myNumberOfLoadImages * 8448);
+    myRAMChanged = true;
 
     // Indicates how many 8448 loads there are
     myNumberOfLoadImages = in.getByte();
@@ -523,7 +532,7 @@ bool CartridgeAR::load(Serializer& in)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 CartridgeAR::ourDummyROMCode[] = {
+const uInt8 CartridgeAR::ourDummyROMCode[] = {
   0xa5, 0xfa, 0x85, 0x80, 0x4c, 0x18, 0xf8, 0xff,
   0xff, 0xff, 0x78, 0xd8, 0xa0, 0x00, 0xa2, 0x00,
   0x94, 0x00, 0xe8, 0xd0, 0xfb, 0x4c, 0x50, 0xf8,
@@ -43,6 +43,10 @@ void CartridgeBF::install(System& system)
 {
   mySystem = &system;
 
+  // Build the page accesses of all ROM banks
+  myBankSegment.initialize(system, 0x1000, 0x2000, bankCount(),
+                           romBankLayout(myImage, 4096, 0x1F80));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -83,24 +87,9 @@ bool CartridgeBF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PageAccessType::READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the ROM bank into the system
+  myBankSegment.map(bank);
 
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < (0x1F80U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
@@ -65,6 +65,10 @@ void CartridgeBFSC::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Build the page accesses of all ROM banks
+  myBankSegment.initialize(system, 0x1100, 0x2000, bankCount(),
+                           romBankLayout(myImage, 4096, 0x1F80));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -110,24 +114,9 @@ bool CartridgeBFSC::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the ROM bank into the system
+  myBankSegment.map(bank);
 
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1100; addr < (0x1F80U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
@@ -45,8 +45,7 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, uInt32 size,
                            const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
     myAudioCycles(0),
-    myARMCycles(0),
-    myFractionalClocks(0.0)
+    myARMCycles(0)
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -78,13 +77,14 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, uInt32 size,
 void CartridgeBUS::reset()
 {
   initializeRAM(myBUSRAM+2048, 8192-2048);
+  myRAMChanged = true;
 
   // BUS always starts in bank 6
   initializeStartBank(6);
 
   // Update cycles to the current system cycles
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicOscillator.reset();
 
   setInitialState();
 
@@ -132,6 +132,11 @@ void CartridgeBUS::install(System& system)
   mySystem->tia().installDelegate(system, *this);
   mySystem->m6532().installDelegate(system, *this);
 
+  // Build the page accesses of all Program ROM banks; as all of the
+  // addresses can be fast fetch operands, every read goes through peek()
+  myBankSegment.initialize(system, 0x1040, 0x2000, bankCount(),
+                           romBankLayout(myProgramImage, 4096, 0x1040));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -144,9 +149,7 @@ inline void CartridgeBUS::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicOscillator.clock(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -167,6 +170,8 @@ inline void CartridgeBUS::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        // The ARM code has full access to the cart RAM
+        myRAMChanged = true;
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -267,9 +272,9 @@ uInt8 CartridgeBUS::peek(uInt16 address)
         {
           // using myDisplayImage[] instead of myProgramImage[] because waveforms
           // can be modified during runtime.
-          uInt32 i = myDisplayImage[(getWaveform(0) ) + (myMusicCounters[0] >> myMusicWaveformSize[0])] +
-                     myDisplayImage[(getWaveform(1) ) + (myMusicCounters[1] >> myMusicWaveformSize[1])] +
-                     myDisplayImage[(getWaveform(2) ) + (myMusicCounters[2] >> myMusicWaveformSize[2])];
+          uInt32 i = 0;
+          for(uInt8 x = 0; x <= 2; ++x)
+            i += myDisplayImage[getWaveform(x) + (myMusicCounters[x] >> myMusicWaveformSize[x])];
 
           peekvalue = uInt8(i);
         }
@@ -365,6 +370,7 @@ bool CartridgeBUS::poke(uInt16 address, uInt8 value)
       case 0xFF0: // DSWRITE
         pointer = getDatastreamPointer(COMMSTREAM);
         myDisplayImage[ pointer >> 20 ] = value;
+        myRAMChanged = true;
         pointer += 0x100000;  // always increment by 1 when writing
         setDatastreamPointer(COMMSTREAM, pointer);
         break;
@@ -436,15 +442,9 @@ bool CartridgeBUS::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
   // Map Program ROM image into the system
-  for(uInt16 addr = 0x1040; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  myBankSegment.map(bank);
+
   return myBankChanged = true;
 }
 
@@ -547,7 +547,7 @@ bool CartridgeBUS::save(Serializer& out) const
     out.putShort(myBankOffset);
 
     // Harmony RAM
-    out.putByteArray(myBUSRAM, 8192);
+    saveRAM(out, myBUSRAM, 8192);
 
     // Addresses for bus override logic
     out.putShort(myBusOverdriveAddress);
@@ -556,7 +556,7 @@ bool CartridgeBUS::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicOscillator.fraction());
     out.putLong(myARMCycles);
 
     // Audio info
@@ -589,6 +589,7 @@ bool CartridgeBUS::load(Serializer& in)
 
     // Harmony RAM
     in.getByteArray(myBUSRAM, 8192);
+    myRAMChanged = true;
 
     // Addresses for bus override logic
     myBusOverdriveAddress = in.getShort();
@@ -597,7 +598,7 @@ bool CartridgeBUS::load(Serializer& in)
 
     // Get system cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicOscillator.setFraction(in.getDouble());
     myARMCycles = in.getLong();
 
     // Audio info
@@ -642,6 +643,7 @@ void CartridgeBUS::setDatastreamPointer(uInt8 index, uInt32 value)
   myBUSRAM[DSxPTR + index*4 + 1] = (value >> 8) & 0xff;
   myBUSRAM[DSxPTR + index*4 + 2] = (value >> 16) & 0xff;
   myBUSRAM[DSxPTR + index*4 + 3] = (value >> 24) & 0xff;  // high byte
+  myRAMChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -721,6 +723,7 @@ void CartridgeBUS::setAddressMap(uInt8 index, uInt32 value)
   myBUSRAM[DSMAPS + index*4 + 1] = (value >> 8) & 0xff;
   myBUSRAM[DSMAPS + index*4 + 2] = (value >> 16) & 0xff;
   myBUSRAM[DSMAPS + index*4 + 3] = (value >> 24) & 0xff;  // high byte
+  myRAMChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -138,6 +138,11 @@ class CartridgeBUS : public Cartridge
     */
     string name() const override { return "CartridgeBUS"; }
 
+    /**
+      Get the ARM emulator running the code of the cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
     uInt8 busOverdrive(uInt16 address);
 
   /**
@@ -232,6 +237,9 @@ class CartridgeBUS : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // Address to override the bus for
     uInt16 myBusOverdriveAddress;
 
@@ -257,8 +265,8 @@ class CartridgeBUS : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // The music OSC, with the fractional clocks unused during the last update
+    MusicOscillator myMusicOscillator;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
@@ -61,8 +61,7 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, uInt32 size,
                            const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
     myAudioCycles(0),
-    myARMCycles(0),
-    myFractionalClocks(0.0)
+    myARMCycles(0)
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -95,12 +94,13 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, uInt32 size,
 void CartridgeCDF::reset()
 {
   initializeRAM(myCDFRAM+2048, 8192-2048);
+  myRAMChanged = true;
 
   // CDF always starts in bank 6
   initializeStartBank(6);
 
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicOscillator.reset();
 
   setInitialState();
 
@@ -141,6 +141,11 @@ void CartridgeCDF::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1040; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Build the page accesses of all Program ROM banks; as all of the
+  // addresses can be fast fetch operands, every read goes through peek()
+  myBankSegment.initialize(system, 0x1040, 0x2000, bankCount(),
+                           romBankLayout(myProgramImage, 4096, 0x1040));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -153,9 +158,7 @@ inline void CartridgeCDF::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of CDF OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicOscillator.clock(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -176,6 +179,8 @@ inline void CartridgeCDF::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        // The ARM code has full access to the cart RAM
+        myRAMChanged = true;
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -265,9 +270,11 @@ uInt8 CartridgeCDF::peek(uInt16 address)
       }
       else
       {
-        peekvalue = myDisplayImage[getWaveform(0) + (myMusicCounters[0] >> myMusicWaveformSize[0])]
-                  + myDisplayImage[getWaveform(1) + (myMusicCounters[1] >> myMusicWaveformSize[1])]
-                  + myDisplayImage[getWaveform(2) + (myMusicCounters[2] >> myMusicWaveformSize[2])];
+        uInt32 i = 0;
+        for(uInt8 x = 0; x <= 2; ++x)
+          i += myDisplayImage[getWaveform(x) + (myMusicCounters[x] >> myMusicWaveformSize[x])];
+
+        peekvalue = uInt8(i);
       }
       return peekvalue;
     }
@@ -338,6 +345,7 @@ bool CartridgeCDF::poke(uInt16 address, uInt8 value)
     case 0xFF0:   // DSWRITE
       pointer = getDatastreamPointer(COMMSTREAM);
       myDisplayImage[ pointer >> 20 ] = value;
+      myRAMChanged = true;
       pointer += 0x100000;  // always increment by 1 when writing
       setDatastreamPointer(COMMSTREAM, pointer);
       break;
@@ -408,15 +416,9 @@ bool CartridgeCDF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
   // Map Program ROM image into the system
-  for(uInt16 addr = 0x1040; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  myBankSegment.map(bank);
+
   return myBankChanged = true;
 }
 
@@ -504,7 +506,7 @@ bool CartridgeCDF::save(Serializer& out) const
     out.putShort(myJMPoperandAddress);
 
     // Harmony RAM
-    out.putByteArray(myCDFRAM, 8192);
+    saveRAM(out, myCDFRAM, 8192);
 
     // Audio info
     out.putIntArray(myMusicCounters, 3);
@@ -513,7 +515,7 @@ bool CartridgeCDF::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicOscillator.fraction());
     out.putLong(myARMCycles);
   }
   catch(...)
@@ -545,6 +547,7 @@ bool CartridgeCDF::load(Serializer& in)
 
     // Harmony RAM
     in.getByteArray(myCDFRAM, 8192);
+    myRAMChanged = true;
 
     // Audio info
     in.getIntArray(myMusicCounters, 3);
@@ -553,7 +556,7 @@ bool CartridgeCDF::load(Serializer& in)
 
     // Get cycles and clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicOscillator.setFraction(in.getDouble());
     myARMCycles = in.getLong();
   }
   catch(...)
@@ -588,6 +591,7 @@ void CartridgeCDF::setDatastreamPointer(uInt8 index, uInt32 value)
   myCDFRAM[address + 1] = (value >> 8) & 0xff;
   myCDFRAM[address + 2] = (value >> 16) & 0xff;
   myCDFRAM[address + 3] = (value >> 24) & 0xff;  // high byte
+  myRAMChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
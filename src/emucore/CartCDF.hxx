@@ -146,6 +146,11 @@ class CartridgeCDF : public Cartridge
     */
     string name() const override;
 
+    /**
+      Get the ARM emulator running the code of the cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
     /**
       Used for Thumbulator to pass values back to the cartridge
     */
@@ -234,6 +239,9 @@ class CartridgeCDF : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // System cycle count from when the last update to music data fetchers occurred
     uInt64 myAudioCycles;
 
@@ -265,8 +273,8 @@ class CartridgeCDF : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks;
+    // The music OSC, with the fractional clocks unused during the last update
+    MusicOscillator myMusicOscillator;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
@@ -59,6 +59,7 @@ void CartridgeCTY::reset()
   initializeStartBank(1);
 
   myRAM[0] = myRAM[1] = myRAM[2] = myRAM[3] = 0xFF;
+  myRAMChanged = true;
 
   myAudioCycles = 0;
   myFractionalClocks = 0.0;
@@ -273,6 +274,7 @@ bool CartridgeCTY::patch(uInt16 address, uInt8 value)
     // However, the patch command is special in that ignores such
     // cart restrictions
     myRAM[address & 0x003F] = value;
+    myRAMChanged = true;
   }
   else
     myImage[myBankOffset + address] = value;
@@ -293,7 +295,7 @@ bool CartridgeCTY::save(Serializer& out) const
   try
   {
     out.putShort(getBank());
-    out.putByteArray(myRAM, 64);
+    saveRAM(out, myRAM, 64);
 
     out.putByte(myOperationType);
     out.putShort(myTunePosition);
@@ -322,6 +324,7 @@ bool CartridgeCTY::load(Serializer& in)
     // Remember what bank we were in
     bank(in.getShort());
     in.getByteArray(myRAM, 64);
+    myRAMChanged = true;
 
     myOperationType = in.getByte();
     myTunePosition = in.getShort();
@@ -417,6 +420,7 @@ uInt8 CartridgeCTY::ramReadWrite()
     {
       myRamAccessTimeout = 0;  // Turn off timer
       myRAM[0] = 0;            // Successful operation
+      myRAMChanged = true;
 
       // Bit 6 is 0, ready/success
       return myImage[myBankOffset + 0xFF4] & ~0x40;
@@ -508,6 +512,7 @@ void CartridgeCTY::loadScore(uInt8 index)
     }
     // Grab 60B slice @ given index (first 4 bytes are ignored)
     memcpy(myRAM+4, scoreRAM + (index << 6) + 4, 60);
+    myRAMChanged = true;
   }
 }
 
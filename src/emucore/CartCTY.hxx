@@ -201,6 +201,11 @@ class CartridgeCTY : public Cartridge
     */
     void setNVRamFile(const string& nvramdir, const string& romfile) override;
 
+    /**
+      The scores are written to the nvram file during emulation.
+    */
+    bool hasExternalState() const override { return true; }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
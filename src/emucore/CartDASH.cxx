@@ -37,6 +37,7 @@ CartridgeDASH::CartridgeDASH(const ByteBuffer& image, uInt32 size,
 void CartridgeDASH::reset()
 {
   initializeRAM(myRAM, RAM_TOTAL_SIZE);
+  myRAMChanged = true;
 
   // Remember startup bank (0 per spec, rather than last per 3E scheme).
   // Set this to go to 3rd 1K Bank.
@@ -283,6 +284,7 @@ bool CartridgeDASH::patch(uInt16 address, uInt8 value)
     uInt32 byteOffset = address & BITMASK_RAM_BANK;
     uInt32 baseAddress = ((whichBankIsThere & BIT_BANK_MASK) << RAM_BANK_TO_POWER) + byteOffset;
     myRAM[baseAddress] = value;     // write to RAM
+    myRAMChanged = true;
 
     // TODO: Stephen -- should we set 'myBankChanged' true when there's a RAM write?
 
@@ -313,7 +315,7 @@ bool CartridgeDASH::save(Serializer& out) const
   {
     out.putShortArray(bankInUse, 8);
     out.putShortArray(segmentInUse, 4);
-    out.putByteArray(myRAM, RAM_TOTAL_SIZE);
+    saveRAM(out, myRAM, RAM_TOTAL_SIZE);
   }
   catch (...)
   {
@@ -331,6 +333,7 @@ bool CartridgeDASH::load(Serializer& in)
     in.getShortArray(bankInUse, 8);
     in.getShortArray(segmentInUse, 4);
     in.getByteArray(myRAM, RAM_TOTAL_SIZE);
+    myRAMChanged = true;
   }
   catch (...)
   {
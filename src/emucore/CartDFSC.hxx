@@ -160,6 +160,9 @@ class CartridgeDFSC : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt32 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeDFSC() = delete;
@@ -72,6 +72,10 @@ void CartridgeDPC::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1080; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Build the page accesses of all ROM banks
+  myBankSegment.initialize(system, 0x1080, 0x2000, bankCount(),
+                           romBankLayout(myProgramImage, 4096, 0x1FF8));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -380,24 +384,9 @@ bool CartridgeDPC::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PageAccessType::READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FF8 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the ROM bank into the system
+  myBankSegment.map(bank);
 
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1080; addr < (0x1FF8U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myProgramImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
@@ -206,6 +206,9 @@ class CartridgeDPC : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeDPC() = delete;
@@ -35,7 +35,6 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, uInt32 size,
     myParameterPointer(0),
     myAudioCycles(0),
     myARMCycles(0),
-    myFractionalClocks(0.0),
     myBankOffset(0),
     myFractionalLowMask(0x0F00FF)
 {
@@ -77,7 +76,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, uInt32 size,
 void CartridgeDPCPlus::reset()
 {
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicOscillator.reset();
 
   setInitialState();
 
@@ -96,6 +95,7 @@ void CartridgeDPCPlus::setInitialState()
 
   // Copy initial DPC display data and Frequency table state to Harmony RAM
   memcpy(myDisplayImage, myProgramImage + 0x6000, 0x1400);
+  myRAMChanged = true;
 
   // Initialize the DPC data fetcher registers
   for(int i = 0; i < 8; ++i)
@@ -128,6 +128,11 @@ void CartridgeDPCPlus::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1080; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Build the page accesses of all Program ROM banks; as all of the
+  // addresses can be fast fetch operands, every read goes through peek()
+  myBankSegment.initialize(system, 0x1080, 0x2000, bankCount(),
+                           romBankLayout(myProgramImage, 4096, 0x1080));
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -157,9 +162,7 @@ inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicOscillator.clock(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -178,11 +181,13 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
       myParameterPointer = 0;
       break;
     case 1: // Copy ROM to fetcher
+      myRAMChanged = true;
       for(int i = 0; i < myParameter[3]; ++i)
         myDisplayImage[myCounters[myParameter[2] & 0x7]+i] = myProgramImage[ROMdata+i];
       myParameterPointer = 0;
       break;
     case 2: // Copy value to fetcher
+      myRAMChanged = true;
       for(int i = 0; i < myParameter[3]; ++i)
         myDisplayImage[myCounters[myParameter[2]]+i] = myParameter[0];
       myParameterPointer = 0;
@@ -195,6 +200,8 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        // The ARM code has full access to Harmony RAM
+        myRAMChanged = true;
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -276,9 +283,9 @@ uInt8 CartridgeDPCPlus::peek(uInt16 address)
 
             // using myDisplayImage[] instead of myProgramImage[] because waveforms
             // can be modified during runtime.
-            uInt32 i = myDisplayImage[(myMusicWaveforms[0] << 5) + (myMusicCounters[0] >> 27)] +
-                       myDisplayImage[(myMusicWaveforms[1] << 5) + (myMusicCounters[1] >> 27)] +
-                       myDisplayImage[(myMusicWaveforms[2] << 5) + (myMusicCounters[2] >> 27)];
+            uInt32 i = 0;
+            for(int x = 0; x <= 2; ++x)
+              i += myDisplayImage[(myMusicWaveforms[x] << 5) + (myMusicCounters[x] >> 27)];
 
             result = uInt8(i);
             break;
@@ -469,6 +476,7 @@ bool CartridgeDPCPlus::poke(uInt16 address, uInt8 value)
       {
         myCounters[index] = (myCounters[index] - 0x1) & 0x0fff;
         myDisplayImage[myCounters[index]] = value;
+        myRAMChanged = true;
         break;
       }
 
@@ -528,6 +536,7 @@ bool CartridgeDPCPlus::poke(uInt16 address, uInt8 value)
       case 0x0a:
       {
         myDisplayImage[myCounters[index]] = value;
+        myRAMChanged = true;
         myCounters[index] = (myCounters[index] + 0x1) & 0x0fff;
         break;
       }
@@ -588,15 +597,9 @@ bool CartridgeDPCPlus::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
   // Map Program ROM image into the system
-  for(uInt16 addr = 0x1080; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  myBankSegment.map(bank);
+
   return myBankChanged = true;
 }
 
@@ -643,7 +646,7 @@ bool CartridgeDPCPlus::save(Serializer& out) const
     out.putShort(myBankOffset);
 
     // Harmony RAM
-    out.putByteArray(myDPCRAM, 8192);
+    saveRAM(out, myDPCRAM, 8192);
 
     // The top registers for the data fetchers
     out.putByteArray(myTops, 8);
@@ -681,7 +684,7 @@ bool CartridgeDPCPlus::save(Serializer& out) const
 
     // Get system cycles and fractional clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicOscillator.fraction());
 
     // Clock info for Thumbulator
     out.putLong(myARMCycles);
@@ -705,6 +708,7 @@ bool CartridgeDPCPlus::load(Serializer& in)
 
     // Harmony RAM
     in.getByteArray(myDPCRAM, 8192);
+    myRAMChanged = true;
 
     // The top registers for the data fetchers
     in.getByteArray(myTops, 8);
@@ -742,7 +746,7 @@ bool CartridgeDPCPlus::load(Serializer& in)
 
     // Get audio cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicOscillator.setFraction(in.getDouble());
 
     // Clock info for Thumbulator
     myARMCycles = in.getLong();
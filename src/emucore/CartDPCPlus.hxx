@@ -140,6 +140,11 @@ class CartridgeDPCPlus : public Cartridge
     */
     string name() const override { return "CartridgeDPC+"; }
 
+    /**
+      Get the ARM emulator running the code of the cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
@@ -264,12 +269,15 @@ class CartridgeDPCPlus : public Cartridge
     // System cycle count when the last Thumbulator::run() occurred
     uInt64 myARMCycles;
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // The music OSC, with the fractional clocks unused during the last update
+    MusicOscillator myMusicOscillator;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // Older DPC+ driver code had different behaviour wrt the mask used
     // to retrieve 'DFxFRACLOW' (fractional data pointer low byte)
     // ROMs built with an old DPC+ driver and using the newer mask can
@@ -72,6 +72,12 @@ void CartridgeE0::install(System& system)
   for(uInt16 addr = (0x1FE0 & ~System::PAGE_MASK); addr < 0x2000;
       addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
+
+  // Build the page accesses of all slices for the three switchable segments
+  for(uInt16 segment = 0; segment < 3; ++segment)
+    mySegments[segment].initialize(system, 0x1000 + (segment << 10),
+                                   0x1400 + (segment << 10), 8,
+                                   romBankLayout(myImage, 1024));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -124,17 +130,10 @@ void CartridgeE0::segmentZero(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[0] = slice;
-  uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the slice into the system
+  mySegments[0].map(slice);
 
-  for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
   myBankChanged = true;
 }
 
@@ -145,17 +144,10 @@ void CartridgeE0::segmentOne(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[1] = slice;
-  uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the slice into the system
+  mySegments[1].map(slice);
 
-  for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
   myBankChanged = true;
 }
 
@@ -166,17 +158,10 @@ void CartridgeE0::segmentTwo(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[2] = slice;
-  uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the slice into the system
+  mySegments[2].map(slice);
 
-  for(uInt16 addr = 0x1800; addr < 0x1C00; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
   myBankChanged = true;
 }
 
@@ -167,6 +167,9 @@ class CartridgeE0 : public Cartridge
     // Indicates the slice mapped into each of the four segments
     uInt16 myCurrentSlice[4];
 
+    // The page accesses of all slices for the three switchable segments
+    BankSegment mySegments[3];
+
     // The 8K ROM image of the cartridge
     uInt8 myImage[8192];
 
@@ -141,6 +141,11 @@ class CartridgeFA2 : public Cartridge
     */
     void setNVRamFile(const string& nvramdir, const string& romfile) override;
 
+    /**
+      The flash is written to the nvram file during emulation.
+    */
+    bool hasExternalState() const override { return true; }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
@@ -212,6 +217,9 @@ class CartridgeFA2 : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeFA2() = delete;
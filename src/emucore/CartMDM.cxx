@@ -64,6 +64,10 @@ void CartridgeMDM::install(System& system)
   for(uInt16 addr = 0x0800; addr < 0x0BFF; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Build the page accesses of all ROM banks
+  myBankSegment.initialize(system, 0x1000, 0x2000, bankCount(),
+                           romBankLayout(myImage.get(), 4096));
+
   // Install pages for bank 0
   bank(startBank());
 }
@@ -106,16 +110,8 @@ bool CartridgeMDM::bank(uInt16 bank)
   // Wrap around to a valid bank number if necessary
   myBankOffset = (bank % bankCount()) << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
-  // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the ROM bank into the system
+  myBankSegment.map(myBankOffset >> 12);
 
   // Accesses above bank 127 disable further bankswitching; we're only
   // concerned with the lower byte
@@ -174,6 +174,9 @@ class CartridgeMDM : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt32 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // Indicates whether banking has been disabled due to a bankswitch
     // above bank 127
     bool myBankingDisabled;
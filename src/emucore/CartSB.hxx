@@ -158,6 +158,9 @@ class CartridgeSB : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt32 myBankOffset;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
     // Previous Device's page access
     System::PageAccess myHotSpotPageAccess[8];
 
@@ -166,6 +166,9 @@ class CartridgeX07 : public Cartridge
     // Indicates which bank is currently active
     uInt16 myCurrentBank;
 
+    // The page accesses of all ROM banks
+    BankSegment myBankSegment;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeX07() = delete;
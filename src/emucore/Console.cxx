@@ -59,8 +59,7 @@
 #include "AudioQueue.hxx"
 #include "AudioSettings.hxx"
 #include "frame-manager/FrameManager.hxx"
-#include "frame-manager/FrameLayoutDetector.hxx"
-#include "frame-manager/YStartDetector.hxx"
+#include "frame-manager/FrameLayoutYStartDetector.hxx"
 
 #ifdef CHEATCODE_SUPPORT
   #include "CheatManager.hxx"
@@ -138,20 +137,23 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   myOSystem.sound().mute(1);
   myOSystem.frameBuffer().clear();
 
-  if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
-  {
-    autodetectFrameLayout();
+  const bool detectLayout = myDisplayFormat == "AUTO" ||
+                            myOSystem.settings().getBool("rominfo");
+  const bool detectYStart =
+    atoi(myProperties.get(PropType::Display_YStart).c_str()) == 0;
 
-    if(myProperties.get(PropType::Display_Format) == "AUTO")
-    {
-      autodetected = "*";
-      myCurrentFormat = 0;
-      myFormatAutodetected = true;
-    }
+  // Both are detected in one run, and the results are cached per ROM
+  if((detectLayout || detectYStart) && !loadAutodetection(detectLayout))
+  {
+    autodetectFrameLayoutAndYStart(detectLayout);
+    saveAutodetection(detectLayout);
   }
 
-  if (atoi(myProperties.get(PropType::Display_YStart).c_str()) == 0) {
-    autodetectYStart();
+  if(detectLayout && myProperties.get(PropType::Display_Format) == "AUTO")
+  {
+    autodetected = "*";
+    myCurrentFormat = 0;
+    myFormatAutodetected = true;
   }
 
   myConsoleInfo.DisplayFormat = myDisplayFormat + autodetected;
@@ -227,68 +229,97 @@ Console::~Console()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::autodetectFrameLayout(bool reset)
+void Console::autodetectFrameLayoutAndYStart(bool detectLayout, bool reset)
 {
-  // Run the TIA, looking for PAL scanline patterns
+  // Run the TIA, looking for PAL scanline patterns and the first visible line
   // We turn off the SuperCharger progress bars, otherwise the SC BIOS
   // will take over 250 frames!
   // The 'fastscbios' option must be changed before the system is reset
   bool fastscbios = myOSystem.settings().getBool("fastscbios");
   myOSystem.settings().setValue("fastscbios", true);
 
-  FrameLayoutDetector frameLayoutDetector;
-  myTIA->setFrameManager(&frameLayoutDetector);
+  FrameLayoutYStartDetector detector;
+  if(!detectLayout)
+    detector.setLayout(myDisplayFormat == "PAL" ? FrameLayout::pal : FrameLayout::ntsc);
+  myTIA->setFrameManager(&detector);
 
   if (reset) mySystem->reset(true);
 
-  for(int i = 0; i < 60; ++i) myTIA->update();
+  // Only the timing matters, so don't bother drawing the frames
+  const bool headless = myTIA->isHeadless();
+  myTIA->setHeadless(true);
+
+  // Stop as soon as more frames wouldn't change the results anymore
+  for(uInt32 i = 0; i < FrameLayoutYStartDetector::maxFrames && !detector.isStable(); ++i)
+    myTIA->update();
 
+  myTIA->setHeadless(headless);
   myTIA->setFrameManager(myFrameManager.get());
 
-  myDisplayFormat = frameLayoutDetector.detectedLayout() == FrameLayout::pal ? "PAL" : "NTSC";
+  if(detectLayout)
+    myDisplayFormat = detector.detectedLayout() == FrameLayout::pal ? "PAL" : "NTSC";
+  myAutodetectedYstart = detector.detectedYStart() - YSTART_EXTRA;
 
   // Don't forget to reset the SC progress bars again
   myOSystem.settings().setValue("fastscbios", fastscbios);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::redetectFrameLayout()
+bool Console::loadAutodetection(bool detectLayout)
 {
-  Serializer s;
+  // The cached results have the form '<layout> <NTSC ystart> <PAL ystart>',
+  // where each value is '-' if it hasn't been detected yet
+  istringstream buf(myOSystem.autodetection(myProperties.get(PropType::Cart_MD5)));
+  string layout, ystart[2];
 
-  myOSystem.sound().close();
-  save(s);
+  if(!(buf >> layout >> ystart[0] >> ystart[1]))
+    return false;
+  if(detectLayout && layout != "NTSC" && layout != "PAL")
+    return false;
 
-  autodetectFrameLayout(false);
-  if (myYStartAutodetected) autodetectYStart();
+  // A forced format may need ystart for the other layout
+  const string& format = detectLayout ? layout : myDisplayFormat;
+  const string& cached = ystart[format == "PAL" ? 1 : 0];
+  if(cached == "-")
+    return false;
 
-  load(s);
-  initializeAudio();
+  if(detectLayout)
+    myDisplayFormat = layout;
+  myAutodetectedYstart = atoi(cached.c_str());
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::autodetectYStart(bool reset)
+void Console::saveAutodetection(bool detectLayout)
 {
-  // We turn off the SuperCharger progress bars, otherwise the SC BIOS
-  // will take over 250 frames!
-  // The 'fastscbios' option must be changed before the system is reset
-  bool fastscbios = myOSystem.settings().getBool("fastscbios");
-  myOSystem.settings().setValue("fastscbios", true);
+  const string& md5 = myProperties.get(PropType::Cart_MD5);
 
-  YStartDetector ystartDetector;
-  ystartDetector.setLayout(myDisplayFormat == "PAL" ? FrameLayout::pal : FrameLayout::ntsc);
-  myTIA->setFrameManager(&ystartDetector);
+  // Keep the results for the layout that wasn't detected this time
+  istringstream in(myOSystem.autodetection(md5));
+  string layout = "-", ystart[2] = { "-", "-" };
+  in >> layout >> ystart[0] >> ystart[1];
 
-  if (reset) mySystem->reset(true);
+  if(detectLayout)
+    layout = myDisplayFormat;
+  ystart[myDisplayFormat == "PAL" ? 1 : 0] = std::to_string(myAutodetectedYstart);
 
-  for (int i = 0; i < 80; i++) myTIA->update();
+  myOSystem.setAutodetection(md5, layout + " " + ystart[0] + " " + ystart[1]);
+}
 
-  myTIA->setFrameManager(myFrameManager.get());
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::redetectFrameLayout()
+{
+  Serializer s;
 
-  myAutodetectedYstart = ystartDetector.detectedYStart() - YSTART_EXTRA;
+  myOSystem.sound().close();
+  save(s);
 
-  // Don't forget to reset the SC progress bars again
-  myOSystem.settings().setValue("fastscbios", fastscbios);
+  // This also updates the autodetected ystart
+  autodetectFrameLayoutAndYStart(true, false);
+
+  load(s);
+  initializeAudio();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -299,7 +330,7 @@ void Console::redetectYStart()
   myOSystem.sound().close();
   save(s);
 
-  autodetectYStart(false);
+  autodetectFrameLayoutAndYStart(false, false);
 
   load(s);
   initializeAudio();
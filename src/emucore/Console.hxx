@@ -300,22 +300,36 @@ class Console : public Serializable, public ConsoleIO
 
   private:
     /**
-     * Dry-run the emulation and detect the frame layout (PAL / NTSC).
+     * Dry-run the emulation and detect ystart (the first visible scanline)
+     * and optionally the frame layout (PAL / NTSC) in a single run. Without
+     * layout detection, ystart is detected for the current display format.
      */
-    void autodetectFrameLayout(bool reset = true);
+    void autodetectFrameLayoutAndYStart(bool detectLayout, bool reset = true);
 
     /**
-     * Dryrun the emulation and detect ystart (the first visible scanline).
+     * Take the autodetection results from the cache, if they are usable.
+     *
+     * @param detectLayout  Whether the frame layout is autodetected
+     * @return  True if the cached results were applied
      */
-    void autodetectYStart(bool reset = true);
+    bool loadAutodetection(bool detectLayout);
 
     /**
-     * Rerun frame layout autodetection
+     * Cache the autodetection results of this ROM.
+     *
+     * @param detectLayout  Whether the frame layout was autodetected
+     */
+    void saveAutodetection(bool detectLayout);
+
+    /**
+     * Rerun frame layout autodetection.  Unlike detection at ROM load, this
+     * starts from the current state instead of a reset, so the results
+     * aren't cached.
      */
     void redetectFrameLayout();
 
     /**
-     * Rerun ystart autodetection.
+     * Rerun ystart autodetection; the results aren't cached either.
      */
     void redetectYStart();
 
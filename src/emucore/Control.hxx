@@ -188,6 +188,13 @@ class Controller : public Serializable
     */
     virtual bool isAnalog() const { return false; }
 
+    /**
+      Answers whether the controller keeps state outside of its save state,
+      e.g. in an EEPROM or a device on a serial port.  Such state can't be
+      rolled back by loading a state.
+    */
+    virtual bool hasExternalState() const { return false; }
+
     /**
       Notification method invoked by the system after its reset method has
       been called.  It may be necessary to override this method for
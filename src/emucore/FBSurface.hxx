@@ -299,6 +299,24 @@ class FBSurface
     */
     virtual void resize(uInt32 width, uInt32 height) = 0;
 
+    /**
+      By default, the complete surface is transferred whenever it is
+      rendered. If row tracking is enabled, only the rows marked with
+      markDirtyRows() since the last render() are transferred. Child
+      classes that can't do partial updates may ignore this.
+
+      @param enable  Whether to transfer only the modified rows
+    */
+    virtual void trackDirtyRows(bool enable) { }
+
+    /**
+      Mark the given rows as modified (see trackDirtyRows()).
+
+      @param y  The first modified row
+      @param h  The number of modified rows
+    */
+    virtual void markDirtyRows(uInt32 y, uInt32 h) { }
+
     /**
       The rendering attributes that can be modified for this texture.
       These probably can only be implemented in child FBSurfaces where
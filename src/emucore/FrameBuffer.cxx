@@ -25,6 +25,7 @@
 #include "Settings.hxx"
 #include "TIA.hxx"
 #include "Sound.hxx"
+#include "StateManager.hxx"
 
 #include "FBSurface.hxx"
 #include "TIASurface.hxx"
@@ -271,7 +272,7 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
   const GUI::Font& f = hidpiEnabled() ? infoFont() : font();
   myStatsMsg.color = kColorInfo;
   myStatsMsg.w = f.getMaxCharWidth() * 40 + 3;
-  myStatsMsg.h = (f.getFontHeight() + 2) * 3;
+  myStatsMsg.h = (f.getFontHeight() + 2) * 5;
 
   if(!myStatsMsg.surface)
   {
@@ -505,6 +506,41 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
       myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
 
+  // draw TV filter timing, if enabled
+  if(myTIASurface->ntscEnabled())
+  {
+    const NTSCFilter& ntsc = myTIASurface->ntsc();
+
+    yPos += dy;
+    ss.str("");
+
+    ss
+      << "TV filter "
+      << std::fixed << std::setprecision(2) << ntsc.lastRenderTime() / 1000.0
+      << "ms @ " << ntsc.numThreads()
+      << (ntsc.numThreads() == 1 ? " thread" : " threads");
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+  }
+
+  // draw run-ahead timing, if enabled
+  const StateManager& state = myOSystem.state();
+  if(state.runAheadFrames() > 0)
+  {
+    yPos += dy;
+    ss.str("");
+
+    ss
+      << "Run-ahead "
+      << std::fixed << std::setprecision(2) << state.runAheadTime() / 1000.0
+      << "ms @ " << state.runAheadFrames()
+      << (state.runAheadFrames() == 1 ? " frame" : " frames");
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+  }
+
   myStatsMsg.surface->setDstPos(myImageRect.x() + 10, myImageRect.y() + 8);
   myStatsMsg.surface->setDstSize(myStatsMsg.w * hidpiScaleFactor(),
                                  myStatsMsg.h * hidpiScaleFactor());
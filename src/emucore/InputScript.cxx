@@ -0,0 +1,131 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+
+#include "Event.hxx"
+#include "InputScript.hxx"
+
+namespace {
+  struct Input {
+    const char* name;
+    Event::Type event;
+  };
+
+  // The bit position of each input in the mask equals its index
+  const Input ourInputs[] = {
+    { "p0.up",    Event::JoystickZeroUp    },
+    { "p0.down",  Event::JoystickZeroDown  },
+    { "p0.left",  Event::JoystickZeroLeft  },
+    { "p0.right", Event::JoystickZeroRight },
+    { "p0.fire",  Event::JoystickZeroFire  },
+    { "p1.up",    Event::JoystickOneUp     },
+    { "p1.down",  Event::JoystickOneDown   },
+    { "p1.left",  Event::JoystickOneLeft   },
+    { "p1.right", Event::JoystickOneRight  },
+    { "p1.fire",  Event::JoystickOneFire   },
+    { "reset",    Event::ConsoleReset      },
+    { "select",   Event::ConsoleSelect     }
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+InputScript::InputScript()
+  : myCurrentEntry(0),
+    myInputs(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool InputScript::load(const string& filename, string& error)
+{
+  myEntries.clear();
+  myCurrentEntry = 0;
+  myInputs = 0;
+
+  if(filename == "")
+    return true;
+
+  ifstream in(filename);
+  if(!in)
+  {
+    error = "unable to read input script " + filename;
+    return false;
+  }
+
+  string line;
+  uInt32 lineNo = 0;
+  while(getline(in, line))
+  {
+    ++lineNo;
+
+    istringstream buf(line);
+    string token;
+    if(!(buf >> token) || token[0] == '#')
+      continue;
+
+    Entry entry;
+    char* end = nullptr;
+    entry.frame = uInt32(strtoul(token.c_str(), &end, 10));
+    entry.inputs = 0;
+
+    if(*end != '\0')
+    {
+      error = filename + ":" + std::to_string(lineNo) + ": invalid frame '" + token + "'";
+      return false;
+    }
+
+    while(buf >> token)
+    {
+      uInt32 i = 0;
+      while(i < sizeof(ourInputs) / sizeof(Input) && token != ourInputs[i].name)
+        ++i;
+
+      if(i == sizeof(ourInputs) / sizeof(Input))
+      {
+        error = filename + ":" + std::to_string(lineNo) + ": unknown input '" + token + "'";
+        return false;
+      }
+
+      entry.inputs |= 1 << i;
+    }
+
+    myEntries.push_back(entry);
+  }
+
+  std::stable_sort(myEntries.begin(), myEntries.end(),
+    [](const Entry& a, const Entry& b) { return a.frame < b.frame; });
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InputScript::apply(uInt32 frame, Event& event)
+{
+  uInt32 inputs = myInputs;
+  while(myCurrentEntry < myEntries.size() && myEntries[myCurrentEntry].frame <= frame)
+    inputs = myEntries[myCurrentEntry++].inputs;
+
+  // Only touch the events if something has changed
+  if(inputs == myInputs && frame > 0)
+    return;
+
+  for(uInt32 i = 0; i < sizeof(ourInputs) / sizeof(Input); ++i)
+    event.set(ourInputs[i].event, (inputs >> i) & 1);
+
+  myInputs = inputs;
+}
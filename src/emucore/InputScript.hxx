@@ -0,0 +1,80 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef INPUT_SCRIPT_HXX
+#define INPUT_SCRIPT_HXX
+
+class Event;
+
+#include "bspf.hxx"
+
+/**
+  A scripted sequence of inputs for a headless run. The script is a text file
+  with one entry per line, in the form
+
+    <frame> [<input> ...]
+
+  Each entry sets the inputs which are held from the given frame on, until
+  the next entry.  Valid inputs are 'p0.up', 'p0.down', 'p0.left',
+  'p0.right', 'p0.fire' (and the same for 'p1'), 'reset' and 'select'.
+  Empty lines and lines starting with '#' are ignored.
+*/
+class InputScript
+{
+  public:
+    InputScript();
+
+    /**
+      Load the script from the given file.
+
+      @param filename  The file to load; an empty name gives an empty script
+      @param error     Receives a description of the problem on failure
+
+      @return  True on success, false otherwise
+    */
+    bool load(const string& filename, string& error);
+
+    /**
+      Set the events for the inputs held during the given frame.  Frames
+      must be applied in ascending order.
+    */
+    void apply(uInt32 frame, Event& event);
+
+  private:
+    struct Entry {
+      uInt32 frame;
+      uInt32 inputs;
+    };
+
+    // The entries, sorted by frame
+    vector<Entry> myEntries;
+
+    // The entry applied during the last call to apply()
+    size_t myCurrentEntry;
+
+    // The inputs currently held
+    uInt32 myInputs;
+
+  private:
+    // Following constructors and assignment operators not supported
+    InputScript(const InputScript&) = delete;
+    InputScript(InputScript&&) = delete;
+    InputScript& operator=(const InputScript&) = delete;
+    InputScript& operator=(InputScript&&) = delete;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "Expression.hxx"
+  #include "ConditionProgram.hxx"
   #include "CartDebug.hxx"
   #include "PackedBitArray.hxx"
   #include "Base.hxx"
@@ -49,9 +50,51 @@
 #include "System.hxx"
 #include "M6502.hxx"
 #include "DispatchResult.hxx"
+#include "SubsystemTimer.hxx"
 #include "exception/EmulationWarning.hxx"
 #include "exception/FatalEmulationError.hxx"
 
+// With GCC and clang, the instructions can be dispatched through a table of
+// label addresses instead of a switch statement. Each handler then fetches
+// and dispatches the next opcode itself, which gives the branch predictor
+// one indirect jump per handler to work with instead of a single shared one.
+#if defined(THREADED_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+  #define M6502_THREADED_DISPATCH
+#endif
+
+#ifdef M6502_THREADED_DISPATCH
+  // Labels as values are a GNU extension
+  #pragma GCC diagnostic ignored "-Wpedantic"
+
+  #define OPCODE_CASE(_op) opcode_##_op:
+  #define OPCODE_END NEXT_OPCODE
+  #define OPCODE_ROW(_hi) \
+    &&opcode_0x##_hi##0, &&opcode_0x##_hi##1, &&opcode_0x##_hi##2, &&opcode_0x##_hi##3, \
+    &&opcode_0x##_hi##4, &&opcode_0x##_hi##5, &&opcode_0x##_hi##6, &&opcode_0x##_hi##7, \
+    &&opcode_0x##_hi##8, &&opcode_0x##_hi##9, &&opcode_0x##_hi##a, &&opcode_0x##_hi##b, \
+    &&opcode_0x##_hi##c, &&opcode_0x##_hi##d, &&opcode_0x##_hi##e, &&opcode_0x##_hi##f
+
+  // Finish the current instruction; unless the loop in _execute would stop
+  // now, fetch and dispatch the next one right away. The instrumented variant
+  // always returns to the loop, as the debugger checks every instruction.
+  #define NEXT_OPCODE \
+    { \
+      if(instrumented) goto instructionDone; \
+      currentCycles = (mySystem->cycles() - previousCycles); \
+      if(myExecutionStatus || currentCycles >= cycles * SYSTEM_CYCLES_PER_CPU) \
+        goto instructionDone; \
+      operandAddress = intermediateAddress = 0; \
+      operand = 0; \
+      myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0; \
+      icycles = 0; \
+      IR = peek<instrumented>(PC++, DISASM_CODE); \
+      goto *ourOpcodeHandlers[IR]; \
+    }
+#else
+  #define OPCODE_CASE(_op) case _op:
+  #define OPCODE_END break;
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502::M6502(const Settings& settings)
   : myExecutionStatus(0),
@@ -82,9 +125,18 @@ M6502::M6502(const Settings& settings)
 #ifdef DEBUGGER_SUPPORT
   myDebugger = nullptr;
   myJustHitReadTrapFlag = myJustHitWriteTrapFlag = false;
+
+  myCondBreakProgram = make_unique<ConditionProgram>();
+  myCondSaveStateProgram = make_unique<ConditionProgram>();
+  myTrapCondProgram = make_unique<ConditionProgram>();
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+M6502::~M6502()
+{
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::install(System& system)
 {
@@ -131,6 +183,7 @@ void M6502::reset()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool instrumented>
 inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 {
   handleHalt();
@@ -150,7 +203,7 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
   myLastPeekAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myReadTraps.isInitialized() && myReadTraps.isSet(address)
+  if(instrumented && myReadTraps.isInitialized() && myReadTraps.isSet(address)
      && (myGhostReadsTrap || flags != DISASM_NONE))
   {
     myLastPeekBaseAddress = myDebugger->getBaseAddress(myLastPeekAddress, true); // mirror handling
@@ -171,6 +224,7 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool instrumented>
 inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
 {
   ////////////////////////////////////////////////
@@ -187,7 +241,7 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
   myLastPokeAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
+  if(instrumented && myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
   {
     myLastPokeBaseAddress = myDebugger->getBaseAddress(myLastPokeAddress, false); // mirror handling
     int cond = evalCondTraps();
@@ -222,7 +276,14 @@ inline void M6502::handleHalt()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::execute(uInt64 number, DispatchResult& result)
 {
-  _execute(number, result);
+  PROFILE_SUBSYSTEM(cpu);
+
+#ifdef DEBUGGER_SUPPORT
+  if(instrumentationActive())
+    _execute<true>(number, result);
+  else
+#endif
+    _execute<false>(number, result);
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger hack: this ensures that stepping a "STA WSYNC" will actually end at the
@@ -250,6 +311,7 @@ bool M6502::execute(uInt64 number)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool instrumented>
 inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
 {
   myExecutionStatus = 0;
@@ -269,7 +331,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
     {
   #ifdef DEBUGGER_SUPPORT
       // Don't break if we haven't actually executed anything yet
-      if (myLastBreakCycle != mySystem->cycles()) {
+      if (instrumented && myLastBreakCycle != mySystem->cycles()) {
         if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
         {
           bool read = myJustHitReadTrapFlag;
@@ -298,15 +360,17 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         }
       }
 
-      int cond = evalCondSaveStates();
-      if(cond > -1)
-      {
-        ostringstream msg;
-        msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
-        myDebugger->addState(msg.str());
-      }
+      if (instrumented) {
+        int cond = evalCondSaveStates();
+        if(cond > -1)
+        {
+          ostringstream msg;
+          msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
+          myDebugger->addState(msg.str());
+        }
 
-      mySystem->cart().clearAllRAMAccesses();
+        mySystem->cart().clearAllRAMAccesses();
+      }
   #endif  // DEBUGGER_SUPPORT
 
       uInt16 operandAddress = 0, intermediateAddress = 0;
@@ -322,9 +386,24 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
     #endif
 
         // Fetch instruction at the program counter
-        IR = peek(PC++, DISASM_CODE);  // This address represents a code section
+        IR = peek<instrumented>(PC++, DISASM_CODE);  // This address represents a code section
 
         // Call code to execute the instruction
+      #ifdef M6502_THREADED_DISPATCH
+        static const void* const ourOpcodeHandlers[256] = {
+          OPCODE_ROW(0), OPCODE_ROW(1), OPCODE_ROW(2), OPCODE_ROW(3),
+          OPCODE_ROW(4), OPCODE_ROW(5), OPCODE_ROW(6), OPCODE_ROW(7),
+          OPCODE_ROW(8), OPCODE_ROW(9), OPCODE_ROW(a), OPCODE_ROW(b),
+          OPCODE_ROW(c), OPCODE_ROW(d), OPCODE_ROW(e), OPCODE_ROW(f)
+        };
+
+        goto *ourOpcodeHandlers[IR];
+        {
+          // 6502 instruction emulation is generated by an M4 macro file
+          #include "M6502.ins"
+        }
+      instructionDone: ;
+      #else
         switch(IR)
         {
           // 6502 instruction emulation is generated by an M4 macro file
@@ -333,9 +412,10 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           default:
             FatalEmulationError::raise("invalid instruction");
         }
+      #endif
 
     #ifdef DEBUGGER_SUPPORT
-        if(myReadFromWritePortBreak)
+        if(instrumented && myReadFromWritePortBreak)
         {
           uInt16 rwpAddr = mySystem->cart().getIllegalRAMAccess();
           if(rwpAddr)
@@ -358,7 +438,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
       currentCycles = (mySystem->cycles() - previousCycles);
 
   #ifdef DEBUGGER_SUPPORT
-      if(myStepStateByInstruction)
+      if(instrumented && myStepStateByInstruction)
       {
         // Check out M6502::execute for an explanation.
         handleHalt();
@@ -540,6 +620,7 @@ uInt32 M6502::addCondBreak(Expression* e, const string& name)
 {
   myCondBreaks.emplace_back(e);
   myCondBreakNames.push_back(name);
+  myCondBreakProgram->compile(myCondBreaks);
 
   updateStepStateByInstruction();
 
@@ -553,6 +634,7 @@ bool M6502::delCondBreak(uInt32 idx)
   {
     Vec::removeAt(myCondBreaks, idx);
     Vec::removeAt(myCondBreakNames, idx);
+    myCondBreakProgram->compile(myCondBreaks);
 
     updateStepStateByInstruction();
 
@@ -566,6 +648,7 @@ void M6502::clearCondBreaks()
 {
   myCondBreaks.clear();
   myCondBreakNames.clear();
+  myCondBreakProgram->compile(myCondBreaks);
 
   updateStepStateByInstruction();
 }
@@ -581,6 +664,7 @@ uInt32 M6502::addCondSaveState(Expression* e, const string& name)
 {
   myCondSaveStates.emplace_back(e);
   myCondSaveStateNames.push_back(name);
+  myCondSaveStateProgram->compile(myCondSaveStates);
 
   updateStepStateByInstruction();
 
@@ -594,6 +678,7 @@ bool M6502::delCondSaveState(uInt32 idx)
   {
     Vec::removeAt(myCondSaveStates, idx);
     Vec::removeAt(myCondSaveStateNames, idx);
+    myCondSaveStateProgram->compile(myCondSaveStates);
 
     updateStepStateByInstruction();
 
@@ -607,6 +692,7 @@ void M6502::clearCondSaveStates()
 {
   myCondSaveStates.clear();
   myCondSaveStateNames.clear();
+  myCondSaveStateProgram->compile(myCondSaveStates);
 
   updateStepStateByInstruction();
 }
@@ -622,6 +708,7 @@ uInt32 M6502::addCondTrap(Expression* e, const string& name)
 {
   myTrapConds.emplace_back(e);
   myTrapCondNames.push_back(name);
+  myTrapCondProgram->compile(myTrapConds);
 
   updateStepStateByInstruction();
 
@@ -635,6 +722,7 @@ bool M6502::delCondTrap(uInt32 brk)
   {
     Vec::removeAt(myTrapConds, brk);
     Vec::removeAt(myTrapCondNames, brk);
+    myTrapCondProgram->compile(myTrapConds);
 
     updateStepStateByInstruction();
 
@@ -648,6 +736,7 @@ void M6502::clearCondTraps()
 {
   myTrapConds.clear();
   myTrapCondNames.clear();
+  myTrapCondProgram->compile(myTrapConds);
 
   updateStepStateByInstruction();
 }
@@ -658,6 +747,34 @@ const StringList& M6502::getCondTrapNames() const
   return myTrapCondNames;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondBreaks()
+{
+  return myCondBreakProgram->evaluate();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondSaveStates()
+{
+  return myCondSaveStateProgram->evaluate();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondTraps()
+{
+  return myTrapCondProgram->evaluate();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool M6502::instrumentationActive() const
+{
+  // Conditional breaks, save states and traps are covered by
+  // myStepStateByInstruction
+  return myStepStateByInstruction || myReadFromWritePortBreak ||
+         myJustHitReadTrapFlag || myJustHitWriteTrapFlag ||
+         myBreakPoints.isAnySet() || myReadTraps.isAnySet() || myWriteTraps.isAnySet();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::updateStepStateByInstruction()
 {
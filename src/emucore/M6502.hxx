@@ -27,6 +27,7 @@ class DispatchResult;
 #ifdef DEBUGGER_SUPPORT
   class Debugger;
   class CpuDebug;
+  class ConditionProgram;
 
   #include "Expression.hxx"
   #include "PackedBitArray.hxx"
@@ -63,7 +64,7 @@ class M6502 : public Serializable
       Create a new 6502 microprocessor.
     */
     explicit M6502(const Settings& settings);
-    virtual ~M6502() = default;
+    virtual ~M6502();
 
   public:
     /**
@@ -236,6 +237,7 @@ class M6502 : public Serializable
 
     void setGhostReadsTrap(bool enable) { myGhostReadsTrap = enable; }
     void setReadFromWritePortBreak(bool enable) { myReadFromWritePortBreak = enable; }
+    bool readFromWritePortBreak() const { return myReadFromWritePortBreak; }
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -250,7 +252,10 @@ class M6502 : public Serializable
                       for type of access (CODE, DATA, GFX, etc)
 
       @return The byte at the specified address
+
+      If 'instrumented' is false, the debugger's read traps are not checked.
     */
+    template<bool instrumented>
     uInt8 peek(uInt16 address, uInt8 flags);
 
     /**
@@ -259,7 +264,10 @@ class M6502 : public Serializable
 
       @param address  The address where the value should be stored
       @param value    The value to be stored at the address
+
+      If 'instrumented' is false, the debugger's write traps are not checked.
     */
+    template<bool instrumented>
     void poke(uInt16 address, uInt8 value, uInt8 flags = 0);
 
     /**
@@ -309,10 +317,21 @@ class M6502 : public Serializable
     /**
       This is the actual dispatch function that does the grunt work. M6502::execute
       wraps it and makes sure that any pending halt is processed before returning.
+
+      The instrumented variant checks breakpoints, traps, conditional breaks and
+      save states and read-from-write-port accesses; the lean variant does none
+      of this and is used whenever none of these is active.
     */
+    template<bool instrumented>
     void _execute(uInt64 cycles, DispatchResult& result);
 
 #ifdef DEBUGGER_SUPPORT
+    /**
+      Check whether any debugger feature that requires the instrumented
+      variant of _execute is active.
+    */
+    bool instrumentationActive() const;
+
     /**
       Check whether we are required to update hardware (TIA + RIOT) in lockstep
       with the CPU and update the flag accordingly.
@@ -396,31 +415,10 @@ class M6502 : public Serializable
     bool myHaltRequested;
 
 #ifdef DEBUGGER_SUPPORT
-    Int32 evalCondBreaks() {
-      for(uInt32 i = 0; i < myCondBreaks.size(); i++)
-        if(myCondBreaks[i]->evaluate())
-          return i;
-
-      return -1; // no break hit
-    }
-
-    Int32 evalCondSaveStates()
-    {
-      for(uInt32 i = 0; i < myCondSaveStates.size(); i++)
-        if(myCondSaveStates[i]->evaluate())
-          return i;
-
-      return -1; // no save state point hit
-    }
-
-    Int32 evalCondTraps()
-    {
-      for(uInt32 i = 0; i < myTrapConds.size(); i++)
-        if(myTrapConds[i]->evaluate())
-          return i;
-
-      return -1; // no trapif hit
-    }
+    // Index of the first condition that is true, or -1 if none is
+    Int32 evalCondBreaks();
+    Int32 evalCondSaveStates();
+    Int32 evalCondTraps();
 
     /// Pointer to the debugger for this processor or the null pointer
     Debugger* myDebugger;
@@ -444,6 +442,11 @@ class M6502 : public Serializable
     StringList myCondSaveStateNames;
     vector<unique_ptr<Expression>> myTrapConds;
     StringList myTrapCondNames;
+
+    // The conditions above, compiled for evaluation on every instruction
+    unique_ptr<ConditionProgram> myCondBreakProgram;
+    unique_ptr<ConditionProgram> myCondSaveStateProgram;
+    unique_ptr<ConditionProgram> myTrapCondProgram;
 #endif  // DEBUGGER_SUPPORT
 
     bool myGhostReadsTrap;          // trap on ghost reads
@@ -18,6 +18,11 @@
 /**
   Code and cases to emulate each of the 6502 instructions.
 
+  Each instruction starts with OPCODE_CASE(opcode) and ends with OPCODE_END;
+  these are defined by the including code, either as the cases of a switch
+  statement or as the handlers of a computed goto dispatch table.  All 256
+  opcodes must be handled.
+
   Recompile with the following:
     'm4 M6502.m4 > M6502.ins'
 
@@ -54,232 +59,232 @@
 
 
 define(M6502_IMPLIED, `{
-  peek(PC, DISASM_NONE);
+  peek<instrumented>(PC, DISASM_NONE);
 }')
 
 define(M6502_IMMEDIATE_READ, `{
-  operand = peek(PC++, DISASM_CODE);
+  operand = peek<instrumented>(PC++, DISASM_CODE);
 }')
 
 define(M6502_ABSOLUTE_READ, `{
-  intermediateAddress = peek(PC++, DISASM_CODE);
-  intermediateAddress |= (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  operand = peek(intermediateAddress, DISASM_DATA);
+  intermediateAddress = peek<instrumented>(PC++, DISASM_CODE);
+  intermediateAddress |= (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
 }')
 
 define(M6502_ABSOLUTE_WRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  operandAddress |= (uInt16(peek(PC++, DISASM_CODE)) << 8);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  operandAddress |= (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
 }')
 
 define(M6502_ABSOLUTE_READMODIFYWRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  operandAddress |= (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  operandAddress |= (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_ABSOLUTEX_READ, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
   intermediateAddress = high | uInt8(low + X);
   if((low + X) > 0xFF)
   {
-    operand = peek(intermediateAddress, DISASM_NONE);
+    operand = peek<instrumented>(intermediateAddress, DISASM_NONE);
     intermediateAddress = (high | low) + X;
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
   else
   {
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
 }')
 
 define(M6502_ABSOLUTEX_WRITE, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  peek(high | uInt8(low + X), DISASM_NONE);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  peek<instrumented>(high | uInt8(low + X), DISASM_NONE);
   operandAddress = (high | low) + X;
 }')
 
 define(M6502_ABSOLUTEX_READMODIFYWRITE, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  peek(high | uInt8(low + X), DISASM_NONE);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  peek<instrumented>(high | uInt8(low + X), DISASM_NONE);
   operandAddress = (high | low) + X;
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_ABSOLUTEY_READ, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
   intermediateAddress = high | uInt8(low + Y);
   if((low + Y) > 0xFF)
   {
-    operand = peek(intermediateAddress, DISASM_NONE);
+    operand = peek<instrumented>(intermediateAddress, DISASM_NONE);
     intermediateAddress = (high | low) + Y;
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
   else
   {
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
 }')
 
 define(M6502_ABSOLUTEY_WRITE, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  peek(high | uInt8(low + Y), DISASM_NONE);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  peek<instrumented>(high | uInt8(low + Y), DISASM_NONE);
   operandAddress = (high | low) + Y;
 }')
 
 define(M6502_ABSOLUTEY_READMODIFYWRITE, `{
-  uInt16 low = peek(PC++, DISASM_CODE);
-  uInt16 high = (uInt16(peek(PC++, DISASM_CODE)) << 8);
-  peek(high | uInt8(low + Y), DISASM_NONE);
+  uInt16 low = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 high = (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
+  peek<instrumented>(high | uInt8(low + Y), DISASM_NONE);
   operandAddress = (high | low) + Y;
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_ZERO_READ, `{
-  intermediateAddress = peek(PC++, DISASM_CODE);
-  operand = peek(intermediateAddress, DISASM_DATA);
+  intermediateAddress = peek<instrumented>(PC++, DISASM_CODE);
+  operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
 }')
 
 define(M6502_ZERO_WRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
 }')
 
 define(M6502_ZERO_READMODIFYWRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_ZEROX_READ, `{
-  intermediateAddress = peek(PC++, DISASM_CODE);
-  peek(intermediateAddress, DISASM_NONE);
+  intermediateAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(intermediateAddress, DISASM_NONE);
   intermediateAddress += X;
-  operand = peek(intermediateAddress, DISASM_DATA);
+  operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
 }')
 
 define(M6502_ZEROX_WRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  peek(operandAddress, DISASM_NONE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(operandAddress, DISASM_NONE);
   operandAddress = (operandAddress + X) & 0xFF;
 }')
 
 define(M6502_ZEROX_READMODIFYWRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  peek(operandAddress, DISASM_NONE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(operandAddress, DISASM_NONE);
   operandAddress = (operandAddress + X) & 0xFF;
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_ZEROY_READ, `{
-  intermediateAddress = peek(PC++, DISASM_CODE);
-  peek(intermediateAddress, DISASM_NONE);
+  intermediateAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(intermediateAddress, DISASM_NONE);
   intermediateAddress += Y;
-  operand = peek(intermediateAddress, DISASM_DATA);
+  operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
 }')
 
 define(M6502_ZEROY_WRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  peek(operandAddress, DISASM_NONE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(operandAddress, DISASM_NONE);
   operandAddress = (operandAddress + Y) & 0xFF;
 }')
 
 define(M6502_ZEROY_READMODIFYWRITE, `{
-  operandAddress = peek(PC++, DISASM_CODE);
-  peek(operandAddress, DISASM_NONE);
+  operandAddress = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(operandAddress, DISASM_NONE);
   operandAddress = (operandAddress + Y) & 0xFF;
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_INDIRECT, `{
-  uInt16 addr = peek(PC++, DISASM_CODE);
-  addr |= (uInt16(peek(PC++, DISASM_CODE)) << 8);
+  uInt16 addr = peek<instrumented>(PC++, DISASM_CODE);
+  addr |= (uInt16(peek<instrumented>(PC++, DISASM_CODE)) << 8);
 
   // Simulate the error in the indirect addressing mode!
   uInt16 high = NOTSAMEPAGE(addr, addr + 1) ? (addr & 0xff00) : (addr + 1);
 
-  operandAddress = peek(addr, DISASM_DATA);
-  operandAddress |= (uInt16(peek(high, DISASM_DATA)) << 8);
+  operandAddress = peek<instrumented>(addr, DISASM_DATA);
+  operandAddress |= (uInt16(peek<instrumented>(high, DISASM_DATA)) << 8);
 }')
 
 define(M6502_INDIRECTX_READ, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  peek(pointer, DISASM_NONE);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(pointer, DISASM_NONE);
   pointer += X;
-  intermediateAddress = peek(pointer++, DISASM_DATA);
-  intermediateAddress |= (uInt16(peek(pointer, DISASM_DATA)) << 8);
-  operand = peek(intermediateAddress, DISASM_DATA);
+  intermediateAddress = peek<instrumented>(pointer++, DISASM_DATA);
+  intermediateAddress |= (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
+  operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
 }')
 
 define(M6502_INDIRECTX_WRITE, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  peek(pointer, DISASM_NONE);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(pointer, DISASM_NONE);
   pointer += X;
-  operandAddress = peek(pointer++, DISASM_DATA);
-  operandAddress |= (uInt16(peek(pointer, DISASM_DATA)) << 8);
+  operandAddress = peek<instrumented>(pointer++, DISASM_DATA);
+  operandAddress |= (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
 }')
 
 define(M6502_INDIRECTX_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  peek(pointer, DISASM_NONE);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(pointer, DISASM_NONE);
   pointer += X;
-  operandAddress = peek(pointer++, DISASM_DATA);
-  operandAddress |= (uInt16(peek(pointer, DISASM_DATA)) << 8);
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operandAddress = peek<instrumented>(pointer++, DISASM_DATA);
+  operandAddress |= (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_INDIRECTY_READ, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  uInt16 low = peek(pointer++, DISASM_DATA);
-  uInt16 high = (uInt16(peek(pointer, DISASM_DATA)) << 8);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 low = peek<instrumented>(pointer++, DISASM_DATA);
+  uInt16 high = (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
   intermediateAddress = high | uInt8(low + Y);
   if((low + Y) > 0xFF)
   {
-    operand = peek(intermediateAddress, DISASM_NONE);
+    operand = peek<instrumented>(intermediateAddress, DISASM_NONE);
     intermediateAddress = (high | low) + Y;
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
   else
   {
-    operand = peek(intermediateAddress, DISASM_DATA);
+    operand = peek<instrumented>(intermediateAddress, DISASM_DATA);
   }
 }')
 
 define(M6502_INDIRECTY_WRITE, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  uInt16 low = peek(pointer++, DISASM_DATA);
-  uInt16 high = (uInt16(peek(pointer, DISASM_DATA)) << 8);
-  peek(high | uInt8(low + Y), DISASM_NONE);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 low = peek<instrumented>(pointer++, DISASM_DATA);
+  uInt16 high = (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
+  peek<instrumented>(high | uInt8(low + Y), DISASM_NONE);
   operandAddress = (high | low) + Y;
 }')
 
 define(M6502_INDIRECTY_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++, DISASM_CODE);
-  uInt16 low = peek(pointer++, DISASM_DATA);
-  uInt16 high = (uInt16(peek(pointer, DISASM_DATA)) << 8);
-  peek(high | uInt8(low + Y), DISASM_NONE);
+  uInt8 pointer = peek<instrumented>(PC++, DISASM_CODE);
+  uInt16 low = peek<instrumented>(pointer++, DISASM_DATA);
+  uInt16 high = (uInt16(peek<instrumented>(pointer, DISASM_DATA)) << 8);
+  peek<instrumented>(high | uInt8(low + Y), DISASM_NONE);
   operandAddress = (high | low) + Y;
-  operand = peek(operandAddress, DISASM_DATA);
-  poke(operandAddress, operand, DISASM_WRITE);
+  operand = peek<instrumented>(operandAddress, DISASM_DATA);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 }')
 
 define(M6502_BCC, `{
   if(!C)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -287,10 +292,10 @@ define(M6502_BCC, `{
 define(M6502_BCS, `{
   if(C)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -298,10 +303,10 @@ define(M6502_BCS, `{
 define(M6502_BEQ, `{
   if(!notZ)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -309,10 +314,10 @@ define(M6502_BEQ, `{
 define(M6502_BMI, `{
   if(N)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -320,10 +325,10 @@ define(M6502_BMI, `{
 define(M6502_BNE, `{
   if(notZ)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -331,10 +336,10 @@ define(M6502_BNE, `{
 define(M6502_BPL, `{
   if(!N)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -342,10 +347,10 @@ define(M6502_BPL, `{
 define(M6502_BVC, `{
   if(!V)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -353,10 +358,10 @@ define(M6502_BVC, `{
 define(M6502_BVS, `{
   if(V)
   {
-    peek(PC, DISASM_NONE);
+    peek<instrumented>(PC, DISASM_NONE);
     uInt16 address = PC + Int8(operand);
     if(NOTSAMEPAGE(PC, address))
-      peek((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
+      peek<instrumented>((PC & 0xFF00) | (address & 0x00FF), DISASM_NONE);
     PC = address;
   }
 }')
@@ -460,7 +465,7 @@ define(M6502_ASL, `{
   C = operand & 0x80;
 
   operand <<= 1;
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   notZ = operand;
   N = operand & 0x80;
@@ -495,18 +500,18 @@ define(M6502_BIT, `{
 }')
 
 define(M6502_BRK, `{
-  peek(PC++, DISASM_NONE);
+  peek<instrumented>(PC++, DISASM_NONE);
 
   B = true;
 
-  poke(0x0100 + SP--, PC >> 8, DISASM_WRITE);
-  poke(0x0100 + SP--, PC & 0x00ff, DISASM_WRITE);
-  poke(0x0100 + SP--, PS(), DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PC >> 8, DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PC & 0x00ff, DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PS(), DISASM_WRITE);
 
   I = true;
 
-  PC = peek(0xfffe, DISASM_DATA);
-  PC |= (uInt16(peek(0xffff, DISASM_DATA)) << 8);
+  PC = peek<instrumented>(0xfffe, DISASM_DATA);
+  PC |= (uInt16(peek<instrumented>(0xffff, DISASM_DATA)) << 8);
 }')
 
 define(M6502_CLC, `{
@@ -551,7 +556,7 @@ define(M6502_CPY, `{
 
 define(M6502_DCP, `{
   uInt8 value = operand - 1;
-  poke(operandAddress, value, DISASM_WRITE);
+  poke<instrumented>(operandAddress, value, DISASM_WRITE);
 
   uInt16 value2 = uInt16(A) - uInt16(value);
   notZ = value2;
@@ -561,7 +566,7 @@ define(M6502_DCP, `{
 
 define(M6502_DEC, `{
   uInt8 value = operand - 1;
-  poke(operandAddress, value, DISASM_WRITE);
+  poke<instrumented>(operandAddress, value, DISASM_WRITE);
 
   notZ = value;
   N = value & 0x80;
@@ -590,7 +595,7 @@ define(M6502_EOR, `{
 
 define(M6502_INC, `{
   uInt8 value = operand + 1;
-  poke(operandAddress, value, DISASM_WRITE);
+  poke<instrumented>(operandAddress, value, DISASM_WRITE);
 
   notZ = value;
   N = value & 0x80;
@@ -610,7 +615,7 @@ define(M6502_INY, `{
 
 define(M6502_ISB, `{
   operand = operand + 1;
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   // N, V, Z, C flags are the same in either mode (C calculated at the end)
   Int32 sum = A - operand - (C ? 0 : 1);
@@ -644,16 +649,20 @@ define(M6502_JMP, `{
 }')
 
 define(M6502_JSR, `{
-  uInt8 low = peek(PC++, DISASM_CODE);
-  peek(0x0100 + SP, DISASM_NONE);
+  uInt8 low = peek<instrumented>(PC++, DISASM_CODE);
+  peek<instrumented>(0x0100 + SP, DISASM_NONE);
 
   // It seems that the 650x does not push the address of the next instruction
   // on the stack it actually pushes the address of the next instruction
   // minus one.  This is compensated for in the RTS instruction
-  poke(0x0100 + SP--, PC >> 8, DISASM_WRITE);
-  poke(0x0100 + SP--, PC & 0xff, DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PC >> 8, DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PC & 0xff, DISASM_WRITE);
+
+  PC = (low | (uInt16(peek<instrumented>(PC, DISASM_CODE)) << 8));
+}')
 
-  PC = (low | (uInt16(peek(PC, DISASM_CODE)) << 8));
+define(M6502_KIL, `{
+  FatalEmulationError::raise("invalid instruction");
 }')
 
 define(M6502_LAS, `{
@@ -692,7 +701,7 @@ define(M6502_LSR, `{
   C = operand & 0x01;
 
   operand >>= 1;
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   notZ = operand;
   N = false;
@@ -727,28 +736,28 @@ define(M6502_ORA, `{
 }')
 
 define(M6502_PHA, `{
-  poke(0x0100 + SP--, A, DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, A, DISASM_WRITE);
 }')
 
 define(M6502_PHP, `{
-  poke(0x0100 + SP--, PS(), DISASM_WRITE);
+  poke<instrumented>(0x0100 + SP--, PS(), DISASM_WRITE);
 }')
 
 define(M6502_PLA, `{
-  peek(0x0100 + SP++, DISASM_NONE);
-  A = peek(0x0100 + SP, DISASM_DATA);
+  peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  A = peek<instrumented>(0x0100 + SP, DISASM_DATA);
   notZ = A;
   N = A & 0x80;
 }')
 
 define(M6502_PLP, `{
-  peek(0x0100 + SP++, DISASM_NONE);
-  PS(peek(0x0100 + SP, DISASM_DATA));
+  peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  PS(peek<instrumented>(0x0100 + SP, DISASM_DATA));
 }')
 
 define(M6502_RLA, `{
   uInt8 value = (operand << 1) | (C ? 1 : 0);
-  poke(operandAddress, value, DISASM_WRITE);
+  poke<instrumented>(operandAddress, value, DISASM_WRITE);
 
   A &= value;
   C = operand & 0x80;
@@ -763,7 +772,7 @@ define(M6502_ROL, `{
   C = operand & 0x80;
 
   operand = (operand << 1) | (oldC ? 1 : 0);
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   notZ = operand;
   N = operand & 0x80;
@@ -788,7 +797,7 @@ define(M6502_ROR, `{
   C = operand & 0x01;
 
   operand = ((operand >> 1) & 0x7f) | (oldC ? 0x80 : 0x00);
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   notZ = operand;
   N = operand & 0x80;
@@ -813,7 +822,7 @@ define(M6502_RRA, `{
   C = operand & 0x01;
 
   operand = ((operand >> 1) & 0x7f) | (oldC ? 0x80 : 0x00);
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   if(!D)
   {
@@ -846,21 +855,21 @@ define(M6502_RRA, `{
 }')
 
 define(M6502_RTI, `{
-  peek(0x0100 + SP++, DISASM_NONE);
-  PS(peek(0x0100 + SP++, DISASM_NONE));
-  PC = peek(0x0100 + SP++, DISASM_NONE);
-  PC |= (uInt16(peek(0x0100 + SP, DISASM_NONE)) << 8);
+  peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  PS(peek<instrumented>(0x0100 + SP++, DISASM_NONE));
+  PC = peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  PC |= (uInt16(peek<instrumented>(0x0100 + SP, DISASM_NONE)) << 8);
 }')
 
 define(M6502_RTS, `{
-  peek(0x0100 + SP++, DISASM_NONE);
-  PC = peek(0x0100 + SP++, DISASM_NONE);
-  PC |= (uInt16(peek(0x0100 + SP, DISASM_NONE)) << 8);
-  peek(PC++, DISASM_NONE);
+  peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  PC = peek<instrumented>(0x0100 + SP++, DISASM_NONE);
+  PC |= (uInt16(peek<instrumented>(0x0100 + SP, DISASM_NONE)) << 8);
+  peek<instrumented>(PC++, DISASM_NONE);
 }')
 
 define(M6502_SAX, `{
-  poke(operandAddress, A & X, DISASM_WRITE);
+  poke<instrumented>(operandAddress, A & X, DISASM_WRITE);
 }')
 
 define(M6502_SBC, `{
@@ -915,26 +924,26 @@ define(M6502_SEI, `{
 define(M6502_SHA, `{
   // NOTE: There are mixed reports on the actual operation
   // of this instruction!
-  poke(operandAddress, A & X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
+  poke<instrumented>(operandAddress, A & X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
 }')
 
 define(M6502_SHS, `{
   // NOTE: There are mixed reports on the actual operation
   // of this instruction!
   SP = A & X;
-  poke(operandAddress, A & X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
+  poke<instrumented>(operandAddress, A & X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
 }')
 
 define(M6502_SHX, `{
   // NOTE: There are mixed reports on the actual operation
   // of this instruction!
-  poke(operandAddress, X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
+  poke<instrumented>(operandAddress, X & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
 }')
 
 define(M6502_SHY, `{
   // NOTE: There are mixed reports on the actual operation
   // of this instruction!
-  poke(operandAddress, Y & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
+  poke<instrumented>(operandAddress, Y & (((operandAddress >> 8) & 0xff) + 1), DISASM_WRITE);
 }')
 
 define(M6502_SLO, `{
@@ -942,7 +951,7 @@ define(M6502_SLO, `{
   C = operand & 0x80;
 
   operand <<= 1;
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   A |= operand;
   notZ = A;
@@ -954,7 +963,7 @@ define(M6502_SRE, `{
   C = operand & 0x01;
 
   operand = (operand >> 1) & 0x7f;
-  poke(operandAddress, operand, DISASM_WRITE);
+  poke<instrumented>(operandAddress, operand, DISASM_WRITE);
 
   A ^= operand;
   notZ = A;
@@ -962,15 +971,15 @@ define(M6502_SRE, `{
 }')
 
 define(M6502_STA, `{
-  poke(operandAddress, A, DISASM_WRITE);
+  poke<instrumented>(operandAddress, A, DISASM_WRITE);
 }')
 
 define(M6502_STX, `{
-  poke(operandAddress, X, DISASM_WRITE);
+  poke<instrumented>(operandAddress, X, DISASM_WRITE);
 }')
 
 define(M6502_STY, `{
-  poke(operandAddress, Y, DISASM_WRITE);
+  poke<instrumented>(operandAddress, Y, DISASM_WRITE);
 }')
 
 define(M6502_TAX, `{
@@ -1009,1333 +1018,1350 @@ define(M6502_TYA, `{
 
 //////////////////////////////////////////////////
 // ADC
-case 0x69:
+OPCODE_CASE(0x69)
 M6502_IMMEDIATE_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x65:
+OPCODE_CASE(0x65)
 M6502_ZERO_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x75:
+OPCODE_CASE(0x75)
 M6502_ZEROX_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x6d:
+OPCODE_CASE(0x6d)
 M6502_ABSOLUTE_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x7d:
+OPCODE_CASE(0x7d)
 M6502_ABSOLUTEX_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x79:
+OPCODE_CASE(0x79)
 M6502_ABSOLUTEY_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x61:
+OPCODE_CASE(0x61)
 M6502_INDIRECTX_READ
 M6502_ADC
-break;
+OPCODE_END
 
-case 0x71:
+OPCODE_CASE(0x71)
 M6502_INDIRECTY_READ
 M6502_ADC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ASR
-case 0x4b:
+OPCODE_CASE(0x4b)
 M6502_IMMEDIATE_READ
 M6502_ASR
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ANC
-case 0x0b:
-case 0x2b:
+OPCODE_CASE(0x0b)
+OPCODE_CASE(0x2b)
 M6502_IMMEDIATE_READ
 M6502_ANC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // AND
-case 0x29:
+OPCODE_CASE(0x29)
 M6502_IMMEDIATE_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x25:
+OPCODE_CASE(0x25)
 M6502_ZERO_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x35:
+OPCODE_CASE(0x35)
 M6502_ZEROX_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x2d:
+OPCODE_CASE(0x2d)
 M6502_ABSOLUTE_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x3d:
+OPCODE_CASE(0x3d)
 M6502_ABSOLUTEX_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x39:
+OPCODE_CASE(0x39)
 M6502_ABSOLUTEY_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x21:
+OPCODE_CASE(0x21)
 M6502_INDIRECTX_READ
 M6502_AND
-break;
+OPCODE_END
 
-case 0x31:
+OPCODE_CASE(0x31)
 M6502_INDIRECTY_READ
 M6502_AND
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ANE
-case 0x8b:
+OPCODE_CASE(0x8b)
 M6502_IMMEDIATE_READ
 M6502_ANE
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ARR
-case 0x6b:
+OPCODE_CASE(0x6b)
 M6502_IMMEDIATE_READ
 M6502_ARR
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ASL
-case 0x0a:
+OPCODE_CASE(0x0a)
 M6502_IMPLIED
 M6502_ASLA
-break;
+OPCODE_END
 
-case 0x06:
+OPCODE_CASE(0x06)
 M6502_ZERO_READMODIFYWRITE
 M6502_ASL
-break;
+OPCODE_END
 
-case 0x16:
+OPCODE_CASE(0x16)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ASL
-break;
+OPCODE_END
 
-case 0x0e:
+OPCODE_CASE(0x0e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ASL
-break;
+OPCODE_END
 
-case 0x1e:
+OPCODE_CASE(0x1e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ASL
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // BIT
-case 0x24:
+OPCODE_CASE(0x24)
 M6502_ZERO_READ
 M6502_BIT
-break;
+OPCODE_END
 
-case 0x2C:
+OPCODE_CASE(0x2c)
 M6502_ABSOLUTE_READ
 M6502_BIT
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // Branches
-case 0x90:
+OPCODE_CASE(0x90)
 M6502_IMMEDIATE_READ
 M6502_BCC
-break;
+OPCODE_END
 
 
-case 0xb0:
+OPCODE_CASE(0xb0)
 M6502_IMMEDIATE_READ
 M6502_BCS
-break;
+OPCODE_END
 
 
-case 0xf0:
+OPCODE_CASE(0xf0)
 M6502_IMMEDIATE_READ
 M6502_BEQ
-break;
+OPCODE_END
 
 
-case 0x30:
+OPCODE_CASE(0x30)
 M6502_IMMEDIATE_READ
 M6502_BMI
-break;
+OPCODE_END
 
 
-case 0xD0:
+OPCODE_CASE(0xd0)
 M6502_IMMEDIATE_READ
 M6502_BNE
-break;
+OPCODE_END
 
 
-case 0x10:
+OPCODE_CASE(0x10)
 M6502_IMMEDIATE_READ
 M6502_BPL
-break;
+OPCODE_END
 
 
-case 0x50:
+OPCODE_CASE(0x50)
 M6502_IMMEDIATE_READ
 M6502_BVC
-break;
+OPCODE_END
 
 
-case 0x70:
+OPCODE_CASE(0x70)
 M6502_IMMEDIATE_READ
 M6502_BVS
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // BRK
-case 0x00:
+OPCODE_CASE(0x00)
 M6502_BRK
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CLC
-case 0x18:
+OPCODE_CASE(0x18)
 M6502_IMPLIED
 M6502_CLC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CLD
-case 0xd8:
+OPCODE_CASE(0xd8)
 M6502_IMPLIED
 M6502_CLD
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CLI
-case 0x58:
+OPCODE_CASE(0x58)
 M6502_IMPLIED
 M6502_CLI
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CLV
-case 0xb8:
+OPCODE_CASE(0xb8)
 M6502_IMPLIED
 M6502_CLV
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CMP
-case 0xc9:
+OPCODE_CASE(0xc9)
 M6502_IMMEDIATE_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xc5:
+OPCODE_CASE(0xc5)
 M6502_ZERO_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xd5:
+OPCODE_CASE(0xd5)
 M6502_ZEROX_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xcd:
+OPCODE_CASE(0xcd)
 M6502_ABSOLUTE_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xdd:
+OPCODE_CASE(0xdd)
 M6502_ABSOLUTEX_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xd9:
+OPCODE_CASE(0xd9)
 M6502_ABSOLUTEY_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xc1:
+OPCODE_CASE(0xc1)
 M6502_INDIRECTX_READ
 M6502_CMP
-break;
+OPCODE_END
 
-case 0xd1:
+OPCODE_CASE(0xd1)
 M6502_INDIRECTY_READ
 M6502_CMP
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CPX
-case 0xe0:
+OPCODE_CASE(0xe0)
 M6502_IMMEDIATE_READ
 M6502_CPX
-break;
+OPCODE_END
 
-case 0xe4:
+OPCODE_CASE(0xe4)
 M6502_ZERO_READ
 M6502_CPX
-break;
+OPCODE_END
 
-case 0xec:
+OPCODE_CASE(0xec)
 M6502_ABSOLUTE_READ
 M6502_CPX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // CPY
-case 0xc0:
+OPCODE_CASE(0xc0)
 M6502_IMMEDIATE_READ
 M6502_CPY
-break;
+OPCODE_END
 
-case 0xc4:
+OPCODE_CASE(0xc4)
 M6502_ZERO_READ
 M6502_CPY
-break;
+OPCODE_END
 
-case 0xcc:
+OPCODE_CASE(0xcc)
 M6502_ABSOLUTE_READ
 M6502_CPY
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // DCP
-case 0xcf:
+OPCODE_CASE(0xcf)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xdf:
+OPCODE_CASE(0xdf)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xdb:
+OPCODE_CASE(0xdb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xc7:
+OPCODE_CASE(0xc7)
 M6502_ZERO_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xd7:
+OPCODE_CASE(0xd7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xc3:
+OPCODE_CASE(0xc3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
-case 0xd3:
+OPCODE_CASE(0xd3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_DCP
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // DEC
-case 0xc6:
+OPCODE_CASE(0xc6)
 M6502_ZERO_READMODIFYWRITE
 M6502_DEC
-break;
+OPCODE_END
 
-case 0xd6:
+OPCODE_CASE(0xd6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DEC
-break;
+OPCODE_END
 
-case 0xce:
+OPCODE_CASE(0xce)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DEC
-break;
+OPCODE_END
 
-case 0xde:
+OPCODE_CASE(0xde)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DEC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // DEX
-case 0xca:
+OPCODE_CASE(0xca)
 M6502_IMPLIED
 M6502_DEX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // DEY
-case 0x88:
+OPCODE_CASE(0x88)
 M6502_IMPLIED
 M6502_DEY
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // EOR
-case 0x49:
+OPCODE_CASE(0x49)
 M6502_IMMEDIATE_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x45:
+OPCODE_CASE(0x45)
 M6502_ZERO_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x55:
+OPCODE_CASE(0x55)
 M6502_ZEROX_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x4d:
+OPCODE_CASE(0x4d)
 M6502_ABSOLUTE_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x5d:
+OPCODE_CASE(0x5d)
 M6502_ABSOLUTEX_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x59:
+OPCODE_CASE(0x59)
 M6502_ABSOLUTEY_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x41:
+OPCODE_CASE(0x41)
 M6502_INDIRECTX_READ
 M6502_EOR
-break;
+OPCODE_END
 
-case 0x51:
+OPCODE_CASE(0x51)
 M6502_INDIRECTY_READ
 M6502_EOR
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // INC
-case 0xe6:
+OPCODE_CASE(0xe6)
 M6502_ZERO_READMODIFYWRITE
 M6502_INC
-break;
+OPCODE_END
 
-case 0xf6:
+OPCODE_CASE(0xf6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_INC
-break;
+OPCODE_END
 
-case 0xee:
+OPCODE_CASE(0xee)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_INC
-break;
+OPCODE_END
 
-case 0xfe:
+OPCODE_CASE(0xfe)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_INC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // INX
-case 0xe8:
+OPCODE_CASE(0xe8)
 M6502_IMPLIED
 M6502_INX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // INY
-case 0xc8:
+OPCODE_CASE(0xc8)
 M6502_IMPLIED
 M6502_INY
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ISB
-case 0xef:
+OPCODE_CASE(0xef)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xff:
+OPCODE_CASE(0xff)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xfb:
+OPCODE_CASE(0xfb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xe7:
+OPCODE_CASE(0xe7)
 M6502_ZERO_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xf7:
+OPCODE_CASE(0xf7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xe3:
+OPCODE_CASE(0xe3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
-case 0xf3:
+OPCODE_CASE(0xf3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_ISB
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // JMP
-case 0x4c:
+OPCODE_CASE(0x4c)
 M6502_ABSOLUTE_WRITE
 M6502_JMP
-break;
+OPCODE_END
 
-case 0x6c:
+OPCODE_CASE(0x6c)
 M6502_INDIRECT
 M6502_JMP
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // JSR
-case 0x20:
+OPCODE_CASE(0x20)
 M6502_JSR
-break;
+OPCODE_END
+
+//////////////////////////////////////////////////
+// KIL
+OPCODE_CASE(0x02)
+OPCODE_CASE(0x12)
+OPCODE_CASE(0x22)
+OPCODE_CASE(0x32)
+OPCODE_CASE(0x42)
+OPCODE_CASE(0x52)
+OPCODE_CASE(0x62)
+OPCODE_CASE(0x72)
+OPCODE_CASE(0x92)
+OPCODE_CASE(0xb2)
+OPCODE_CASE(0xd2)
+OPCODE_CASE(0xf2)
+M6502_KIL
+OPCODE_END
 
 //////////////////////////////////////////////////
 // LAS
-case 0xbb:
+OPCODE_CASE(0xbb)
 M6502_ABSOLUTEY_READ
 M6502_LAS
-break;
+OPCODE_END
 
 
 //////////////////////////////////////////////////
 // LAX
-case 0xaf:
+OPCODE_CASE(0xaf)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+OPCODE_END
 
-case 0xbf:
+OPCODE_CASE(0xbf)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+OPCODE_END
 
-case 0xa7:
+OPCODE_CASE(0xa7)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+OPCODE_END
 
-case 0xb7:
+OPCODE_CASE(0xb7)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)  // TODO - check this
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+OPCODE_END
 
-case 0xa3:
+OPCODE_CASE(0xa3)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+OPCODE_END
 
-case 0xb3:
+OPCODE_CASE(0xb3)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDA
-case 0xa9:
+OPCODE_CASE(0xa9)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xa5:
+OPCODE_CASE(0xa5)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xb5:
+OPCODE_CASE(0xb5)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xad:
+OPCODE_CASE(0xad)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xbd:
+OPCODE_CASE(0xbd)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xb9:
+OPCODE_CASE(0xb9)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xa1:
+OPCODE_CASE(0xa1)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 
-case 0xb1:
+OPCODE_CASE(0xb1)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDX
-case 0xa2:
+OPCODE_CASE(0xa2)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressX)
 M6502_LDX
-break;
+OPCODE_END
 
-case 0xa6:
+OPCODE_CASE(0xa6)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+OPCODE_END
 
-case 0xb6:
+OPCODE_CASE(0xb6)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+OPCODE_END
 
-case 0xae:
+OPCODE_CASE(0xae)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+OPCODE_END
 
-case 0xbe:
+OPCODE_CASE(0xbe)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDY
-case 0xa0:
+OPCODE_CASE(0xa0)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressY)
 M6502_LDY
-break;
+OPCODE_END
 
-case 0xa4:
+OPCODE_CASE(0xa4)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+OPCODE_END
 
-case 0xb4:
+OPCODE_CASE(0xb4)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+OPCODE_END
 
-case 0xac:
+OPCODE_CASE(0xac)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+OPCODE_END
 
-case 0xbc:
+OPCODE_CASE(0xbc)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // LSR
-case 0x4a:
+OPCODE_CASE(0x4a)
 M6502_IMPLIED
 M6502_LSRA
-break;
+OPCODE_END
 
 
-case 0x46:
+OPCODE_CASE(0x46)
 M6502_ZERO_READMODIFYWRITE
 M6502_LSR
-break;
+OPCODE_END
 
-case 0x56:
+OPCODE_CASE(0x56)
 M6502_ZEROX_READMODIFYWRITE
 M6502_LSR
-break;
+OPCODE_END
 
-case 0x4e:
+OPCODE_CASE(0x4e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_LSR
-break;
+OPCODE_END
 
-case 0x5e:
+OPCODE_CASE(0x5e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_LSR
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // LXA
-case 0xab:
+OPCODE_CASE(0xab)
 M6502_IMMEDIATE_READ
 M6502_LXA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // NOP
-case 0x1a:
-case 0x3a:
-case 0x5a:
-case 0x7a:
-case 0xda:
-case 0xea:
-case 0xfa:
+OPCODE_CASE(0x1a)
+OPCODE_CASE(0x3a)
+OPCODE_CASE(0x5a)
+OPCODE_CASE(0x7a)
+OPCODE_CASE(0xda)
+OPCODE_CASE(0xea)
+OPCODE_CASE(0xfa)
 M6502_IMPLIED
 M6502_NOP
-break;
+OPCODE_END
 
-case 0x80:
-case 0x82:
-case 0x89:
-case 0xc2:
-case 0xe2:
+OPCODE_CASE(0x80)
+OPCODE_CASE(0x82)
+OPCODE_CASE(0x89)
+OPCODE_CASE(0xc2)
+OPCODE_CASE(0xe2)
 M6502_IMMEDIATE_READ
 M6502_NOP
-break;
+OPCODE_END
 
-case 0x04:
-case 0x44:
-case 0x64:
+OPCODE_CASE(0x04)
+OPCODE_CASE(0x44)
+OPCODE_CASE(0x64)
 M6502_ZERO_READ
 M6502_NOP
-break;
-
-case 0x14:
-case 0x34:
-case 0x54:
-case 0x74:
-case 0xd4:
-case 0xf4:
+OPCODE_END
+
+OPCODE_CASE(0x14)
+OPCODE_CASE(0x34)
+OPCODE_CASE(0x54)
+OPCODE_CASE(0x74)
+OPCODE_CASE(0xd4)
+OPCODE_CASE(0xf4)
 M6502_ZEROX_READ
 M6502_NOP
-break;
+OPCODE_END
 
-case 0x0c:
+OPCODE_CASE(0x0c)
 M6502_ABSOLUTE_READ
 M6502_NOP
-break;
-
-case 0x1c:
-case 0x3c:
-case 0x5c:
-case 0x7c:
-case 0xdc:
-case 0xfc:
+OPCODE_END
+
+OPCODE_CASE(0x1c)
+OPCODE_CASE(0x3c)
+OPCODE_CASE(0x5c)
+OPCODE_CASE(0x7c)
+OPCODE_CASE(0xdc)
+OPCODE_CASE(0xfc)
 M6502_ABSOLUTEX_READ
 M6502_NOP
-break;
+OPCODE_END
 
 
 //////////////////////////////////////////////////
 // ORA
-case 0x09:
+OPCODE_CASE(0x09)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x05:
+OPCODE_CASE(0x05)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x15:
+OPCODE_CASE(0x15)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x0d:
+OPCODE_CASE(0x0d)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x1d:
+OPCODE_CASE(0x1d)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x19:
+OPCODE_CASE(0x19)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x01:
+OPCODE_CASE(0x01)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 
-case 0x11:
+OPCODE_CASE(0x11)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // PHA
-case 0x48:
+OPCODE_CASE(0x48)
 M6502_IMPLIED
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_PHA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // PHP
-case 0x08:
+OPCODE_CASE(0x08)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PHP
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // PLA
-case 0x68:
+OPCODE_CASE(0x68)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // PLP
-case 0x28:
+OPCODE_CASE(0x28)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLP
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // RLA
-case 0x2f:
+OPCODE_CASE(0x2f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x3f:
+OPCODE_CASE(0x3f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x3b:
+OPCODE_CASE(0x3b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x27:
+OPCODE_CASE(0x27)
 M6502_ZERO_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x37:
+OPCODE_CASE(0x37)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x23:
+OPCODE_CASE(0x23)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
-case 0x33:
+OPCODE_CASE(0x33)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RLA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ROL
-case 0x2a:
+OPCODE_CASE(0x2a)
 M6502_IMPLIED
 M6502_ROLA
-break;
+OPCODE_END
 
-case 0x26:
+OPCODE_CASE(0x26)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROL
-break;
+OPCODE_END
 
-case 0x36:
+OPCODE_CASE(0x36)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROL
-break;
+OPCODE_END
 
-case 0x2e:
+OPCODE_CASE(0x2e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROL
-break;
+OPCODE_END
 
-case 0x3e:
+OPCODE_CASE(0x3e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROL
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // ROR
-case 0x6a:
+OPCODE_CASE(0x6a)
 M6502_IMPLIED
 M6502_RORA
-break;
+OPCODE_END
 
-case 0x66:
+OPCODE_CASE(0x66)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROR
-break;
+OPCODE_END
 
-case 0x76:
+OPCODE_CASE(0x76)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROR
-break;
+OPCODE_END
 
-case 0x6e:
+OPCODE_CASE(0x6e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROR
-break;
+OPCODE_END
 
-case 0x7e:
+OPCODE_CASE(0x7e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROR
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // RRA
-case 0x6f:
+OPCODE_CASE(0x6f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x7f:
+OPCODE_CASE(0x7f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x7b:
+OPCODE_CASE(0x7b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x67:
+OPCODE_CASE(0x67)
 M6502_ZERO_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x77:
+OPCODE_CASE(0x77)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x63:
+OPCODE_CASE(0x63)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
-case 0x73:
+OPCODE_CASE(0x73)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RRA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // RTI
-case 0x40:
+OPCODE_CASE(0x40)
 M6502_IMPLIED
 M6502_RTI
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // RTS
-case 0x60:
+OPCODE_CASE(0x60)
 M6502_IMPLIED
 M6502_RTS
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SAX
-case 0x8f:
+OPCODE_CASE(0x8f)
 M6502_ABSOLUTE_WRITE
 M6502_SAX
-break;
+OPCODE_END
 
-case 0x87:
+OPCODE_CASE(0x87)
 M6502_ZERO_WRITE
 M6502_SAX
-break;
+OPCODE_END
 
-case 0x97:
+OPCODE_CASE(0x97)
 M6502_ZEROY_WRITE
 M6502_SAX
-break;
+OPCODE_END
 
-case 0x83:
+OPCODE_CASE(0x83)
 M6502_INDIRECTX_WRITE
 M6502_SAX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SBC
-case 0xe9:
-case 0xeb:
+OPCODE_CASE(0xe9)
+OPCODE_CASE(0xeb)
 M6502_IMMEDIATE_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xe5:
+OPCODE_CASE(0xe5)
 M6502_ZERO_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xf5:
+OPCODE_CASE(0xf5)
 M6502_ZEROX_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xed:
+OPCODE_CASE(0xed)
 M6502_ABSOLUTE_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xfd:
+OPCODE_CASE(0xfd)
 M6502_ABSOLUTEX_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xf9:
+OPCODE_CASE(0xf9)
 M6502_ABSOLUTEY_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xe1:
+OPCODE_CASE(0xe1)
 M6502_INDIRECTX_READ
 M6502_SBC
-break;
+OPCODE_END
 
-case 0xf1:
+OPCODE_CASE(0xf1)
 M6502_INDIRECTY_READ
 M6502_SBC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SBX
-case 0xcb:
+OPCODE_CASE(0xcb)
 M6502_IMMEDIATE_READ
 M6502_SBX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SEC
-case 0x38:
+OPCODE_CASE(0x38)
 M6502_IMPLIED
 M6502_SEC
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SED
-case 0xf8:
+OPCODE_CASE(0xf8)
 M6502_IMPLIED
 M6502_SED
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SEI
-case 0x78:
+OPCODE_CASE(0x78)
 M6502_IMPLIED
 M6502_SEI
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SHA
-case 0x9f:
+OPCODE_CASE(0x9f)
 M6502_ABSOLUTEY_WRITE
 M6502_SHA
-break;
+OPCODE_END
 
-case 0x93:
+OPCODE_CASE(0x93)
 M6502_INDIRECTY_WRITE
 M6502_SHA
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SHS
-case 0x9b:
+OPCODE_CASE(0x9b)
 M6502_ABSOLUTEY_WRITE
 M6502_SHS
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SHX
-case 0x9e:
+OPCODE_CASE(0x9e)
 M6502_ABSOLUTEY_WRITE
 M6502_SHX
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SHY
-case 0x9c:
+OPCODE_CASE(0x9c)
 M6502_ABSOLUTEX_WRITE
 M6502_SHY
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SLO
-case 0x0f:
+OPCODE_CASE(0x0f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x1f:
+OPCODE_CASE(0x1f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x1b:
+OPCODE_CASE(0x1b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x07:
+OPCODE_CASE(0x07)
 M6502_ZERO_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x17:
+OPCODE_CASE(0x17)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x03:
+OPCODE_CASE(0x03)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
-case 0x13:
+OPCODE_CASE(0x13)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SLO
-break;
+OPCODE_END
 
 //////////////////////////////////////////////////
 // SRE
-case 0x4f:
+OPCODE_CASE(0x4f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x5f:
+OPCODE_CASE(0x5f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x5b:
+OPCODE_CASE(0x5b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x47:
+OPCODE_CASE(0x47)
 M6502_ZERO_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x57:
+OPCODE_CASE(0x57)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x43:
+OPCODE_CASE(0x43)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
-case 0x53:
+OPCODE_CASE(0x53)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SRE
-break;
+OPCODE_END
 
 
 //////////////////////////////////////////////////
 // STA
-case 0x85:
+OPCODE_CASE(0x85)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_STA
-break;
+OPCODE_END
 
-case 0x95:
+OPCODE_CASE(0x95)
 M6502_ZEROX_WRITE
 M6502_STA
-break;
+OPCODE_END
 
-case 0x8d:
+OPCODE_CASE(0x8d)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_STA
-break;
+OPCODE_END
 
-case 0x9d:
+OPCODE_CASE(0x9d)
 M6502_ABSOLUTEX_WRITE
 M6502_STA
-break;
+OPCODE_END
 
-case 0x99:
+OPCODE_CASE(0x99)
 M6502_ABSOLUTEY_WRITE
 M6502_STA
-break;
+OPCODE_END
 
-case 0x81:
+OPCODE_CASE(0x81)
 M6502_INDIRECTX_WRITE
 M6502_STA
-break;
+OPCODE_END
 
-case 0x91:
+OPCODE_CASE(0x91)
 M6502_INDIRECTY_WRITE
 M6502_STA
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STX
-case 0x86:
+OPCODE_CASE(0x86)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressX)
 M6502_STX
-break;
+OPCODE_END
 
-case 0x96:
+OPCODE_CASE(0x96)
 M6502_ZEROY_WRITE
 M6502_STX
-break;
+OPCODE_END
 
-case 0x8e:
+OPCODE_CASE(0x8e)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressX)
 M6502_STX
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STY
-case 0x84:
+OPCODE_CASE(0x84)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressY)
 M6502_STY
-break;
+OPCODE_END
 
-case 0x94:
+OPCODE_CASE(0x94)
 M6502_ZEROX_WRITE
 M6502_STY
-break;
+OPCODE_END
 
-case 0x8c:
+OPCODE_CASE(0x8c)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressY)
 M6502_STY
-break;
+OPCODE_END
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // Remaining MOVE opcodes
-case 0xaa:
+OPCODE_CASE(0xaa)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressA)
 M6502_TAX
-break;
+OPCODE_END
 
 
-case 0xa8:
+OPCODE_CASE(0xa8)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressY, myLastSrcAddressA)
 M6502_TAY
-break;
+OPCODE_END
 
 
-case 0xba:
+OPCODE_CASE(0xba)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressS)
 M6502_TSX
-break;
+OPCODE_END
 
 
-case 0x8a:
+OPCODE_CASE(0x8a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressX)
 M6502_TXA
-break;
+OPCODE_END
 
 
-case 0x9a:
+OPCODE_CASE(0x9a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressS, myLastSrcAddressX)
 M6502_TXS
-break;
+OPCODE_END
 
 
-case 0x98:
+OPCODE_CASE(0x98)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressY)
 M6502_TYA
-break;
+OPCODE_END
 //////////////////////////////////////////////////
@@ -78,6 +78,7 @@ OSystem::OSystem()
   : myLauncherUsed(false),
     myQuitLoop(false),
     mySettingsLoaded(false),
+    myAutodetectCacheDirty(false),
     myFpsMeter(FPS_METER_QUEUE_SIZE)
 {
   // Get built-in features
@@ -228,6 +229,14 @@ void OSystem::loadConfig(const Settings::Options& options)
   mySettingsLoaded = true;
 
   myPropSet->load(myPropertiesFile);
+
+  // Each line holds the MD5 of a ROM, followed by its autodetection results
+  myAutodetectFile = FilesystemNode(myBaseDir + "autodetect.cache").getPath();
+  ifstream in(myAutodetectFile);
+  string md5, results;
+  while(in >> md5 && getline(in >> std::ws, results))
+    myAutodetectCache[md5] = results;
+  myAutodetectCacheDirty = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -245,6 +254,33 @@ void OSystem::saveConfig()
 
   if(myPropSet && myPropSet->save(myPropertiesFile))
     Logger::log("Saving properties set ...", 2);
+
+  if(myAutodetectCacheDirty)
+  {
+    Logger::log("Saving autodetection cache ...", 2);
+    ofstream out(myAutodetectFile);
+    for(const auto& entry: myAutodetectCache)
+      out << entry.first << " " << entry.second << endl;
+    myAutodetectCacheDirty = !out;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string OSystem::autodetection(const string& md5) const
+{
+  const auto entry = myAutodetectCache.find(md5);
+  return entry != myAutodetectCache.end() ? entry->second : EmptyString;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::setAutodetection(const string& md5, const string& results)
+{
+  string& entry = myAutodetectCache[md5];
+  if(entry != results)
+  {
+    entry = results;
+    myAutodetectCacheDirty = true;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -568,6 +604,7 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
     CMDLINE_PROPS_UPDATE("ystart", PropType::Display_YStart);
     CMDLINE_PROPS_UPDATE("pp", PropType::Display_Phosphor);
     CMDLINE_PROPS_UPDATE("ppblend", PropType::Display_PPBlend);
+    CMDLINE_PROPS_UPDATE("runahead", PropType::Display_RunAhead);
 
     // Finally, create the cart with the correct properties
     if(cart)
@@ -650,11 +687,13 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
 
   // Check whether we have a frame pending for rendering...
   bool framePending = tia.newFramePending();
-  // ... and copy it to the frame buffer. It is important to do this before
-  // the worker is started to avoid racing.
+  // ... and acquire it for rendering. Frames are handed over by swapping
+  // buffers, so the worker can go on completing frames while we render.
   if (framePending) {
     myFpsMeter.render(tia.framesSinceLastRender());
-    tia.renderToFrameBuffer();
+    // Replace the frame by one emulated ahead with the current input
+    myStateManager->runAhead();
+    tia.acquireLatestFrame();
   }
 
   // Start emulation on a dedicated thread. It will do its own scheduling to sync 6507 and real time
@@ -50,6 +50,7 @@ class AudioSettings;
 #endif
 
 #include <chrono>
+#include <map>
 
 #include "FSNode.hxx"
 #include "FrameBufferConstants.hxx"
@@ -130,6 +131,25 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cached results of the frame layout and ystart autodetection
+      for a ROM.  They are kept in their own file, so that the properties
+      file only contains the changes made by the user.
+
+      @param md5  The MD5 of the ROM
+      @return  The cached results, or an empty string if there are none
+    */
+    string autodetection(const string& md5) const;
+
+    /**
+      Cache the results of the frame layout and ystart autodetection
+      for a ROM.
+
+      @param md5      The MD5 of the ROM
+      @param results  The results, in a form only known to the console
+    */
+    void setAutodetection(const string& md5, const string& results);
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -543,6 +563,11 @@ class OSystem
     string myConfigFile;
     string myPaletteFile;
     string myPropertiesFile;
+    string myAutodetectFile;
+
+    // The cached autodetection results, keyed by ROM MD5
+    std::map<string, string> myAutodetectCache;
+    bool myAutodetectCacheDirty;
 
     FilesystemNode myRomFile;
     string myRomMD5;
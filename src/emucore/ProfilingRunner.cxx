@@ -15,8 +15,10 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <iomanip>
 
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
@@ -29,19 +31,27 @@
 #include "TIA.hxx"
 #include "ConsoleTiming.hxx"
 #include "FrameManager.hxx"
-#include "YStartDetector.hxx"
-#include "FrameLayoutDetector.hxx"
+#include "FrameLayoutYStartDetector.hxx"
 #include "EmulationTiming.hxx"
 #include "ConsoleTiming.hxx"
 #include "System.hxx"
 #include "Joystick.hxx"
+#include "Switches.hxx"
+#include "Event.hxx"
 #include "Random.hxx"
 #include "DispatchResult.hxx"
+#include "AudioQueue.hxx"
+#include "InputScript.hxx"
+#include "TIAConstants.hxx"
+#include "SubsystemTimer.hxx"
+#include "Thumbulator.hxx"
 
 using namespace std::chrono;
 
 namespace {
   static constexpr uInt32 RUNTIME_DEFAULT = 60;
+  static constexpr uInt32 FRAMES_DEFAULT = 600;
+  static constexpr uInt32 ARM_FUNCTIONS = 20;
 
   void updateProgress(uInt32 from, uInt32 to) {
     while (from < to) {
@@ -53,42 +63,200 @@ namespace {
       from++;
     }
   }
+
+  // CRC-32 (IEEE 802.3), as used by zip
+  uInt32 crc32(uInt32 crc, const uInt8* data, size_t size)
+  {
+    static uInt32 table[256] = { 0 };
+
+    if (table[1] == 0)
+      for (uInt32 i = 0; i < 256; i++) {
+        uInt32 c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        table[i] = c;
+      }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+  }
+
+  // The samples are checksummed in little endian byte order on all hosts
+  uInt32 crc32(uInt32 crc, const Int16* samples, size_t count)
+  {
+    uInt8 bytes[2];
+
+    for (size_t i = 0; i < count; i++) {
+      bytes[0] = uInt8(samples[i]);
+      bytes[1] = uInt8(uInt16(samples[i]) >> 8);
+      crc = crc32(crc, bytes, 2);
+    }
+
+    return crc;
+  }
+
+  void updateStatistics(double& min, double& median, double& stddev, vector<double> samples)
+  {
+    std::sort(samples.begin(), samples.end());
+
+    const size_t n = samples.size();
+    double mean = 0;
+    for (double sample : samples) mean += sample / n;
+
+    double variance = 0;
+    for (double sample : samples) variance += (sample - mean) * (sample - mean);
+
+    min = samples[0];
+    median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    stddev = n > 1 ? sqrt(variance / (n - 1)) : 0;
+  }
+
+  // Quote a string for use in JSON or CSV, which differ in escaping quotes
+  string quote(const string& s, bool csv = false)
+  {
+    string quoted = "\"";
+    for (char c : s) {
+      if (csv && c == '"') quoted += '"';
+      else if (!csv && (c == '"' || c == '\\')) quoted += '\\';
+      quoted += c;
+    }
+
+    return quoted + "\"";
+  }
+
+  string baseName(const string& path)
+  {
+    size_t pos = path.find_last_of("/\\");
+
+    return pos == string::npos ? path : path.substr(pos + 1);
+  }
 }
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns(std::max(argc - 2, 0))
+  : myHeadless(false),
+    myArmProfile(false),
+    myIterations(1),
+    myRecord(false),
+    mySeed(0),
+    myFailedRuns(0)
 {
   for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
-
     string arg = argv[i];
+
+    // Profile the emulation core only, without drawing frames or generating audio
+    if (arg == "-headless") {
+      myHeadless = true;
+      continue;
+    }
+
+    // Profile the ARM code of DPC+, CDF and BUS carts
+    if (arg == "-armprofile") {
+      myArmProfile = true;
+      continue;
+    }
+
+    // Run each ROM several times and report statistics on the timings
+    if (arg == "-iterations" && i + 1 < argc) {
+      myIterations = std::max(atoi(argv[++i]), 1);
+      continue;
+    }
+
+    if (arg == "-json" && i + 1 < argc) {
+      myJsonFile = argv[++i];
+      continue;
+    }
+
+    if (arg == "-csv" && i + 1 < argc) {
+      myCsvFile = argv[++i];
+      continue;
+    }
+
+    // Compare frame and audio CRCs against (or record them to) a golden file
+    if (arg == "-regress" && i + 1 < argc) {
+      myGoldenFile = argv[++i];
+      continue;
+    }
+
+    if (arg == "-record") {
+      myRecord = true;
+      continue;
+    }
+
+    if (arg == "-seed" && i + 1 < argc) {
+      mySeed = uInt32(strtoul(argv[++i], nullptr, 10));
+      continue;
+    }
+
+    profilingRuns.emplace_back();
+    ProfilingRun& run(profilingRuns.back());
+
     size_t splitPoint = arg.find_first_of(":");
 
     run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+    run.runtime = 0;
 
-    if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
-    else  {
+    if (splitPoint != string::npos) {
       int runtime = atoi(arg.substr(splitPoint+1, string::npos).c_str());
-      run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
+      run.runtime = runtime > 0 ? runtime : 0;
+
+      size_t scriptPoint = arg.find_first_of(":", splitPoint + 1);
+      if (scriptPoint != string::npos) run.scriptFile = arg.substr(scriptPoint + 1);
     }
   }
 
+  // The meaning of the runtime depends on the mode, which may be given last
+  for (ProfilingRun& run : profilingRuns)
+    if (run.runtime == 0)
+      run.runtime = myGoldenFile == "" ? RUNTIME_DEFAULT : FRAMES_DEFAULT;
+
   mySettings.setValue("fastscbios", true);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::run()
 {
-  cout << "Profiling Stella..." << endl;
+  if (myGoldenFile != "") {
+    cout << (myRecord ? "Recording " : "Checking ") << "regressions against "
+         << myGoldenFile << " (seed " << mySeed << ")..." << endl;
+
+    if (!myRecord && !loadGolden()) return false;
+
+    for (ProfilingRun& run : profilingRuns) {
+      cout << endl << "running " << run.romFile << " for " << run.runtime << " frames..." << endl;
+
+      if (!runOne(run)) myFailedRuns++;
+    }
+
+    if (myRecord) return myFailedRuns == 0 && saveGolden();
+
+    cout << endl << (profilingRuns.size() - myFailedRuns) << " of "
+         << profilingRuns.size() << " runs passed" << endl;
+
+    return myFailedRuns == 0;
+  }
+
+  cout << "Profiling Stella" << (myHeadless ? " (headless)..." : "...") << endl;
 
   for (ProfilingRun& run : profilingRuns) {
-    cout << endl << "running " << run.romFile << " for " << run.runtime << " seconds..." << endl;
+    myTimings.clear();
+
+    for (uInt32 i = 0; i < myIterations; i++) {
+      cout << endl << "running " << run.romFile << " for " << run.runtime << " seconds";
+      if (myIterations > 1) cout << " (iteration " << (i + 1) << " of " << myIterations << ")";
+      cout << "..." << endl;
 
-    if (!runOne(run)) return false;
+      if (!runOne(run)) return false;
+    }
+
+    summarize(run);
   }
 
+  if (myJsonFile != "" && !saveJson()) return false;
+  if (myCsvFile != "" && !saveCsv()) return false;
+
   return true;
 }
 
@@ -119,12 +287,13 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
   }
 
   IO consoleIO;
-  Random rng(0);
+  Random rng(mySeed);
   Event event;
+  ConsoleTiming consoleTiming = ConsoleTiming::ntsc;
 
   M6502 cpu(mySettings);
   M6532 riot(consoleIO, mySettings);
-  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, mySettings);
+  TIA tia(consoleIO, [&consoleTiming]() { return consoleTiming; }, mySettings);
   System system(rng, cpu, riot, tia, *cartridge);
 
   consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
@@ -135,15 +304,16 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
   cartridge->setStartBankFromPropsFunc([]() { return -1; });
   system.initialize();
 
-  FrameLayoutDetector frameLayoutDetector;
-  tia.setFrameManager(&frameLayoutDetector);
+  FrameLayoutYStartDetector detector;
+  tia.setFrameManager(&detector);
+  tia.setHeadless(true);
   system.reset();
 
-  (cout << "detecting frame layout... ").flush();
-  for(int i = 0; i < 60; ++i) tia.update();
+  (cout << "detecting frame layout and ystart... ").flush();
+  for(uInt32 i = 0; i < FrameLayoutYStartDetector::maxFrames && !detector.isStable(); ++i)
+    tia.update();
 
-  FrameLayout frameLayout = frameLayoutDetector.detectedLayout();
-  ConsoleTiming consoleTiming = ConsoleTiming::ntsc;
+  FrameLayout frameLayout = detector.detectedLayout();
 
   switch (frameLayout) {
     case FrameLayout::ntsc:
@@ -157,28 +327,41 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
       break;
   }
 
-  (cout << endl).flush();
-
-  YStartDetector ystartDetector;
-  tia.setFrameManager(&ystartDetector);
-  system.reset();
-
-  (cout << "detecting ystart... ").flush();
-  for (int i = 0; i < 80; i++) tia.update();
-
-  uInt32 yStart = ystartDetector.detectedYStart();
-  (cout << yStart << endl).flush();
+  uInt32 yStart = detector.detectedYStart();
+  (cout << ", ystart " << yStart << " (" << detector.frameCount() << " frames)" << endl).flush();
 
   FrameManager frameManager;
   tia.setFrameManager(&frameManager);
   tia.setLayout(frameLayout);
   tia.setYStart(yStart);
+  tia.setHeadless(myHeadless);
 
   system.reset();
 
   EmulationTiming emulationTiming(frameLayout, consoleTiming);
+
+  if (myGoldenFile != "") {
+    // Frames are always drawn and audio is always generated, so both are checked
+    auto audioQueue = make_shared<AudioQueue>(
+      emulationTiming.audioFragmentSize(), emulationTiming.audioQueueCapacity(), false);
+
+    tia.setHeadless(false);
+    tia.setAudioQueue(audioQueue);
+
+    return regress(run, md5, tia, consoleIO, event, *audioQueue);
+  }
+
+  Thumbulator* thumbulator = myArmProfile ? cartridge->thumbulator() : nullptr;
+  if (thumbulator) thumbulator->enableProfiling(true);
+
+  return profile(run, tia, thumbulator, run.runtime * emulationTiming.cyclesPerSecond());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::profile(const ProfilingRun& run, TIA& tia, Thumbulator* thumbulator,
+                              uInt64 cyclesTarget)
+{
   uInt64 cycles = 0;
-  uInt64 cyclesTarget = run.runtime * emulationTiming.cyclesPerSecond();
 
   DispatchResult dispatchResult;
   dispatchResult.setOk(0);
@@ -186,13 +369,35 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
   uInt32 percent = 0;
   (cout << "0%").flush();
 
+#ifdef SUBSYSTEM_TIMERS
+  SubsystemTimer::start();
+#endif
+
   time_point<high_resolution_clock> tp = high_resolution_clock::now();
 
+  // The share of the host time of each frame that was spent in the ARM
+  vector<double> armShares;
+  time_point<high_resolution_clock> frameStart = tp;
+  double armSecondsBefore = 0;
+
   while (cycles < cyclesTarget && dispatchResult.getStatus() == DispatchResult::Status::ok) {
     tia.update(dispatchResult);
     cycles += dispatchResult.getCycles();
 
-    if (tia.newFramePending()) tia.renderToFrameBuffer();
+    if (tia.newFramePending()) {
+      tia.acquireLatestFrame();
+
+      if (thumbulator) {
+        const time_point<high_resolution_clock> now = high_resolution_clock::now();
+        const double frameSeconds = duration_cast<duration<double>>(now - frameStart).count();
+        const double armSeconds = thumbulator->profile()->seconds;
+
+        if (frameSeconds > 0) armShares.push_back((armSeconds - armSecondsBefore) / frameSeconds);
+
+        frameStart = now;
+        armSecondsBefore = armSeconds;
+      }
+    }
 
     uInt32 percentNow = uInt32(std::min((100 * cycles) / cyclesTarget, static_cast<uInt64>(100)));
     updateProgress(percent, percentNow);
@@ -202,6 +407,10 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
 
   double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
 
+#ifdef SUBSYSTEM_TIMERS
+  SubsystemTimer::stop();
+#endif
+
   if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
     cout << endl << "ERROR: emulation failed after " << cycles << " cycles";
     return false;
@@ -209,6 +418,295 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
 
   (cout << "100%" << endl).flush();
   cout << "real time: " << realtimeUsed << " seconds" << endl;
+  cout << "speed: " << (run.runtime / realtimeUsed) << "x realtime" << endl;
+
+  Timing timing;
+  timing.seconds = realtimeUsed;
+
+#ifdef SUBSYSTEM_TIMERS
+  for (uInt32 i = 0; i < SubsystemTimer::numSubsystems; i++) {
+    const auto subsystem = static_cast<SubsystemTimer::Subsystem>(i);
+    const double seconds = SubsystemTimer::share(subsystem) * realtimeUsed;
+
+    timing.subsystems.push_back(seconds);
+    cout << "  " << std::left << std::setw(8) << SubsystemTimer::name(subsystem) << std::right
+         << std::fixed << std::setprecision(3) << std::setw(8) << seconds << " seconds"
+         << std::setprecision(1) << std::setw(7) << (100 * SubsystemTimer::share(subsystem)) << "%"
+         << std::defaultfloat << std::setprecision(6) << endl;
+  }
+#endif
+
+  if (thumbulator) {
+    cout << endl;
+    thumbulator->profile()->print(cout, ARM_FUNCTIONS);
+
+    if (!armShares.empty()) {
+      double min, median, stddev;
+      updateStatistics(min, median, stddev, armShares);
+
+      cout << "ARM share of frame host time: median " << std::fixed << std::setprecision(1)
+           << (100 * median) << "%, max "
+           << (100 * *std::max_element(armShares.begin(), armShares.end())) << "% ("
+           << armShares.size() << " frames)" << std::defaultfloat << std::setprecision(6)
+           << endl;
+    }
+  }
+
+  myTimings.push_back(timing);
 
   return true;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::summarize(const ProfilingRun& run)
+{
+  myReports.emplace_back();
+  Report& report(myReports.back());
+
+  report.romFile = run.romFile;
+  report.runtime = run.runtime;
+
+  report.statistics.emplace_back();
+  report.statistics.back().name = "total";
+  for (const Timing& timing : myTimings)
+    report.statistics.back().samples.push_back(timing.seconds);
+
+#ifdef SUBSYSTEM_TIMERS
+  for (uInt32 i = 0; i < SubsystemTimer::numSubsystems; i++) {
+    report.statistics.emplace_back();
+    report.statistics.back().name = SubsystemTimer::name(static_cast<SubsystemTimer::Subsystem>(i));
+
+    for (const Timing& timing : myTimings)
+      report.statistics.back().samples.push_back(timing.subsystems[i]);
+  }
+#endif
+
+  for (Statistics& statistics : report.statistics)
+    updateStatistics(statistics.min, statistics.median, statistics.stddev, statistics.samples);
+
+  if (myTimings.size() < 2) return;
+
+  cout << endl << "statistics over " << myTimings.size() << " iterations (seconds):" << endl;
+  for (const Statistics& statistics : report.statistics)
+    cout << "  " << std::left << std::setw(8) << statistics.name << std::right << std::fixed
+         << std::setprecision(3) << "  min " << statistics.min
+         << "  median " << statistics.median
+         << "  stddev " << statistics.stddev
+         << std::defaultfloat << std::setprecision(6) << endl;
+
+  cout << "median speed: " << (run.runtime / report.statistics[0].median) << "x realtime" << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::saveJson() const
+{
+  ofstream out(myJsonFile);
+  if (!out) {
+    cout << "ERROR: unable to write " << myJsonFile << endl;
+    return false;
+  }
+
+  out << "{" << endl
+      << "  \"headless\": " << (myHeadless ? "true" : "false") << "," << endl
+      << "  \"iterations\": " << myIterations << "," << endl
+      << "  \"runs\": [";
+
+  for (size_t i = 0; i < myReports.size(); i++) {
+    const Report& report(myReports[i]);
+
+    out << (i > 0 ? "," : "") << endl
+        << "    {" << endl
+        << "      \"rom\": " << quote(report.romFile) << "," << endl
+        << "      \"runtime\": " << report.runtime << "," << endl
+        << "      \"timings\": {";
+
+    for (size_t j = 0; j < report.statistics.size(); j++) {
+      const Statistics& statistics(report.statistics[j]);
+
+      out << (j > 0 ? "," : "") << endl
+          << "        " << quote(statistics.name) << ": { "
+          << "\"min\": " << statistics.min << ", "
+          << "\"median\": " << statistics.median << ", "
+          << "\"stddev\": " << statistics.stddev << ", "
+          << "\"samples\": [";
+
+      for (size_t k = 0; k < statistics.samples.size(); k++)
+        out << (k > 0 ? ", " : "") << statistics.samples[k];
+
+      out << "] }";
+    }
+
+    out << endl << "      }" << endl << "    }";
+  }
+
+  out << endl << "  ]" << endl << "}" << endl;
+
+  cout << endl << "wrote " << myJsonFile << endl;
+
+  return bool(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::saveCsv() const
+{
+  ofstream out(myCsvFile);
+  if (!out) {
+    cout << "ERROR: unable to write " << myCsvFile << endl;
+    return false;
+  }
+
+  out << "rom,runtime,timing,iterations,min,median,stddev" << endl;
+
+  for (const Report& report : myReports)
+    for (const Statistics& statistics : report.statistics)
+      out << quote(report.romFile, true) << ","
+          << report.runtime << ","
+          << statistics.name << ","
+          << statistics.samples.size() << ","
+          << statistics.min << ","
+          << statistics.median << ","
+          << statistics.stddev << endl;
+
+  cout << endl << "wrote " << myCsvFile << endl;
+
+  return bool(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::regress(const ProfilingRun& run, const string& md5, TIA& tia,
+                              IO& consoleIO, Event& event, AudioQueue& audioQueue)
+{
+  InputScript script;
+  string error;
+
+  if (!script.load(run.scriptFile, error)) {
+    cout << "ERROR: " << error << endl;
+    return false;
+  }
+
+  // The run is identified by everything that determines its output, but not
+  // by the location of the files
+  const string header = "rom " + md5 + " frames " + std::to_string(run.runtime) +
+    " seed " + std::to_string(mySeed) +
+    " script " + (run.scriptFile == "" ? "-" : baseName(run.scriptFile));
+
+  vector<string> crcs;
+  crcs.reserve(run.runtime);
+
+  const uInt32 samplesPerFragment =
+    audioQueue.fragmentSize() * (audioQueue.isStereo() ? 2 : 1);
+  Int16* fragment = nullptr;
+
+  DispatchResult dispatchResult;
+  dispatchResult.setOk(0);
+
+  for (uInt32 frame = 0; frame < run.runtime; frame++) {
+    script.apply(frame, event);
+    consoleIO.myLeftControl->update();
+    consoleIO.myRightControl->update();
+    consoleIO.mySwitches->update();
+
+    const uInt32 framesBefore = tia.framesSinceLastRender();
+    do {
+      tia.update(dispatchResult);
+    } while (dispatchResult.getStatus() == DispatchResult::Status::ok &&
+             tia.framesSinceLastRender() == framesBefore);
+
+    if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
+      cout << "ERROR: emulation failed in frame " << frame << endl;
+      return false;
+    }
+
+    tia.acquireLatestFrame();
+    const uInt32 videoCrc = crc32(0, tia.frameBuffer(), TIAConstants::H_PIXEL * tia.height());
+
+    // All fragments completed during this frame
+    uInt32 audioCrc = 0;
+    while (audioQueue.size() > 0) {
+      fragment = audioQueue.dequeue(fragment);
+      audioCrc = crc32(audioCrc, fragment, samplesPerFragment);
+    }
+
+    std::ostringstream buf;
+    buf << frame << " " << std::hex << std::setfill('0')
+        << std::setw(8) << videoCrc << " " << std::setw(8) << audioCrc;
+    crcs.push_back(buf.str());
+  }
+
+  if (myRecord) {
+    myGolden[header] = std::move(crcs);
+    cout << "recorded" << endl;
+
+    return true;
+  }
+
+  auto golden = myGolden.find(header);
+  if (golden == myGolden.end()) {
+    cout << "FAIL: no golden data for '" << header << "'" << endl;
+    return false;
+  }
+
+  for (uInt32 frame = 0; frame < crcs.size(); frame++) {
+    if (frame >= golden->second.size() || crcs[frame] != golden->second[frame]) {
+      cout << "FAIL: first mismatch in frame " << frame << endl
+           << "  expected: "
+           << (frame < golden->second.size() ? golden->second[frame] : "-") << endl
+           << "  actual:   " << crcs[frame] << endl;
+      return false;
+    }
+  }
+
+  cout << "PASS" << endl;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::loadGolden()
+{
+  ifstream in(myGoldenFile);
+  if (!in) {
+    cout << "ERROR: unable to read golden file " << myGoldenFile << endl;
+    return false;
+  }
+
+  // Each run starts with its header, followed by one line per frame
+  vector<string>* crcs = nullptr;
+  string line;
+
+  while (getline(in, line)) {
+    if (line == "" || line[0] == '#') continue;
+
+    if (BSPF::startsWithIgnoreCase(line, "rom "))
+      crcs = &myGolden[line];
+    else if (crcs)
+      crcs->push_back(line);
+    else {
+      cout << "ERROR: invalid golden file " << myGoldenFile << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::saveGolden() const
+{
+  ofstream out(myGoldenFile);
+  if (!out) {
+    cout << "ERROR: unable to write golden file " << myGoldenFile << endl;
+    return false;
+  }
+
+  out << "# Stella regression data: <frame> <video CRC> <audio CRC>" << endl;
+
+  for (const auto& golden : myGolden) {
+    out << golden.first << endl;
+    for (const string& crc : golden.second) out << crc << endl;
+  }
+
+  cout << endl << "wrote " << myGoldenFile << endl;
+
+  return bool(out);
+}
@@ -20,12 +20,35 @@
 
 class Control;
 class Switches;
+class TIA;
+class Event;
+class AudioQueue;
+class Thumbulator;
+
+#include <map>
 
 #include "bspf.hxx"
 #include "Settings.hxx"
 #include "ConsoleIO.hxx"
 #include "Props.hxx"
 
+/**
+  Runs ROMs for profiling, or checks them for regressions.
+
+  In regression mode ('-regress <golden>'), each ROM runs for a fixed number
+  of frames with a seeded random generator and optional scripted input (see
+  InputScript).  The CRCs of the frame buffer and of the audio generated
+  during each frame are compared against the golden file, or written to it
+  with '-record'.  This proves that an optimization is bit-exact.
+
+  When profiling, each ROM can run for several iterations ('-iterations'),
+  and the statistics can be written as JSON ('-json') or CSV ('-csv').  If
+  the core is built with SUBSYSTEM_TIMERS, the time is also split across the
+  subsystems (see SubsystemTimer).  With '-armprofile', the ARM code of
+  DPC+, CDF and BUS carts is profiled as well (see Thumbulator::Profile).
+  This prints a flat profile of its hottest functions, and the share of
+  each frame's host time that was spent in the ARM.
+*/
 class ProfilingRunner {
   public:
 
@@ -36,8 +59,30 @@ class ProfilingRunner {
   private:
 
     struct ProfilingRun {
+      string romFile;
+      uInt32 runtime;   // seconds, or frames in regression mode
+      string scriptFile;
+    };
+
+    struct Timing {
+      double seconds;
+
+      // Seconds spent in each subsystem; empty without SUBSYSTEM_TIMERS
+      vector<double> subsystems;
+    };
+
+    struct Statistics {
+      string name;
+      double min;
+      double median;
+      double stddev;
+      vector<double> samples;
+    };
+
+    struct Report {
       string romFile;
       uInt32 runtime;
+      vector<Statistics> statistics;
     };
 
     struct IO: public ConsoleIO {
@@ -54,10 +99,55 @@ class ProfilingRunner {
 
     bool runOne(const ProfilingRun run);
 
+    bool profile(const ProfilingRun& run, TIA& tia, Thumbulator* thumbulator,
+                 uInt64 cyclesTarget);
+
+    bool regress(const ProfilingRun& run, const string& md5, TIA& tia, IO& consoleIO,
+                 Event& event, AudioQueue& audioQueue);
+
+    void summarize(const ProfilingRun& run);
+
+    bool saveJson() const;
+
+    bool saveCsv() const;
+
+    bool loadGolden();
+
+    bool saveGolden() const;
+
   private:
 
     vector<ProfilingRun> profilingRuns;
 
+    bool myHeadless;
+
+    // Print an execution profile of the ARM code, if any
+    bool myArmProfile;
+
+    uInt32 myIterations;
+
+    // Report files for the statistics; empty if not requested
+    string myJsonFile;
+    string myCsvFile;
+
+    // The timings of the iterations of the current run
+    vector<Timing> myTimings;
+
+    vector<Report> myReports;
+
+    // The golden file for regression mode; empty when profiling
+    string myGoldenFile;
+
+    // Write the golden file instead of comparing against it
+    bool myRecord;
+
+    uInt32 mySeed;
+
+    // The frame CRCs of each run, keyed by a header that identifies the run
+    std::map<string, vector<string>> myGolden;
+
+    uInt32 myFailedRuns;
+
     Settings mySettings;
 
     Properties myProps;
@@ -69,6 +69,14 @@ void Properties::set(PropType key, const string& value)
         break;
       }
 
+      case PropType::Display_RunAhead:
+      {
+        int frames = atoi(myProperties[pos].c_str());
+        if(frames < 0 || frames > 4)
+          myProperties[pos] = ourDefaultProperties[pos];
+        break;
+      }
+
       default:
         break;
     }
@@ -255,7 +263,8 @@ void Properties::print() const
        << get(PropType::Display_Format)         << "|"
        << get(PropType::Display_YStart)         << "|"
        << get(PropType::Display_Phosphor)       << "|"
-       << get(PropType::Display_PPBlend)
+       << get(PropType::Display_PPBlend)        << "|"
+       << get(PropType::Display_RunAhead)
        << endl;
 }
 
@@ -300,7 +309,8 @@ void Properties::printHeader()
        << "Display_Format|"
        << "Display_YStart|"
        << "Display_Phosphor|"
-       << "Display_PPBlend"
+       << "Display_PPBlend|"
+       << "Display_RunAhead"
        << endl;
 }
 
@@ -327,7 +337,8 @@ string Properties::ourDefaultProperties[static_cast<uInt8>(PropType::NumTypes)]
   "AUTO",   // Display.Format
   "0",      // Display.YStart
   "NO",     // Display.Phosphor
-  "0"       // Display.PPBlend
+  "0",      // Display.PPBlend
+  "0"       // Display.RunAhead
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -353,5 +364,6 @@ const char* const Properties::ourPropertyNames[static_cast<uInt8>(PropType::NumT
   "Display.Format",
   "Display.YStart",
   "Display.Phosphor",
-  "Display.PPBlend"
+  "Display.PPBlend",
+  "Display.RunAhead"
 };
@@ -42,6 +42,7 @@ enum class PropType : uInt8 {
   Display_YStart,
   Display_Phosphor,
   Display_PPBlend,
+  Display_RunAhead,
   NumTypes
 };
 
@@ -88,6 +88,11 @@ class SaveKey : public Controller
     */
     string name() const override { return "SaveKey"; }
 
+    /**
+      The EEPROM contents and protocol state aren't part of the save state.
+    */
+    bool hasExternalState() const override { return true; }
+
     /**
       Notification method invoked by the system after its reset method has
       been called.  It may be necessary to override this method for
@@ -21,9 +21,18 @@
 using std::ios;
 using std::ios_base;
 
+namespace {
+  // Large enough for the state of most carts
+  constexpr size_t INITIAL_CAPACITY = 16 * 1024;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(const string& filename, bool readonly)
-  : myStream(nullptr)
+  : myStream(nullptr),
+    myInMemory(false),
+    myCapacity(0),
+    myReadPos(0),
+    myWritePos(0)
 {
   if(readonly)
   {
@@ -63,23 +72,25 @@ Serializer::Serializer(const string& filename, bool readonly)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer()
-  : myStream(nullptr)
+  : myStream(nullptr),
+    myInMemory(true),
+    myCapacity(0),
+    myReadPos(0),
+    myWritePos(0)
 {
-  myStream = make_unique<stringstream>(ios::in | ios::out | ios::binary);
-
-  // For some reason, Windows and possibly macOS needs to store something in
-  // the stream before it is used for the first time
-  if(myStream)
-  {
-    myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
-    putBool(true);
-    rewind();
-  }
+  reserve(INITIAL_CAPACITY);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::rewind()
 {
+  if(myInMemory)
+  {
+    myReadPos = myWritePos = 0;
+    myUnchangedSpans.clear();
+    return;
+  }
+
   myStream->clear();
   myStream->seekg(ios_base::beg);
   myStream->seekp(ios_base::beg);
@@ -88,14 +99,59 @@ void Serializer::rewind()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t Serializer::size() const
 {
-  return myStream->tellp();
+  return myInMemory ? myWritePos : size_t(myStream->tellp());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::reserve(size_t size)
+{
+  if(!myInMemory || size <= myCapacity)
+    return;
+
+  ByteBuffer buffer = make_unique<uInt8[]>(size);
+  if(myWritePos > 0)
+    memcpy(buffer.get(), myBuffer.get(), myWritePos);
+
+  myBuffer = std::move(buffer);
+  myCapacity = size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Serializer::read(void* dest, size_t size) const
+{
+  if(myInMemory)
+  {
+    // Reading past the end fails like an iostream with exceptions enabled
+    if(size > myWritePos - myReadPos)
+      throw runtime_error("Serializer: read past end of stream");
+
+    memcpy(dest, myBuffer.get() + myReadPos, size);
+    myReadPos += size;
+  }
+  else
+    myStream->read(static_cast<char*>(dest), size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Serializer::write(const void* src, size_t size)
+{
+  if(myInMemory)
+  {
+    if(myWritePos + size > myCapacity)
+      reserve(std::max(2 * myCapacity, myWritePos + size));
+
+    memcpy(myBuffer.get() + myWritePos, src, size);
+    myWritePos += size;
+  }
+  else
+    myStream->write(static_cast<const char*>(src), size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
   char buf;
-  myStream->read(&buf, 1);
+  read(&buf, 1);
 
   return buf;
 }
@@ -103,14 +159,14 @@ uInt8 Serializer::getByte() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getByteArray(uInt8* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), size);
+  read(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt16 Serializer::getShort() const
 {
   uInt16 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt16));
+  read(&val, sizeof(uInt16));
 
   return val;
 }
@@ -118,14 +174,14 @@ uInt16 Serializer::getShort() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getShortArray(uInt16* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt16)*size);
+  read(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Serializer::getInt() const
 {
   uInt32 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt32));
+  read(&val, sizeof(uInt32));
 
   return val;
 }
@@ -133,14 +189,14 @@ uInt32 Serializer::getInt() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getIntArray(uInt32* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt32)*size);
+  read(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 Serializer::getLong() const
 {
   uInt64 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt64));
+  read(&val, sizeof(uInt64));
 
   return val;
 }
@@ -149,7 +205,7 @@ uInt64 Serializer::getLong() const
 double Serializer::getDouble() const
 {
   double val = 0.0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(double));
+  read(&val, sizeof(double));
 
   return val;
 }
@@ -160,7 +216,7 @@ string Serializer::getString() const
   int len = getInt();
   string str;
   str.resize(len);
-  myStream->read(&str[0], len);
+  read(&str[0], len);
 
   return str;
 }
@@ -174,49 +230,64 @@ bool Serializer::getBool() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByte(uInt8 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), 1);
+  write(&value, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByteArray(const uInt8* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), size);
+  write(array, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::putUnchangedByteArray(const uInt8* array, uInt32 size)
+{
+  if(myInMemory && size > 0)
+  {
+    // Merge with a directly preceding span
+    if(!myUnchangedSpans.empty() && myUnchangedSpans.back().second == myWritePos)
+      myUnchangedSpans.back().second += size;
+    else
+      myUnchangedSpans.emplace_back(myWritePos, myWritePos + size);
+  }
+
+  write(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShort(uInt16 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt16));
+  write(&value, sizeof(uInt16));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShortArray(const uInt16* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt16)*size);
+  write(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(uInt32 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt32));
+  write(&value, sizeof(uInt32));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putIntArray(const uInt32* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt32)*size);
+  write(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putLong(uInt64 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt64));
+  write(&value, sizeof(uInt64));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putDouble(double value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(double));
+  write(&value, sizeof(double));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -224,7 +295,7 @@ void Serializer::putString(const string& str)
 {
   int len = int(str.length());
   putInt(len);
-  myStream->write(str.data(), len);
+  write(str.data(), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -23,7 +23,9 @@
 /**
   This class implements a Serializer device, whereby data is serialized and
   read from/written to a binary stream in a system-independent way.  The
-  stream can be either an actual file, or an in-memory structure.
+  stream can be either an actual file, or an in-memory structure.  The latter
+  is a contiguous, growable byte buffer (instead of an iostream), which makes
+  it cheap enough to serialize the complete system every frame.
 
   Bytes are written as characters, shorts as 2 characters (16-bits),
   integers as 4 characters (32-bits), long integers as 8 bytes (64-bits),
@@ -54,7 +56,7 @@ class Serializer
       Answers whether the serializer is currently initialized for reading
       and writing.
     */
-    explicit operator bool() const { return myStream != nullptr; }
+    explicit operator bool() const { return myStream != nullptr || myInMemory; }
 
     /**
       Resets the read/write location to the beginning of the stream.
@@ -66,6 +68,18 @@ class Serializer
     */
     size_t size() const;
 
+    /**
+      Preallocates an in-memory stream, so that up to the given number of
+      bytes can be written without reallocation.  Has no effect on files.
+    */
+    void reserve(size_t size);
+
+    /**
+      Direct access to the bytes of an in-memory stream; the first size()
+      bytes are valid.  Returns nullptr for files.
+    */
+    const uInt8* data() const { return myBuffer.get(); }
+
     /**
       Reads a byte value (unsigned 8-bit) from the current input stream.
 
@@ -154,6 +168,24 @@ class Serializer
     */
     void putByteArray(const uInt8* array, uInt32 size);
 
+    /**
+      Writes a byte array (unsigned 8-bit) which the caller knows to be
+      unchanged since the last keyframe of an incremental snapshot.  In-memory
+      streams additionally record the location of the array (see
+      unchangedSpans()); otherwise, this is the same as putByteArray().
+
+      @param array  The bytes to write
+      @param size   The size of the array (number of bytes to write)
+    */
+    void putUnchangedByteArray(const uInt8* array, uInt32 size);
+
+    /**
+      The locations (begin, end) of all arrays written with
+      putUnchangedByteArray() since the last rewind(), in ascending order.
+    */
+    using Span = std::pair<size_t, size_t>;
+    const vector<Span>& unchangedSpans() const { return myUnchangedSpans; }
+
     /**
       Writes a short value (unsigned 16-bit) to the current output stream.
 
@@ -213,9 +245,27 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
+    /**
+      Copy raw bytes from / to the current read / write location.
+    */
+    void read(void* dest, size_t size) const;
+    void write(const void* src, size_t size);
+
+  private:
+    // The stream to send the serialized data to (files only).
     unique_ptr<iostream> myStream;
 
+    // The in-memory stream, and the read and write locations within it.
+    // Like the get and put pointers of an iostream, both are independent.
+    bool myInMemory;
+    ByteBuffer myBuffer;
+    size_t myCapacity;
+    mutable size_t myReadPos;
+    size_t myWritePos;
+
+    // Locations of the unchanged arrays in the in-memory stream
+    vector<Span> myUnchangedSpans;
+
     static constexpr uInt8 TruePattern = 0xfe, FalsePattern = 0x01;
 
   private:
@@ -134,6 +134,7 @@ Settings::Settings()
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
   setPermanent("threads", "false");
+  setPermanent("threadcount", "0");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
 
@@ -315,6 +316,10 @@ void Settings::validate()
   if(i < 1 || i > 20)
     setValue("tsense", "10");
 
+  i = getInt("threadcount");
+  if(i < 0)        setValue("threadcount", "0");
+  else if(i > 64)  setValue("threadcount", "64");
+
   i = getInt("ssinterval");
   if(i < 1)        setValue("ssinterval", "2");
   else if(i > 10)  setValue("ssinterval", "10");
@@ -441,6 +446,8 @@ void Settings::usage() const
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
+    << "  -threadcount  <number>       Number of threads used for multi-threaded\n"
+    << "                                rendering (0 = autodetect)\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
     << "  -snaploaddir  <path>         The directory to load snapshot files from\n"
     << "  -snapname     <int|rom>      Name snapshots according to internal database or\n"
@@ -523,6 +530,7 @@ void Settings::usage() const
     << "   -height      <arg>          Sets the 'Display.Height' property\n"
     << "   -pp          <arg>          Sets the 'Display.Phosphor' property\n"
     << "   -ppblend     <arg>          Sets the 'Display.PPBlend' property\n"
+    << "   -runahead    <arg>          Sets the 'Display.RunAhead' property\n"
     << endl
   #endif
 
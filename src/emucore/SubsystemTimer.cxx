@@ -0,0 +1,60 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "SubsystemTimer.hxx"
+
+#ifdef SUBSYSTEM_TIMERS
+
+uInt64 SubsystemTimer::ourTicks[SubsystemTimer::numSubsystems] = { 0 };
+uInt64 SubsystemTimer::ourLastTicks = 0;
+SubsystemTimer::Subsystem SubsystemTimer::ourCurrent = SubsystemTimer::Subsystem::other;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SubsystemTimer::start()
+{
+  for (uInt64& t: ourTicks) t = 0;
+
+  ourCurrent = Subsystem::other;
+  ourLastTicks = ticks();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SubsystemTimer::stop()
+{
+  enter(Subsystem::other);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double SubsystemTimer::share(Subsystem subsystem)
+{
+  uInt64 total = 0;
+  for (uInt64 t: ourTicks) total += t;
+
+  return total > 0 ? double(ourTicks[static_cast<uInt32>(subsystem)]) / total : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* SubsystemTimer::name(Subsystem subsystem)
+{
+  static constexpr const char* names[numSubsystems] = {
+    "other", "cpu", "tia", "audio", "arm", "render"
+  };
+
+  return names[static_cast<uInt32>(subsystem)];
+}
+
+#endif // SUBSYSTEM_TIMERS
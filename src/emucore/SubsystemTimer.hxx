@@ -0,0 +1,167 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SUBSYSTEM_TIMER_HXX
+#define SUBSYSTEM_TIMER_HXX
+
+#include "bspf.hxx"
+
+/**
+  Splits the host time spent in the emulation core across its subsystems.
+
+  Code marks the subsystem it belongs to with PROFILE_SUBSYSTEM(name).  Time
+  is always charged to the innermost subsystem, so e.g. TIA clocking
+  triggered by a CPU write does not count as CPU time.  The timers read the
+  CPU cycle counter where available, and are only used by the profiling
+  runner.
+
+  Each subsystem covers the following:
+    cpu     6502 execution, including accesses to the cartridge and RIOT
+    tia     clocking the TIA objects and latching collisions whenever the
+            TIA catches up with the CPU
+    audio   catching up the audio channels and generating the samples,
+            once per TIA catch-up
+    arm     ARM execution, from entering the Thumbulator until it returns
+    render  writing pixels to the frame buffer (compositing segments,
+            including their collisions, and cloning lines) and publishing
+            finished frames
+    other   everything else, e.g. the frame loop and event handling
+
+  Entering a subsystem reads the timer twice, so subsystems entered very
+  often appear somewhat more expensive than they are.
+
+  The timers are compiled in with SUBSYSTEM_TIMERS only, and cost nothing
+  otherwise.  They are not thread safe; only a single console may run while
+  they are active.
+*/
+#ifdef SUBSYSTEM_TIMERS
+  #define PROFILE_SUBSYSTEM(subsystem) \
+    SubsystemTimer::Scope subsystemTimerScope(SubsystemTimer::Subsystem::subsystem)
+#else
+  #define PROFILE_SUBSYSTEM(subsystem)
+#endif
+
+#ifdef SUBSYSTEM_TIMERS
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+  #define SUBSYSTEM_TIMER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define SUBSYSTEM_TIMER_RDTSC
+#else
+  #include <chrono>
+#endif
+
+class SubsystemTimer
+{
+  public:
+    enum class Subsystem: uInt8 {
+      other,      // anything not covered by a more specific subsystem
+      cpu,        // 6502 execution
+      tia,        // TIA clocking
+      audio,      // audio synthesis
+      arm,        // ARM (Thumbulator) execution
+      render,     // drawing pixels and publishing frames
+      numSubsystems
+    };
+
+    static constexpr uInt32 numSubsystems = static_cast<uInt32>(Subsystem::numSubsystems);
+
+    class Scope {
+      public:
+        explicit Scope(Subsystem subsystem) : myPrevious(enter(subsystem)) { }
+        ~Scope() { enter(myPrevious); }
+
+      private:
+        Subsystem myPrevious;
+
+      private:
+        // Following constructors and assignment operators not supported
+        Scope() = delete;
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+    };
+
+  public:
+    /**
+      Clear all timers and start charging time to 'other'.
+    */
+    static void start();
+
+    /**
+      Charge the time since the last switch, and stop.
+    */
+    static void stop();
+
+    /**
+      The share (0..1) of the time between start() and stop() that was spent
+      in the given subsystem.
+    */
+    static double share(Subsystem subsystem);
+
+    static const char* name(Subsystem subsystem);
+
+  private:
+    static uInt64 ticks()
+    {
+    #ifdef SUBSYSTEM_TIMER_RDTSC
+      return __rdtsc();
+    #else
+      return std::chrono::steady_clock::now().time_since_epoch().count();
+    #endif
+    }
+
+    /**
+      Charge the time since the last switch to the current subsystem, and
+      switch to the given one.
+
+      @return  The previous subsystem
+    */
+    static Subsystem enter(Subsystem subsystem)
+    {
+      const uInt64 now = ticks();
+      const Subsystem previous = ourCurrent;
+
+      ourTicks[static_cast<uInt32>(previous)] += now - ourLastTicks;
+      ourLastTicks = now;
+      ourCurrent = subsystem;
+
+      return previous;
+    }
+
+  private:
+    static uInt64 ourTicks[numSubsystems];
+
+    static uInt64 ourLastTicks;
+
+    static Subsystem ourCurrent;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SubsystemTimer() = delete;
+    SubsystemTimer(const SubsystemTimer&) = delete;
+    SubsystemTimer(SubsystemTimer&&) = delete;
+    SubsystemTimer& operator=(const SubsystemTimer&) = delete;
+    SubsystemTimer& operator=(SubsystemTimer&&) = delete;
+};
+
+#endif // SUBSYSTEM_TIMERS
+
+#endif
@@ -317,6 +317,18 @@ class System : public Serializable
       myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT] = access;
     }
 
+    /**
+      Set the page accessing methods for a run of consecutive pages.
+
+      @param addr     The address of the first page
+      @param accesses The accessing methods to be used by the pages
+      @param pages    The number of pages
+    */
+    void setPageAccesses(uInt16 addr, const PageAccess* accesses, uInt16 pages) {
+      std::copy_n(accesses, pages,
+                  &myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT]);
+    }
+
     /**
       Get the page accessing method for the specified address.
 
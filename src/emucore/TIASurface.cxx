@@ -35,7 +35,10 @@ TIASurface::TIASurface(OSystem& system)
     myPhosphorPercent(0.60f),
     myScanlinesEnabled(false),
     myPalette(nullptr),
-    mySaveSnapFlag(false)
+    mySaveSnapFlag(false),
+    myRenderedFrameSerial(0),
+    myRenderedWidth(0),
+    myRenderedHeight(0)
 {
   // Load NTSC filter settings
   myNTSCFilter.loadConfig(myOSystem.settings());
@@ -59,9 +62,11 @@ TIASurface::TIASurface(OSystem& system)
                                           TIAConstants::frameBufferHeight);
 
   memset(myRGBFramebuffer, 0, sizeof(myRGBFramebuffer));
+  memset(myPhosphorLineActive, 0, sizeof(myPhosphorLineActive));
 
   // Enable/disable threading in the NTSC TV effects renderer
-  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"));
+  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"),
+                               myOSystem.settings().getInt("threadcount"));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -69,6 +74,7 @@ void TIASurface::initialize(const Console& console,
                             const FrameBuffer::VideoMode& mode)
 {
   myTIA = &(console.tia());
+  myRenderedFrameSerial = 0;
 
   myTiaSurface->setDstPos(mode.image.x(), mode.image.y());
   myTiaSurface->setDstSize(mode.image.width(), mode.image.height());
@@ -117,6 +123,7 @@ cerr << "SLine:\n"
 void TIASurface::setPalette(const uInt32* tia_palette, const uInt32* rgb_palette)
 {
   myPalette = tia_palette;
+  myRenderedFrameSerial = 0;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -221,6 +228,7 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   myFilter = Filter(enable ? uInt8(myFilter) | 0x01 : uInt8(myFilter) & 0x10);
 
   memset(myRGBFramebuffer, 0, sizeof(myRGBFramebuffer));
+  myRenderedFrameSerial = 0;
 
   // Precalculate the average colors for the 'phosphor' effect
   if(myUsePhosphor)
@@ -271,6 +279,7 @@ void TIASurface::enableNTSC(bool enable)
   mySLineSurface->applyAttributes();
 
   memset(myRGBFramebuffer, 0, sizeof(myRGBFramebuffer));
+  myRenderedFrameSerial = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -327,6 +336,16 @@ void TIASurface::render()
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
 
+  // In normal and phosphor mode, only the lines that changed are converted
+  // and transferred to the screen
+  if(width != myRenderedWidth || height != myRenderedHeight)
+  {
+    myRenderedWidth = width;
+    myRenderedHeight = height;
+    myRenderedFrameSerial = 0;
+  }
+  myTiaSurface->trackDirtyRows(!ntscEnabled());
+
   switch(myFilter)
   {
     case Filter::Normal:
@@ -334,15 +353,18 @@ void TIASurface::render()
       uInt8* tiaIn = myTIA->frameBuffer();
 
       uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = 0; y < height; ++y)
+      for(uInt32 y = 0; y < height; ++y, bufofs += width, screenofsY += outPitch)
       {
+        if(!myTIA->lineChangedSince(y, myRenderedFrameSerial))
+          continue;
+
         pos = screenofsY;
-        for (uInt32 x = width / 2; x; --x)
+        for (uInt32 x = 0; x < width; x += 2)
         {
-          out[pos++] = myPalette[tiaIn[bufofs++]];
-          out[pos++] = myPalette[tiaIn[bufofs++]];
+          out[pos++] = myPalette[tiaIn[bufofs + x]];
+          out[pos++] = myPalette[tiaIn[bufofs + x + 1]];
         }
-        screenofsY += outPitch;
+        myTiaSurface->markDirtyRows(y, 1);
       }
       break;
     }
@@ -356,18 +378,31 @@ void TIASurface::render()
         memcpy(myPrevRGBFramebuffer, myRGBFramebuffer, width * height * sizeof(uInt32));
 
       uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = height; y ; --y)
+      for(uInt32 y = 0; y < height; ++y, screenofsY += outPitch)
       {
+        // Unchanged lines must be blended until they have fully decayed
+        if(!myTIA->lineChangedSince(y, myRenderedFrameSerial) && !myPhosphorLineActive[y])
+        {
+          bufofs += width;
+          continue;
+        }
+
+        bool active = false;
         pos = screenofsY;
         for(uInt32 x = width / 2; x ; --x)
         {
           // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
+          uInt32 c = myPalette[tiaIn[bufofs]];
+          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(c, rgbIn[bufofs]);
+          active = active || rgbIn[bufofs] != c;
           ++bufofs;
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
+          c = myPalette[tiaIn[bufofs]];
+          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(c, rgbIn[bufofs]);
+          active = active || rgbIn[bufofs] != c;
           ++bufofs;
         }
-        screenofsY += outPitch;
+        myPhosphorLineActive[y] = active;
+        myTiaSurface->markDirtyRows(y, 1);
       }
       break;
     }
@@ -388,6 +423,8 @@ void TIASurface::render()
     }
   }
 
+  myRenderedFrameSerial = myTIA->frameSerial();
+
   // Draw TIA image
   myTiaSurface->render();
 
@@ -456,6 +493,10 @@ void TIASurface::renderForSnapshot()
 
   if(myUsePhosphor)
   {
+    // The surface no longer holds the phosphor image
+    myRenderedFrameSerial = 0;
+    myTiaSurface->markDirtyRows(0, height);
+
     // Draw TIA image
     myTiaSurface->render();
 
@@ -209,6 +209,16 @@ class TIASurface
     // Flag for saving a snapshot
     bool mySaveSnapFlag;
 
+    // Serial number and dimensions of the last TIA frame rendered to the
+    // surface; only lines that changed since are converted again (a serial
+    // number of zero forces all lines to be converted)
+    uInt64 myRenderedFrameSerial;
+    uInt32 myRenderedWidth, myRenderedHeight;
+
+    // Lines in phosphor mode that haven't fully decayed yet, and hence have
+    // to be converted even if they are unchanged
+    bool myPhosphorLineActive[TIAConstants::frameBufferHeight];
+
   private:
     // Following constructors and assignment operators not supported
     TIASurface() = delete;
@@ -22,10 +22,15 @@
 // Code is public domain and used with the author's consent
 //============================================================================
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
 #include "bspf.hxx"
 #include "Base.hxx"
 #include "Cart.hxx"
 #include "Thumbulator.hxx"
+#include "SubsystemTimer.hxx"
 using Common::Base;
 
 // Uncomment the following to enable specific functionality
@@ -52,13 +57,38 @@ using Common::Base;
   #define CONV_RAMROM(d) (d)
 #endif
 
+// With GCC and clang, the instructions can be dispatched through a table of
+// label addresses instead of a switch statement, the same way as in the
+// M6502 class.  Each handler then fetches and dispatches the next
+// instruction itself.
+#if defined(THREADED_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+  #define THUMB_THREADED_DISPATCH
+#endif
+
+#ifdef THUMB_THREADED_DISPATCH
+  // Labels as values are a GNU extension
+  #pragma GCC diagnostic ignored "-Wpedantic"
+
+  #define INSTRUCTION(_op) op_##_op:
+  #define NEXT_INSTRUCTION \
+    { \
+      ins = fetchInstruction(pc - 2, decoded); \
+      if(profiled) profileInstruction(pc - 2, *ins); \
+      pc += 2; \
+      goto *ourInstructionHandlers[int(ins->op)]; \
+    }
+#else
+  #define INSTRUCTION(_op) case Op::_op:
+  #define NEXT_INSTRUCTION continue;
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size,
                          bool traponfatal, Thumbulator::ConfigureFor configurefor,
                          Cartridge* cartridge)
   : rom(rom_ptr),
     romSize(rom_size),
-    decodedRom(new Op[romSize / 2]),
+    decodedRom(new Instruction[romSize / 2]),
     ram(ram_ptr),
     T1TCR(0),
     T1TC(0),
@@ -66,8 +96,9 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size
     myCartridge(cartridge)
 {
   for(uInt16 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]));
+    decodedRom[i] = decodeInstruction(CONV_RAMROM(rom[i]));
 
+  setupMemoryRegions();
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
   trapFatalErrors(traponfatal);
@@ -75,18 +106,49 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size
   reset();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::setupMemoryRegions()
+{
+  // Everything not listed below is accessed through the slow path
+  std::fill_n(memoryRegions, 16, MemoryRegion{nullptr, nullptr, 0, 0, 0});
+
+#ifndef UNSAFE_OPTIMIZATIONS
+  // Writes to the driver area (and any RAM below it) are left to the slow
+  // path, which checks them with isProtected()
+  uInt32 writeStart = RAMSIZE;
+  while(writeStart > 0 && !isProtected(0x40000000 + writeStart - 2))
+    writeStart -= 2;
+#else
+  const uInt32 writeStart = 0;
+#endif
+
+  // The first 0x50 bytes of ROM can't be executed
+  memoryRegions[0x0] = { rom, nullptr, 0x50, ROMSIZE, ROMSIZE };
+  memoryRegions[0x4] = { ram, ram, 0, RAMSIZE, writeStart };
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Thumbulator::run()
 {
+  PROFILE_SUBSYSTEM(arm);
+
   reset();
-  for(;;)
+#ifndef NO_THUMB_STATS
+  if(profileData)
   {
-    if(execute()) break;
-#ifndef UNSAFE_OPTIMIZATIONS
-    if(instructions > 500000) // way more than would otherwise be possible
-      throw runtime_error("instructions > 500000");
-#endif
+    const auto start = std::chrono::steady_clock::now();
+
+    ++profileData->runs;
+    profileData->lastIndex = Profile::entries - 1;
+    profileData->callPending = true;
+    execute<true>();
+
+    profileData->seconds += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
   }
+  else
+#endif
+    execute<false>();
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
@@ -113,6 +175,17 @@ void Thumbulator::setConsoleTiming(ConsoleTiming timing)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::enableProfiling(bool enable)
+{
+#ifndef NO_THUMB_STATS
+  if(enable)
+    profileData = make_unique<Profile>();
+  else
+    profileData.reset();
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::updateTimer(uInt32 cycles)
 {
@@ -179,7 +252,104 @@ void Thumbulator::dump_regs()
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::fetch16(uInt32 addr)
+inline uInt32 Thumbulator::fetch16(uInt32 addr)
+{
+  const MemoryRegion& region = memoryRegions[addr >> 28];
+  const uInt32 offset = addr & 0x0FFFFFFF;
+
+  if(offset >= region.fetchStart && offset < region.readEnd)
+  {
+  #ifndef NO_THUMB_STATS
+    ++fetches;
+  #endif
+    const uInt32 data = CONV_RAMROM(region.data[offset >> 1]);
+    DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << endl);
+    return data;
+  }
+
+  return fetch16Slow(addr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 Thumbulator::read16(uInt32 addr)
+{
+  const MemoryRegion& region = memoryRegions[addr >> 28];
+  const uInt32 offset = addr & 0x0FFFFFFF;
+
+  if(offset < region.readEnd && (addr & 1) == 0)
+  {
+  #ifndef NO_THUMB_STATS
+    ++reads;
+  #endif
+    const uInt32 data = CONV_RAMROM(region.data[offset >> 1]);
+    DO_DBUG(statusMsg << "read16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << endl);
+    return data;
+  }
+
+  return read16Slow(addr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 Thumbulator::read32(uInt32 addr)
+{
+  const MemoryRegion& region = memoryRegions[addr >> 28];
+  const uInt32 offset = addr & 0x0FFFFFFF;
+
+  if(offset < region.readEnd && (addr & 3) == 0)
+  {
+  #ifndef NO_THUMB_STATS
+    reads += 2;
+  #endif
+    const uInt32 data = CONV_RAMROM(region.data[offset >> 1]) |
+                        (uInt32(CONV_RAMROM(region.data[(offset >> 1) + 1])) << 16);
+    DO_DBUG(statusMsg << "read32(" << Base::HEX8 << addr << ")=" << Base::HEX8 << data << endl);
+    return data;
+  }
+
+  return read32Slow(addr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Thumbulator::write16(uInt32 addr, uInt32 data)
+{
+  const MemoryRegion& region = memoryRegions[addr >> 28];
+  const uInt32 offset = addr & 0x0FFFFFFF;
+
+  if(offset >= region.writeStart && offset < region.readEnd && (addr & 1) == 0)
+  {
+  #ifndef NO_THUMB_STATS
+    ++writes;
+  #endif
+    DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
+    region.writableData[offset >> 1] = CONV_DATA(data);
+    return;
+  }
+
+  write16Slow(addr, data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Thumbulator::write32(uInt32 addr, uInt32 data)
+{
+  const MemoryRegion& region = memoryRegions[addr >> 28];
+  const uInt32 offset = addr & 0x0FFFFFFF;
+
+  if(offset >= region.writeStart && offset < region.readEnd && (addr & 3) == 0)
+  {
+  #ifndef NO_THUMB_STATS
+    writes += 2;
+  #endif
+    DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
+    region.writableData[offset >> 1] = CONV_DATA(data);
+    region.writableData[(offset >> 1) + 1] = CONV_DATA(data >> 16);
+    return;
+  }
+
+  write32Slow(addr, data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::fetch16Slow(uInt32 addr)
 {
 #ifndef NO_THUMB_STATS
   ++fetches;
@@ -214,7 +384,7 @@ uInt32 Thumbulator::fetch16(uInt32 addr)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::write16(uInt32 addr, uInt32 data)
+void Thumbulator::write16Slow(uInt32 addr, uInt32 data)
 {
 #ifndef UNSAFE_OPTIMIZATIONS
   if((addr > 0x40001fff) && (addr < 0x50000000))
@@ -257,7 +427,7 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::write32(uInt32 addr, uInt32 data)
+void Thumbulator::write32Slow(uInt32 addr, uInt32 data)
 {
 #ifndef UNSAFE_OPTIMIZATIONS
   if(addr & 3)
@@ -381,7 +551,7 @@ bool Thumbulator::isProtected(uInt32 addr)
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::read16(uInt32 addr)
+uInt32 Thumbulator::read16Slow(uInt32 addr)
 {
   uInt32 data;
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -429,7 +599,7 @@ uInt32 Thumbulator::read16(uInt32 addr)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::read32(uInt32 addr)
+uInt32 Thumbulator::read32Slow(uInt32 addr)
 {
 #ifndef UNSAFE_OPTIMIZATIONS
   if(addr & 3)
@@ -522,59 +692,6 @@ void Thumbulator::write_register(uInt32 reg, uInt32 data)
   reg_norm[reg] = data;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_zflag(uInt32 x)
-{
-  if(x == 0) cpsr |= CPSR_Z;  else cpsr &= ~CPSR_Z;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_nflag(uInt32 x)
-{
-  if(x & 0x80000000) cpsr |= CPSR_N;  else cpsr &= ~CPSR_N;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_cflag(uInt32 a, uInt32 b, uInt32 c)
-{
-  uInt32 rc;
-
-  rc = (a & 0x7FFFFFFF) + (b & 0x7FFFFFFF) + c; //carry in
-  rc = (rc >> 31) + (a >> 31) + (b >> 31);      //carry out
-  if(rc & 2)
-    cpsr |= CPSR_C;
-  else
-    cpsr &= ~CPSR_C;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_vflag(uInt32 a, uInt32 b, uInt32 c)
-{
-  uInt32 rc, rd;
-
-  rc = (a & 0x7FFFFFFF) + (b & 0x7FFFFFFF) + c; //carry in
-  rc >>= 31; //carry in in lsbit
-  rd = (rc & 1) + ((a >> 31) & 1) + ((b >> 31) & 1); //carry out
-  rd >>= 1; //carry out in lsbit
-  rc = (rc^rd) & 1; //if carry in != carry out then signed overflow
-  if(rc)
-    cpsr |= CPSR_V;
-  else
-    cpsr &= ~CPSR_V;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_cflag_bit(uInt32 x)
-{
-  if(x) cpsr |= CPSR_C;  else cpsr &= ~CPSR_C;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::do_vflag_bit(uInt32 x)
-{
-  if(x) cpsr |= CPSR_V;  else cpsr &= ~CPSR_V;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst) {
   //ADC
@@ -800,1713 +917,1564 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Thumbulator::execute()
+Thumbulator::Instruction Thumbulator::decodeInstruction(uInt16 inst)
 {
-  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
+  Instruction decoded;
 
-  pc = read_register(15);
+  decoded.op = decodeInstructionWord(inst);
+  decoded.rd = decoded.rn = decoded.rm = 0;
+  decoded.imm = 0;
 
-  uInt32 instructionPtr = pc - 2;
-  inst = fetch16(instructionPtr);
+  switch(decoded.op)
+  {
+    // two low registers: rd, rm
+    case Op::adc:  case Op::and_: case Op::asr2: case Op::bic:
+    case Op::cpy:  case Op::eor:  case Op::lsl2: case Op::lsr2:
+    case Op::mul:  case Op::mvn:  case Op::neg:  case Op::orr:
+    case Op::ror:  case Op::sbc:  case Op::sxtb: case Op::sxth:
+    case Op::uxtb: case Op::uxth:
+      decoded.rd = inst & 0x7;
+      decoded.rm = (inst >> 3) & 0x7;
+      break;
 
-  pc += 2;
-  write_register(15, pc);
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
+    // two low registers: rn, rm
+    case Op::cmn: case Op::cmp2: case Op::tst:
+      decoded.rn = inst & 0x7;
+      decoded.rm = (inst >> 3) & 0x7;
+      break;
 
-#ifndef UNSAFE_OPTIMIZATIONS
-  ++instructions;
-#endif
+    // two low registers: rd, rn
+    case Op::mov2: case Op::rev: case Op::rev16: case Op::revsh:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      break;
 
-  Op decodedOp;
-#ifndef UNSAFE_OPTIMIZATIONS
-  if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
-    decodedOp = decodedRom[instructionPtr >> 1];
-  else
-    decodedOp = decodeInstructionWord(inst);
-#else
-  decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
-#endif
+    // three low registers: rd, rn, rm
+    case Op::add3:  case Op::sub3:  case Op::ldr2:  case Op::ldrb2:
+    case Op::ldrh2: case Op::ldrsb: case Op::ldrsh: case Op::str2:
+    case Op::strb2: case Op::strh2:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      decoded.rm = (inst >> 6) & 0x7;
+      break;
 
-  switch (decodedOp) {
-    //ADC
-    case Op::adc: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra + rb;
-      if(cpsr & CPSR_C)
-        ++rc;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
-      else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
-      return 0;
-    }
+    // two low registers and a small immediate: rd, rn, #imm
+    case Op::add1: case Op::sub1:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      decoded.imm = (inst >> 6) & 0x7;
+      break;
 
-    //ADD(1) small immediate two registers
-    case Op::add1: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rb = (inst >> 6) & 0x7;
-      if(rb)
-      {
-        DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
-                          << "#0x" << Base::HEX2 << rb << endl);
-        ra = read_register(rn);
-        rc = ra + rb;
-        //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-        write_register(rd, rc);
-        do_nflag(rc);
-        do_zflag(rc);
-        do_cflag(ra, rb, 0);
-        do_vflag(ra, rb, 0);
-        return 0;
-      }
-      else
-      {
-        //this is a mov
-      }
+    // shift by immediate: rd, rm, #imm
+    case Op::asr1: case Op::lsl1: case Op::lsr1:
+      decoded.rd = inst & 0x7;
+      decoded.rm = (inst >> 3) & 0x7;
+      decoded.imm = (inst >> 6) & 0x1F;
+      break;
 
+    // load/store with offset: rd, [rn, #imm]
+    case Op::ldr1: case Op::str1:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      decoded.imm = ((inst >> 6) & 0x1F) << 2;
       break;
-    }
 
-    //ADD(2) big immediate one register
-    case Op::add2: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
-      DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rd);
-      rc = ra + rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
-      return 0;
-    }
+    case Op::ldrh1: case Op::strh1:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      decoded.imm = ((inst >> 6) & 0x1F) << 1;
+      break;
 
-    //ADD(3) three registers
-    case Op::add3: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra + rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
-      return 0;
-    }
+    case Op::ldrb1: case Op::strb1:
+      decoded.rd = inst & 0x7;
+      decoded.rn = (inst >> 3) & 0x7;
+      decoded.imm = (inst >> 6) & 0x1F;
+      break;
 
-    //ADD(4) two registers one or both high no flags
-    case Op::add4: {
-      if((inst >> 6) & 3)
-      {
-        //UNPREDICTABLE
-      }
-      rd  = (inst >> 0) & 0x7;
-      rd |= (inst >> 4) & 0x8;
-      rm  = (inst >> 3) & 0xF;
-      DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra + rb;
-      if(rd == 15)
-      {
-#ifndef UNSAFE_OPTIMIZATIONS
-        if((rc & 1) == 0)
-          fatalError("add pc", pc, rc, " produced an arm address");
-#endif
-        //rc &= ~1; //write_register may do this as well
-        rc += 2;  //The program counter is special
-      }
-      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-      write_register(rd, rc);
-      return 0;
-    }
+    // one low register and a big immediate: rd, #imm
+    case Op::add2: case Op::mov1: case Op::sub2:
+      decoded.rd = (inst >> 8) & 0x7;
+      decoded.imm = inst & 0xFF;
+      break;
 
-    //ADD(5) rd = pc plus immediate
-    case Op::add5: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
-      rb <<= 2;
-      DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(15);
-      rc = (ra & (~3u)) + rb;
-      write_register(rd, rc);
-      return 0;
-    }
+    case Op::cmp1:
+      decoded.rn = (inst >> 8) & 0x7;
+      decoded.imm = inst & 0xFF;
+      break;
 
-    //ADD(6) rd = sp plus immediate
-    case Op::add6: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
-      rb <<= 2;
-      DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(13);
-      rc = ra + rb;
-      write_register(rd, rc);
-      return 0;
-    }
+    // relative to PC or SP: rd, #imm
+    case Op::add5: case Op::add6: case Op::ldr3: case Op::ldr4:
+    case Op::str3:
+      decoded.rd = (inst >> 8) & 0x7;
+      decoded.imm = (inst & 0xFF) << 2;
+      break;
 
-    //ADD(7) sp plus immediate
-    case Op::add7: {
-      rb = (inst >> 0) & 0x7F;
-      rb <<= 2;
-      DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(13);
-      rc = ra + rb;
-      write_register(13, rc);
-      return 0;
-    }
+    case Op::add7: case Op::sub4:
+      decoded.imm = (inst & 0x7F) << 2;
+      break;
 
-    //AND
-    case Op::and_: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra & rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+    // high registers
+    case Op::add4: case Op::mov3:
+      decoded.rd = (inst & 0x7) | ((inst >> 4) & 0x8);
+      decoded.rm = (inst >> 3) & 0xF;
+      break;
 
-    //ASR(1) two register immediate
-    case Op::asr1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-      rc = read_register(rm);
-      if(rb == 0)
-      {
-        if(rc & 0x80000000)
-        {
-          do_cflag_bit(1);
-          rc = ~0u;
-        }
-        else
-        {
-          do_cflag_bit(0);
-          rc = 0;
-        }
-      }
-      else
-      {
-        do_cflag_bit(rc & (1 << (rb-1)));
-        ra = rc & 0x80000000;
-        rc >>= rb;
-        if(ra) //asr, sign is shifted in
-          rc |= (~0u) << (32-rb);
-      }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+    case Op::cmp3:
+      decoded.rn = (inst & 0x7) | ((inst >> 4) & 0x8);
+      decoded.rm = (inst >> 3) & 0xF;
+      break;
 
-    //ASR(2) two register
-    case Op::asr2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
-      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
-      rc = read_register(rd);
-      rb = read_register(rs);
-      rb &= 0xFF;
-      if(rb == 0)
-      {
-      }
-      else if(rb < 32)
+    case Op::blx2: case Op::bx:
+      decoded.rm = (inst >> 3) & 0xF;
+      break;
+
+    // branches: the offset is relative to the PC, which is 4 bytes ahead of
+    // the instruction, and includes the 2 bytes the PC register is ahead of
+    // the next instruction
+    case Op::b1:
+      decoded.rd = (inst >> 8) & 0xF;  // condition
+      if(decoded.rd >= 0xE)
+      {
+        // undefined instruction or swi
+        decoded.op = Op::invalid;
+        decoded.rd = 0;
+        decoded.imm = inst;
+        break;
+      }
+      decoded.imm = inst & 0xFF;
+      if(decoded.imm & 0x80)
+        decoded.imm |= (~0u) << 8;
+      decoded.imm = (decoded.imm << 1) + 2;
+      break;
+
+    case Op::b2:
+      decoded.imm = inst & 0x7FF;
+      if(decoded.imm & (1 << 10))
+        decoded.imm |= (~0u) << 11;
+      decoded.imm = (decoded.imm << 1) + 2;
+      break;
+
+    case Op::blx1:
+      decoded.rd = (inst >> 11) & 0x3;  // H
+      decoded.imm = inst & 0x7FF;
+      if(decoded.rd == 0x2)
       {
-        do_cflag_bit(rc & (1 << (rb-1)));
-        ra = rc & 0x80000000;
-        rc >>= rb;
-        if(ra) //asr, sign is shifted in
-        {
-          rc |= (~0u) << (32-rb);
-        }
+        if(decoded.imm & (1 << 10))
+          decoded.imm |= (~0u) << 11;
+        decoded.imm <<= 12;
       }
+      else if(decoded.rd == 0x3)
+        decoded.imm = (decoded.imm << 1) + 2;
       else
-      {
-        if(rc & 0x80000000)
-        {
-          do_cflag_bit(1);
-          rc = (~0u);
-        }
-        else
-        {
-          do_cflag_bit(0);
-          rc = 0;
-        }
-      }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+        decoded.imm <<= 1;
+      break;
 
-    //B(1) conditional branch
-    case Op::b1: {
-      rb = (inst >> 0) & 0xFF;
-      if(rb & 0x80)
-        rb |= (~0u) << 8;
-      op=(inst >> 8) & 0xF;
-      rb <<= 1;
-      rb += pc;
-      rb += 2;
-      switch(op)
-      {
-        case 0x0: //b eq  z set
-          DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
-          if(cpsr & CPSR_Z)
-            write_register(15, rb);
-          return 0;
-
-        case 0x1: //b ne  z clear
-          DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
-          if(!(cpsr & CPSR_Z))
-            write_register(15, rb);
-          return 0;
-
-        case 0x2: //b cs c set
-          DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
-          if(cpsr & CPSR_C)
-            write_register(15, rb);
-          return 0;
-
-        case 0x3: //b cc c clear
-          DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
-          if(!(cpsr & CPSR_C))
-            write_register(15, rb);
-          return 0;
-
-        case 0x4: //b mi n set
-          DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
-          if(cpsr & CPSR_N)
-            write_register(15, rb);
-          return 0;
-
-        case 0x5: //b pl n clear
-          DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
-          if(!(cpsr & CPSR_N))
-            write_register(15, rb);
-          return 0;
-
-        case 0x6: //b vs v set
-          DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
-          if(cpsr & CPSR_V)
-            write_register(15,rb);
-          return 0;
-
-        case 0x7: //b vc v clear
-          DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
-          if(!(cpsr & CPSR_V))
-            write_register(15, rb);
-          return 0;
-
-        case 0x8: //b hi c set z clear
-          DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
-          if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
-            write_register(15, rb);
-          return 0;
-
-        case 0x9: //b ls c clear or z set
-          DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
-          if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
-            write_register(15, rb);
-          return 0;
-
-        case 0xA: //b ge N == V
-          DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
-          if(((cpsr & CPSR_N) && (cpsr & CPSR_V)) ||
-             ((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))))
-            write_register(15, rb);
-          return 0;
-
-        case 0xB: //b lt N != V
-          DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
-          if((!(cpsr & CPSR_N) && (cpsr & CPSR_V)) ||
-            (((cpsr & CPSR_N)) && !(cpsr & CPSR_V)))
-            write_register(15, rb);
-          return 0;
-
-        case 0xC: //b gt Z==0 and N == V
-          DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
-          if(!(cpsr & CPSR_Z))
-          {
-            if(((cpsr & CPSR_N) && (cpsr & CPSR_V)) ||
-               ((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))))
-              write_register(15, rb);
-          }
-          return 0;
-
-        case 0xD: //b le Z==1 or N != V
-          DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
-          if((cpsr & CPSR_Z) ||
-            (!(cpsr & CPSR_N) && (cpsr & CPSR_V)) ||
-            (((cpsr & CPSR_N)) && !(cpsr & CPSR_V)))
-              write_register(15, rb);
-          return 0;
-
-        case 0xE:
-          //undefined instruction
-          break;
+    // register lists
+    case Op::ldmia: case Op::stmia:
+      decoded.rn = (inst >> 8) & 0x7;
+      decoded.imm = inst & 0xFF;
+      break;
 
-        case 0xF:
-          //swi
-          break;
-      }
+    case Op::pop: case Op::push:
+      decoded.imm = inst & 0x1FF;
+      break;
 
+    case Op::bkpt: case Op::swi:
+      decoded.imm = inst & 0xFF;
       break;
-    }
 
-    //B(2) unconditional branch
-    case Op::b2: {
-      rb = (inst >> 0) & 0x7FF;
-      if(rb & (1 << 10))
-        rb |= (~0u) << 11;
-      rb <<= 1;
-      rb += pc;
-      rb += 2;
-      DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(15, rb);
-      return 0;
-    }
+    case Op::cps: case Op::invalid: case Op::setend:
+      decoded.imm = inst;
+      break;
+  }
 
-    //BIC
-    case Op::bic: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra & (~rb);
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+  return decoded;
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline const Thumbulator::Instruction*
+Thumbulator::fetchInstruction(uInt32 addr, Instruction& decoded)
+{
 #ifndef UNSAFE_OPTIMIZATIONS
-    //BKPT
-    case Op::bkpt: {
-      rb = (inst >> 0) & 0xFF;
-      statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
-      return 1;
-    }
-#endif
+  if(instructions > 500000) // way more than would otherwise be possible
+    throw runtime_error("instructions > 500000");
+  ++instructions;
 
-    //BL/BLX(1)
-    case Op::blx1: {
-      if((inst & 0x1800) == 0x1000) //H=b10
-      {
-        DO_DISS(statusMsg << endl);
-        rb = inst & ((1 << 11) - 1);
-        if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
-        rb <<= 12;
-        rb += pc;
-        write_register(14, rb);
-        return 0;
-      }
-      else if((inst & 0x1800) == 0x1800) //H=b11
-      {
-        //branch to thumb
-        rb = read_register(14);
-        rb += (inst & ((1 << 11) - 1)) << 1;
-        rb += 2;
-        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-        write_register(14, (pc-2) | 1);
-        write_register(15, rb);
-        return 0;
-      }
-      else if((inst & 0x1800) == 0x0800) //H=b01
-      {
-        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-        // fxq: this should exit the code without having to detect it
-        rb = read_register(14);
-        rb += (inst & ((1 << 11) - 1)) << 1;
-        rb &= 0xFFFFFFFC;
-        rb += 2;
-        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-        write_register(14, (pc-2) | 1);
-        write_register(15, rb);
-        return 0;
-      }
+  // Code in ROM has been decoded up front; anything else is decoded as
+  // it is fetched
+  if(addr >= 0x50 && addr < romSize)
+  {
+  #ifndef NO_THUMB_STATS
+    ++fetches;
+  #endif
+    DO_DISS(statusMsg << Base::HEX8 << addr << ": " << Base::HEX4 << CONV_RAMROM(rom[addr >> 1]) << " ");
 
-      break;
-    }
+    // The PC register is only looked at in error messages while running
+    reg_norm[15] = addr + 4;
+    return &decodedRom[addr >> 1];
+  }
 
-    //BLX(2)
-    case Op::blx2: {
-      rm = (inst >> 3) & 0xF;
-      DO_DISS(statusMsg << "blx r" << dec << rm << endl);
-      rc = read_register(rm);
-      //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
-      rc += 2;
-      if(rc & 1)
-      {
-        write_register(14, (pc-2) | 1);
-        //rc &= ~1;
-        write_register(15, rc);
-        return 0;
-      }
-      else
-      {
-        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-        // fxq: this could serve as exit code
-        return 1;
-      }
-    }
+  reg_norm[15] = addr + 2;
+  const uInt16 inst = fetch16(addr);
+  DO_DISS(statusMsg << Base::HEX8 << addr << ": " << Base::HEX4 << inst << " ");
 
-    //BX
-    case Op::bx: {
-      rm = (inst >> 3) & 0xF;
-      DO_DISS(statusMsg << "bx r" << dec << rm << endl);
-      rc = read_register(rm);
-      rc += 2;
-      //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
-      if(rc & 1)
-      {
-        // branch to odd address denotes 16 bit ARM code
-        //rc &= ~1;
-        write_register(15, rc);
-        return 0;
-      }
-      else
-      {
-        // branch to even address denotes 32 bit ARM code, which the Thumbulator
-        // class does not support. So capture relavent information and hand it
-        // off to the Cartridge class for it to handle.
+  reg_norm[15] = addr + 4;
+  decoded = decodeInstruction(inst);
+  return &decoded;
+#else
+  #ifndef NO_THUMB_STATS
+  ++fetches;
+  #endif
+  DO_DISS(statusMsg << Base::HEX8 << addr << ": " << Base::HEX4 << CONV_RAMROM(rom[(addr & ROMADDMASK) >> 1]) << " ");
 
-        bool handled = false;
+  return &decodedRom[(addr & ROMADDMASK) >> 1];
+#endif
+}
 
-        switch(configuration)
-        {
-          case ConfigureFor::BUS:
-            // this subroutine interface is used in the BUS driver,
-            // it starts at address 0x000006d8
-            // _SetNote:
-            //   ldr     r4, =NoteStore
-            //   bx      r4   // bx instruction at 0x000006da
-            // _ResetWave:
-            //   ldr     r4, =ResetWaveStore
-            //   bx      r4   // bx instruction at 0x000006de
-            // _GetWavePtr:
-            //   ldr     r4, =WavePtrFetch
-            //   bx      r4   // bx instruction at 0x000006e2
-            // _SetWaveSize:
-            //   ldr     r4, =WaveSizeStore
-            //   bx      r4   // bx instruction at 0x000006e6
-
-            // address to test for is + 4 due to pipelining
-
-  #define BUS_SetNote     (0x000006da + 4)
-  #define BUS_ResetWave   (0x000006de + 4)
-  #define BUS_GetWavePtr  (0x000006e2 + 4)
-  #define BUS_SetWaveSize (0x000006e6 + 4)
-
-            if      (pc == BUS_SetNote)
-            {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == BUS_ResetWave)
-            {
-              myCartridge->thumbCallback(1, read_register(2), 0);
-              handled = true;
-            }
-            else if (pc == BUS_GetWavePtr)
-            {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-              handled = true;
-            }
-            else if (pc == BUS_SetWaveSize)
-            {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == 0x0000083a)
-            {
-              // exiting Custom ARM code, returning to BUS Driver control
-            }
-            else
-            {
-  #if 0  // uncomment this for testing
-              uInt32 r0 = read_register(0);
-              uInt32 r1 = read_register(1);
-              uInt32 r2 = read_register(2);
-              uInt32 r3 = read_register(3);
-              uInt32 r4 = read_register(4);
-  #endif
-              myCartridge->thumbCallback(255, 0, 0);
-            }
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Thumbulator::profileInstruction(uInt32 addr, const Instruction& ins)
+{
+  Profile& profile = *profileData;
+  const uInt32 index = Profile::index(addr);
+
+  // Refilling the pipeline after a taken branch is charged to the branch;
+  // a run starts with lastIndex on the last bucket, which isn't charged
+  if(index != profile.lastIndex + 1 && profile.lastIndex != Profile::entries - 1)
+    profile.cycles[profile.lastIndex] += 2;
+
+  if(profile.callPending)
+    ++profile.calls[index];
+  profile.callPending = ins.op == Op::blx2 || (ins.op == Op::blx1 && ins.rd != 0x2);
+
+  const auto registers = [](uInt32 list) {
+    uInt32 count = 0;
+    for(; list; list &= list - 1)
+      ++count;
+    return count;
+  };
+
+  uInt32 cycles;
+  switch(ins.op)
+  {
+    case Op::asr2: case Op::lsl2: case Op::lsr2: case Op::ror:
+      cycles = 2;
+      break;
 
-            break;
+    case Op::mul:  // takes 1 to 4 internal cycles, depending on the operand
+      cycles = 3;
+      break;
 
-          case ConfigureFor::CDF:
-            // this subroutine interface is used in the CDF driver,
-            // it starts at address 0x000006e0
-            // _SetNote:
-            //   ldr     r4, =NoteStore
-            //   bx      r4   // bx instruction at 0x000006e2
-            // _ResetWave:
-            //   ldr     r4, =ResetWaveStore
-            //   bx      r4   // bx instruction at 0x000006e6
-            // _GetWavePtr:
-            //   ldr     r4, =WavePtrFetch
-            //   bx      r4   // bx instruction at 0x000006ea
-            // _SetWaveSize:
-            //   ldr     r4, =WaveSizeStore
-            //   bx      r4   // bx instruction at 0x000006ee
-
-            // address to test for is + 4 due to pipelining
-
-          #define CDF_SetNote     (0x000006e2 + 4)
-          #define CDF_ResetWave   (0x000006e6 + 4)
-          #define CDF_GetWavePtr  (0x000006ea + 4)
-          #define CDF_SetWaveSize (0x000006ee + 4)
-
-            if      (pc == CDF_SetNote)
-            {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == CDF_ResetWave)
-            {
-              myCartridge->thumbCallback(1, read_register(2), 0);
-              handled = true;
-            }
-            else if (pc == CDF_GetWavePtr)
-            {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-              handled = true;
-            }
-            else if (pc == CDF_SetWaveSize)
-            {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == 0x0000083a)
-            {
-              // exiting Custom ARM code, returning to BUS Driver control
-            }
-            else
-            {
-            #if 0  // uncomment this for testing
-              uInt32 r0 = read_register(0);
-              uInt32 r1 = read_register(1);
-              uInt32 r2 = read_register(2);
-              uInt32 r3 = read_register(3);
-              uInt32 r4 = read_register(4);
-            #endif
-              myCartridge->thumbCallback(255, 0, 0);
-            }
+    case Op::ldr1: case Op::ldr2: case Op::ldr3: case Op::ldr4:
+    case Op::ldrb1: case Op::ldrb2: case Op::ldrh1: case Op::ldrh2:
+    case Op::ldrsb: case Op::ldrsh:
+      cycles = 3;
+      break;
 
-            break;
+    case Op::str1: case Op::str2: case Op::str3:
+    case Op::strb1: case Op::strb2: case Op::strh1: case Op::strh2:
+      cycles = 2;
+      break;
 
-          case ConfigureFor::CDF1:
-          case ConfigureFor::CDFJ:
-            // this subroutine interface is used in the CDF driver,
-            // it starts at address 0x00000750
-            // _SetNote:
-            //   ldr     r4, =NoteStore
-            //   bx      r4   // bx instruction at 0x000006e2
-            // _ResetWave:
-            //   ldr     r4, =ResetWaveStore
-            //   bx      r4   // bx instruction at 0x000006e6
-            // _GetWavePtr:
-            //   ldr     r4, =WavePtrFetch
-            //   bx      r4   // bx instruction at 0x000006ea
-            // _SetWaveSize:
-            //   ldr     r4, =WaveSizeStore
-            //   bx      r4   // bx instruction at 0x000006ee
-
-            // address to test for is + 4 due to pipelining
-
-  #define CDF1_SetNote     (0x00000752 + 4)
-  #define CDF1_ResetWave   (0x00000756 + 4)
-  #define CDF1_GetWavePtr  (0x0000075a + 4)
-  #define CDF1_SetWaveSize (0x0000075e + 4)
-
-            if      (pc == CDF1_SetNote)
-            {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == CDF1_ResetWave)
-            {
-              myCartridge->thumbCallback(1, read_register(2), 0);
-              handled = true;
-            }
-            else if (pc == CDF1_GetWavePtr)
-            {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-              handled = true;
-            }
-            else if (pc == CDF1_SetWaveSize)
-            {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
-              handled = true;
-            }
-            else if (pc == 0x0000083a)
-            {
-              // exiting Custom ARM code, returning to BUS Driver control
-            }
-            else
-            {
-  #if 0  // uncomment this for testing
-              uInt32 r0 = read_register(0);
-              uInt32 r1 = read_register(1);
-              uInt32 r2 = read_register(2);
-              uInt32 r3 = read_register(3);
-              uInt32 r4 = read_register(4);
-  #endif
-              myCartridge->thumbCallback(255, 0, 0);
-            }
+    case Op::ldmia: case Op::pop:
+      cycles = registers(ins.imm) + 2;
+      break;
 
-            break;
+    case Op::stmia: case Op::push:
+      cycles = registers(ins.imm) + 1;
+      break;
 
-          case ConfigureFor::DPCplus:
-            // no 32-bit subroutines in DPC+
-            break;
-        }
+    default:
+      cycles = 1;
+      break;
+  }
 
-        if (handled)
-        {
-          rc = read_register(14); // lr
-          rc += 2;
-          //rc &= ~1;
-          write_register(15, rc);
-          return 0;
-        }
+  ++profile.instructions[index];
+  profile.cycles[index] += cycles;
+  profile.lastIndex = index;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool profiled>
+void Thumbulator::execute()
+{
+  // The PC is kept 2 bytes ahead of the instruction to fetch, so that it is
+  // 4 bytes ahead of it while the instruction executes
+  uInt32 pc = reg_norm[15] & ~1u;
+
+  // The flags are updated lazily: N and Z are derived from the last result
+  // only when they are tested, and C and V are kept as single bits
+  uInt32 nz = (cpsr & CPSR_Z) ? 0 : ((cpsr & CPSR_N) | 1);
+  uInt32 c = (cpsr & CPSR_C) ? 1 : 0, v = (cpsr & CPSR_V) ? 1 : 0;
+
+  const auto addWithFlags = [&nz, &c, &v](uInt32 a, uInt32 b, uInt32 carry) {
+    const uInt32 result = a + b + carry;
+    c = uInt32((uInt64(a) + b + carry) >> 32);
+    v = ((a ^ result) & (b ^ result)) >> 31;
+    nz = result;
+    return result;
+  };
+  const auto flags = [&nz, &c, &v](uInt32 psr) {
+    return (psr & ~(CPSR_N | CPSR_Z | CPSR_C | CPSR_V)) | (nz & CPSR_N) |
+           (nz ? 0 : CPSR_Z) | (c ? CPSR_C : 0) | (v ? CPSR_V : 0);
+  };
+
+  Instruction decoded;
+  const Instruction* ins;
+  uInt32 sp, ra, rb, rc;
+
+#ifdef THUMB_THREADED_DISPATCH
+  // Must follow the order of the Op enumeration
+  static const void* const ourInstructionHandlers[] = {
+    &&op_invalid,
+    &&op_adc,
+    &&op_add1, &&op_add2, &&op_add3, &&op_add4, &&op_add5, &&op_add6, &&op_add7,
+    &&op_and_,
+    &&op_asr1, &&op_asr2,
+    &&op_b1, &&op_b2,
+    &&op_bic,
+    &&op_bkpt,
+    &&op_blx1, &&op_blx2,
+    &&op_bx,
+    &&op_cmn,
+    &&op_cmp1, &&op_cmp2, &&op_cmp3,
+    &&op_cps,
+    &&op_cpy,
+    &&op_eor,
+    &&op_ldmia,
+    &&op_ldr1, &&op_ldr2, &&op_ldr3, &&op_ldr4,
+    &&op_ldrb1, &&op_ldrb2,
+    &&op_ldrh1, &&op_ldrh2,
+    &&op_ldrsb,
+    &&op_ldrsh,
+    &&op_lsl1, &&op_lsl2,
+    &&op_lsr1, &&op_lsr2,
+    &&op_mov1, &&op_mov2, &&op_mov3,
+    &&op_mul,
+    &&op_mvn,
+    &&op_neg,
+    &&op_orr,
+    &&op_pop,
+    &&op_push,
+    &&op_rev,
+    &&op_rev16,
+    &&op_revsh,
+    &&op_ror,
+    &&op_sbc,
+    &&op_setend,
+    &&op_stmia,
+    &&op_str1, &&op_str2, &&op_str3,
+    &&op_strb1, &&op_strb2,
+    &&op_strh1, &&op_strh2,
+    &&op_sub1, &&op_sub2, &&op_sub3, &&op_sub4,
+    &&op_swi,
+    &&op_sxtb,
+    &&op_sxth,
+    &&op_tst,
+    &&op_uxtb,
+    &&op_uxth
+  };
+  static_assert(sizeof(ourInstructionHandlers) / sizeof(ourInstructionHandlers[0]) ==
+                int(Op::uxth) + 1, "handler table does not match Op");
+
+  NEXT_INSTRUCTION
+#else
+  for(;;)
+  {
+    ins = fetchInstruction(pc - 2, decoded);
+    if(profiled) profileInstruction(pc - 2, *ins);
+    pc += 2;
 
-        return 1;
+    switch(ins->op)
+#endif
+    {
+      //ADC
+      INSTRUCTION(adc) {
+        DO_DISS(statusMsg << "adc r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rd], reg_norm[ins->rm], c);
       }
-    }
+      NEXT_INSTRUCTION
 
-    //CMN
-    case Op::cmn: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra + rb;
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
-      return 0;
-    }
+      //ADD(1) small immediate two registers
+      INSTRUCTION(add1) {
+        DO_DISS(statusMsg << "adds r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << ","
+                          << "#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rn], ins->imm, 0);
+      }
+      NEXT_INSTRUCTION
 
-    //CMP(1) compare immediate
-    case Op::cmp1: {
-      rb = (inst >> 0) & 0xFF;
-      rn = (inst >> 8) & 0x07;
-      DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rn);
-      rc = ra - rb;
-      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
-
-    //CMP(2) compare register
-    case Op::cmp2: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra - rb;
-      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
+      //ADD(2) big immediate one register
+      INSTRUCTION(add2) {
+        DO_DISS(statusMsg << "adds r" << dec << int(ins->rd) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rd], ins->imm, 0);
+      }
+      NEXT_INSTRUCTION
 
-    //CMP(3) compare high register
-    case Op::cmp3: {
-      if(((inst >> 6) & 3) == 0x0)
-      {
-        //UNPREDICTABLE
+      //ADD(3) three registers
+      INSTRUCTION(add3) {
+        DO_DISS(statusMsg << "adds r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << ",r" << int(ins->rm) << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rn], reg_norm[ins->rm], 0);
       }
-      rn = (inst >> 0) & 0x7;
-      rn |= (inst >> 4) & 0x8;
-      if(rn == 0xF)
-      {
-        //UNPREDICTABLE
-      }
-      rm = (inst >> 3) & 0xF;
-      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra - rb;
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
+      //ADD(4) two registers one or both high no flags
+      INSTRUCTION(add4) {
+        DO_DISS(statusMsg << "add r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[15] = pc;
+        rc = reg_norm[ins->rd] + reg_norm[ins->rm];
+        if(ins->rd == 15)
+        {
 #ifndef UNSAFE_OPTIMIZATIONS
-    //CPS
-    case Op::cps: {
-      DO_DISS(statusMsg << "cps TODO" << endl);
-      return 1;
-    }
+          if((rc & 1) == 0)
+            fatalError("add pc", pc, rc, " produced an arm address");
 #endif
+          pc = (rc + 2) & ~1u;  //The program counter is special
+        }
+        else
+          reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
 
-    //CPY copy high register
-    case Op::cpy: {
-      //same as mov except you can use both low registers
-      //going to let mov handle high registers
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
-      rc = read_register(rm);
-      write_register(rd, rc);
-      return 0;
-    }
+      //ADD(5) rd = pc plus immediate
+      INSTRUCTION(add5) {
+        DO_DISS(statusMsg << "add r" << dec << int(ins->rd) << ",PC,#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = (pc & (~3u)) + ins->imm;
+      }
+      NEXT_INSTRUCTION
 
-    //EOR
-    case Op::eor: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra ^ rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      //ADD(6) rd = sp plus immediate
+      INSTRUCTION(add6) {
+        DO_DISS(statusMsg << "add r" << dec << int(ins->rd) << ",SP,#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = reg_norm[13] + ins->imm;
+      }
+      NEXT_INSTRUCTION
 
-    //LDMIA
-    case Op::ldmia: {
-      rn = (inst >> 8) & 0x7;
-    #if defined(THUMB_DISS)
-      statusMsg << "ldmia r" << dec << rn << "!,{";
-      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
-      {
-        if(inst&rb)
+      //ADD(7) sp plus immediate
+      INSTRUCTION(add7) {
+        DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[13] += ins->imm;
+      }
+      NEXT_INSTRUCTION
+
+      //AND
+      INSTRUCTION(and_) {
+        DO_DISS(statusMsg << "ands r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] &= reg_norm[ins->rm];
+      }
+      NEXT_INSTRUCTION
+
+      //ASR(1) two register immediate
+      INSTRUCTION(asr1) {
+        DO_DISS(statusMsg << "asrs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        rb = ins->imm;
+        rc = reg_norm[ins->rm];
+        if(rb == 0)
         {
-          if(rc) statusMsg << ",";
-          statusMsg << "r" << dec << ra;
-          rc++;
+          c = rc >> 31;
+          rc = c ? ~0u : 0;
+        }
+        else
+        {
+          c = (rc >> (rb-1)) & 1;
+          ra = rc & 0x80000000;
+          rc >>= rb;
+          if(ra) //asr, sign is shifted in
+            rc |= (~0u) << (32-rb);
         }
+        nz = reg_norm[ins->rd] = rc;
       }
-      statusMsg << "}" << endl;
-    #endif
-      sp = read_register(rn);
-      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
-      {
-        if(inst & rb)
+      NEXT_INSTRUCTION
+
+      //ASR(2) two register
+      INSTRUCTION(asr2) {
+        DO_DISS(statusMsg << "asrs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rd];
+        rb = reg_norm[ins->rm] & 0xFF;
+        if(rb == 0)
         {
-          write_register(ra, read32(sp));
-          sp += 4;
         }
+        else if(rb < 32)
+        {
+          c = (rc >> (rb-1)) & 1;
+          ra = rc & 0x80000000;
+          rc >>= rb;
+          if(ra) //asr, sign is shifted in
+            rc |= (~0u) << (32-rb);
+        }
+        else
+        {
+          c = rc >> 31;
+          rc = c ? ~0u : 0;
+        }
+        nz = reg_norm[ins->rd] = rc;
       }
-      //there is a write back exception.
-      if((inst & (1 << rn)) == 0)
-        write_register(rn, sp);
+      NEXT_INSTRUCTION
 
-      return 0;
-    }
+      //B(1) conditional branch
+      INSTRUCTION(b1) {
+        bool taken = false;
+        switch(ins->rd)
+        {
+          case 0x0: //b eq  z set
+            DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = nz == 0;
+            break;
 
-    //LDR(1) two register immediate
-    case Op::ldr1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      rb <<= 2;
-      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-      rc = read32(rb);
-      write_register(rd, rc);
-      return 0;
-    }
+          case 0x1: //b ne  z clear
+            DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = nz != 0;
+            break;
 
-    //LDR(2) three register
-    case Op::ldr2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read32(rb);
-      write_register(rd, rc);
-      return 0;
-    }
+          case 0x2: //b cs c set
+            DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = c;
+            break;
 
-    //LDR(3)
-    case Op::ldr3: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
-      rb <<= 2;
-      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
-      ra = read_register(15);
-      ra &= ~3;
-      rb += ra;
-      DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
-      rc = read32(rb);
-      write_register(rd, rc);
-      return 0;
-    }
+          case 0x3: //b cc c clear
+            DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = !c;
+            break;
 
-    //LDR(4)
-    case Op::ldr4: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
-      rb <<= 2;
-      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
-      ra = read_register(13);
-      //ra&=~3;
-      rb += ra;
-      rc = read32(rb);
-      write_register(rd, rc);
-      return 0;
-    }
+          case 0x4: //b mi n set
+            DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = nz >> 31;
+            break;
 
-    //LDRB(1)
-    case Op::ldrb1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-#ifndef UNSAFE_OPTIMIZATIONS
-      rc = read16(rb & (~1u));
-#else
-      rc = read16(rb);
-#endif
-      if(rb & 1)
-      {
-        rc >>= 8;
-      }
-      else
-      {
-      }
-      write_register(rd, rc & 0xFF);
-      return 0;
-    }
+          case 0x5: //b pl n clear
+            DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = !(nz >> 31);
+            break;
 
-    //LDRB(2)
-    case Op::ldrb2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-#ifndef UNSAFE_OPTIMIZATIONS
-      rc = read16(rb & (~1u));
-#else
-      rc = read16(rb);
-#endif
-      if(rb & 1)
-      {
-        rc >>= 8;
+          case 0x6: //b vs v set
+            DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = v;
+            break;
+
+          case 0x7: //b vc v clear
+            DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = !v;
+            break;
+
+          case 0x8: //b hi c set z clear
+            DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = c && nz != 0;
+            break;
+
+          case 0x9: //b ls c clear or z set
+            DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = !c || nz == 0;
+            break;
+
+          case 0xA: //b ge N == V
+            DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = (nz >> 31) == v;
+            break;
+
+          case 0xB: //b lt N != V
+            DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = (nz >> 31) != v;
+            break;
+
+          case 0xC: //b gt Z==0 and N == V
+            DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = nz != 0 && (nz >> 31) == v;
+            break;
+
+          case 0xD: //b le Z==1 or N != V
+            DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+            taken = nz == 0 || (nz >> 31) != v;
+            break;
+        }
+        if(taken)
+          pc += ins->imm;
       }
-      write_register(rd, rc & 0xFF);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //LDRH(1)
-    case Op::ldrh1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      rb <<= 1;
-      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-      rc = read16(rb);
-      write_register(rd, rc & 0xFFFF);
-      return 0;
-    }
+      //B(2) unconditional branch
+      INSTRUCTION(b2) {
+        DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (pc+ins->imm-3) << endl);
+        pc += ins->imm;
+      }
+      NEXT_INSTRUCTION
 
-    //LDRH(2)
-    case Op::ldrh2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read16(rb);
-      write_register(rd, rc & 0xFFFF);
-      return 0;
-    }
+      //BIC
+      INSTRUCTION(bic) {
+        DO_DISS(statusMsg << "bics r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] &= ~reg_norm[ins->rm];
+      }
+      NEXT_INSTRUCTION
 
-    //LDRSB
-    case Op::ldrsb: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
+      //BKPT
+      INSTRUCTION(bkpt) {
 #ifndef UNSAFE_OPTIMIZATIONS
-      rc = read16(rb & (~1u));
-#else
-      rc = read16(rb);
+        statusMsg << "bkpt 0x" << Base::HEX2 << ins->imm << endl;
 #endif
-      if(rb & 1)
-      {
-        rc >>= 8;
+        goto finished;
       }
-      rc &= 0xFF;
-      if(rc & 0x80)
-        rc |= ((~0u) << 8);
-      write_register(rd, rc);
-      return 0;
-    }
-
-    //LDRSH
-    case Op::ldrsh: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read16(rb);
-      rc &= 0xFFFF;
-      if(rc & 0x8000)
-        rc |= ((~0u) << 16);
-      write_register(rd, rc);
-      return 0;
-    }
 
-    //LSL(1)
-    case Op::lsl1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-      rc = read_register(rm);
-      if(rb == 0)
-      {
-        //if immed_5 == 0
-        //C unaffected
-        //result not shifted
+      //BL/BLX(1)
+      INSTRUCTION(blx1) {
+        if(ins->rd == 0x2) //H=b10
+        {
+          DO_DISS(statusMsg << endl);
+          reg_norm[14] = pc + ins->imm;
+        }
+        else if(ins->rd == 0x3) //H=b11
+        {
+          //branch to thumb
+          rb = reg_norm[14] + ins->imm;
+          DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+          reg_norm[14] = (pc-2) | 1;
+          pc = rb & ~1u;
+        }
+        else //H=b01
+        {
+          // fxq: this should exit the code without having to detect it
+          rb = ((reg_norm[14] + ins->imm) & 0xFFFFFFFC) + 2;
+          DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+          reg_norm[14] = (pc-2) | 1;
+          pc = rb;
+        }
       }
-      else
-      {
-        //else immed_5 > 0
-        do_cflag_bit(rc & (1 << (32-rb)));
-        rc <<= rb;
-      }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //LSL(2) two register
-    case Op::lsl2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
-      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
-      rc = read_register(rd);
-      rb = read_register(rs);
-      rb &= 0xFF;
-      if(rb == 0)
-      {
+      //BLX(2)
+      INSTRUCTION(blx2) {
+        DO_DISS(statusMsg << "blx r" << dec << int(ins->rm) << endl);
+        reg_norm[15] = pc;
+        rc = reg_norm[ins->rm] + 2;
+        if((rc & 1) == 0)
+        {
+          // fxq: this could serve as exit code
+          goto finished;
+        }
+        reg_norm[14] = (pc-2) | 1;
+        pc = rc & ~1u;
       }
-      else if(rb < 32)
-      {
-        do_cflag_bit(rc & (1 << (32-rb)));
-        rc <<= rb;
+      NEXT_INSTRUCTION
+
+      //BX
+      INSTRUCTION(bx) {
+        DO_DISS(statusMsg << "bx r" << dec << int(ins->rm) << endl);
+        reg_norm[15] = pc;
+        rc = reg_norm[ins->rm] + 2;
+        if(rc & 1)
+        {
+          // branch to odd address denotes 16 bit ARM code
+          pc = rc & ~1u;
+        }
+        else
+        {
+          // branch to even address denotes 32 bit ARM code, which the Thumbulator
+          // class does not support. So capture relavent information and hand it
+          // off to the Cartridge class for it to handle.
+
+          bool handled = false;
+
+          switch(configuration)
+          {
+            case ConfigureFor::BUS:
+              // this subroutine interface is used in the BUS driver,
+              // it starts at address 0x000006d8
+              // _SetNote:
+              //   ldr     r4, =NoteStore
+              //   bx      r4   // bx instruction at 0x000006da
+              // _ResetWave:
+              //   ldr     r4, =ResetWaveStore
+              //   bx      r4   // bx instruction at 0x000006de
+              // _GetWavePtr:
+              //   ldr     r4, =WavePtrFetch
+              //   bx      r4   // bx instruction at 0x000006e2
+              // _SetWaveSize:
+              //   ldr     r4, =WaveSizeStore
+              //   bx      r4   // bx instruction at 0x000006e6
+
+              // address to test for is + 4 due to pipelining
+
+    #define BUS_SetNote     (0x000006da + 4)
+    #define BUS_ResetWave   (0x000006de + 4)
+    #define BUS_GetWavePtr  (0x000006e2 + 4)
+    #define BUS_SetWaveSize (0x000006e6 + 4)
+
+              if      (pc == BUS_SetNote)
+              {
+                myCartridge->thumbCallback(0, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == BUS_ResetWave)
+              {
+                myCartridge->thumbCallback(1, read_register(2), 0);
+                handled = true;
+              }
+              else if (pc == BUS_GetWavePtr)
+              {
+                write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+                handled = true;
+              }
+              else if (pc == BUS_SetWaveSize)
+              {
+                myCartridge->thumbCallback(3, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == 0x0000083a)
+              {
+                // exiting Custom ARM code, returning to BUS Driver control
+              }
+              else
+              {
+    #if 0  // uncomment this for testing
+                uInt32 r0 = read_register(0);
+                uInt32 r1 = read_register(1);
+                uInt32 r2 = read_register(2);
+                uInt32 r3 = read_register(3);
+                uInt32 r4 = read_register(4);
+    #endif
+                myCartridge->thumbCallback(255, 0, 0);
+              }
+
+              break;
+
+            case ConfigureFor::CDF:
+              // this subroutine interface is used in the CDF driver,
+              // it starts at address 0x000006e0
+              // _SetNote:
+              //   ldr     r4, =NoteStore
+              //   bx      r4   // bx instruction at 0x000006e2
+              // _ResetWave:
+              //   ldr     r4, =ResetWaveStore
+              //   bx      r4   // bx instruction at 0x000006e6
+              // _GetWavePtr:
+              //   ldr     r4, =WavePtrFetch
+              //   bx      r4   // bx instruction at 0x000006ea
+              // _SetWaveSize:
+              //   ldr     r4, =WaveSizeStore
+              //   bx      r4   // bx instruction at 0x000006ee
+
+              // address to test for is + 4 due to pipelining
+
+            #define CDF_SetNote     (0x000006e2 + 4)
+            #define CDF_ResetWave   (0x000006e6 + 4)
+            #define CDF_GetWavePtr  (0x000006ea + 4)
+            #define CDF_SetWaveSize (0x000006ee + 4)
+
+              if      (pc == CDF_SetNote)
+              {
+                myCartridge->thumbCallback(0, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == CDF_ResetWave)
+              {
+                myCartridge->thumbCallback(1, read_register(2), 0);
+                handled = true;
+              }
+              else if (pc == CDF_GetWavePtr)
+              {
+                write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+                handled = true;
+              }
+              else if (pc == CDF_SetWaveSize)
+              {
+                myCartridge->thumbCallback(3, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == 0x0000083a)
+              {
+                // exiting Custom ARM code, returning to BUS Driver control
+              }
+              else
+              {
+              #if 0  // uncomment this for testing
+                uInt32 r0 = read_register(0);
+                uInt32 r1 = read_register(1);
+                uInt32 r2 = read_register(2);
+                uInt32 r3 = read_register(3);
+                uInt32 r4 = read_register(4);
+              #endif
+                myCartridge->thumbCallback(255, 0, 0);
+              }
+
+              break;
+
+            case ConfigureFor::CDF1:
+            case ConfigureFor::CDFJ:
+              // this subroutine interface is used in the CDF driver,
+              // it starts at address 0x00000750
+              // _SetNote:
+              //   ldr     r4, =NoteStore
+              //   bx      r4   // bx instruction at 0x000006e2
+              // _ResetWave:
+              //   ldr     r4, =ResetWaveStore
+              //   bx      r4   // bx instruction at 0x000006e6
+              // _GetWavePtr:
+              //   ldr     r4, =WavePtrFetch
+              //   bx      r4   // bx instruction at 0x000006ea
+              // _SetWaveSize:
+              //   ldr     r4, =WaveSizeStore
+              //   bx      r4   // bx instruction at 0x000006ee
+
+              // address to test for is + 4 due to pipelining
+
+    #define CDF1_SetNote     (0x00000752 + 4)
+    #define CDF1_ResetWave   (0x00000756 + 4)
+    #define CDF1_GetWavePtr  (0x0000075a + 4)
+    #define CDF1_SetWaveSize (0x0000075e + 4)
+
+              if      (pc == CDF1_SetNote)
+              {
+                myCartridge->thumbCallback(0, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == CDF1_ResetWave)
+              {
+                myCartridge->thumbCallback(1, read_register(2), 0);
+                handled = true;
+              }
+              else if (pc == CDF1_GetWavePtr)
+              {
+                write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+                handled = true;
+              }
+              else if (pc == CDF1_SetWaveSize)
+              {
+                myCartridge->thumbCallback(3, read_register(2), read_register(3));
+                handled = true;
+              }
+              else if (pc == 0x0000083a)
+              {
+                // exiting Custom ARM code, returning to BUS Driver control
+              }
+              else
+              {
+    #if 0  // uncomment this for testing
+                uInt32 r0 = read_register(0);
+                uInt32 r1 = read_register(1);
+                uInt32 r2 = read_register(2);
+                uInt32 r3 = read_register(3);
+                uInt32 r4 = read_register(4);
+    #endif
+                myCartridge->thumbCallback(255, 0, 0);
+              }
+
+              break;
+
+            case ConfigureFor::DPCplus:
+              // no 32-bit subroutines in DPC+
+              break;
+          }
+
+          if(!handled)
+            goto finished;
+
+          pc = (reg_norm[14] + 2) & ~1u;  // lr
+        }
       }
-      else if(rb == 32)
-      {
-        do_cflag_bit(rc & 1);
-        rc = 0;
+      NEXT_INSTRUCTION
+
+      //CMN
+      INSTRUCTION(cmn) {
+        DO_DISS(statusMsg << "cmns r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << endl);
+        addWithFlags(reg_norm[ins->rn], reg_norm[ins->rm], 0);
       }
-      else
-      {
-        do_cflag_bit(0);
-        rc = 0;
+      NEXT_INSTRUCTION
+
+      //CMP(1) compare immediate
+      INSTRUCTION(cmp1) {
+        DO_DISS(statusMsg << "cmp r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        addWithFlags(reg_norm[ins->rn], ~ins->imm, 1);
       }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //LSR(1) two register immediate
-    case Op::lsr1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-      rc = read_register(rm);
-      if(rb == 0)
-      {
-        do_cflag_bit(rc & 0x80000000);
-        rc = 0;
+      //CMP(2) compare register
+      INSTRUCTION(cmp2) {
+        DO_DISS(statusMsg << "cmps r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << endl);
+        addWithFlags(reg_norm[ins->rn], ~reg_norm[ins->rm], 1);
       }
-      else
-      {
-        do_cflag_bit(rc & (1 << (rb-1)));
-        rc >>= rb;
+      NEXT_INSTRUCTION
+
+      //CMP(3) compare high register
+      INSTRUCTION(cmp3) {
+        DO_DISS(statusMsg << "cmps r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[15] = pc;
+        addWithFlags(reg_norm[ins->rn], ~reg_norm[ins->rm], 1);
       }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //LSR(2) two register
-    case Op::lsr2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
-      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
-      rc = read_register(rd);
-      rb = read_register(rs);
-      rb &= 0xFF;
-      if(rb == 0)
-      {
+      //CPS
+      INSTRUCTION(cps) {
+        DO_DISS(statusMsg << "cps TODO" << endl);
+        goto finished;
       }
-      else if(rb < 32)
-      {
-        do_cflag_bit(rc & (1 << (rb-1)));
-        rc >>= rb;
+
+      //CPY copy high register
+      INSTRUCTION(cpy) {
+        //same as mov except you can use both low registers
+        //going to let mov handle high registers
+        DO_DISS(statusMsg << "cpy r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = reg_norm[ins->rm];
       }
-      else if(rb == 32)
-      {
-        do_cflag_bit(rc & 0x80000000);
-        rc = 0;
+      NEXT_INSTRUCTION
+
+      //EOR
+      INSTRUCTION(eor) {
+        DO_DISS(statusMsg << "eors r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] ^= reg_norm[ins->rm];
       }
-      else
-      {
-        do_cflag_bit(0);
-        rc = 0;
+      NEXT_INSTRUCTION
+
+      //LDMIA
+      INSTRUCTION(ldmia) {
+      #if defined(THUMB_DISS)
+        statusMsg << "ldmia r" << dec << int(ins->rn) << "!,{";
+        for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
+        {
+          if(ins->imm&rb)
+          {
+            if(rc) statusMsg << ",";
+            statusMsg << "r" << dec << ra;
+            rc++;
+          }
+        }
+        statusMsg << "}" << endl;
+      #endif
+        sp = reg_norm[ins->rn];
+        for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
+        {
+          if(ins->imm & rb)
+          {
+            reg_norm[ra] = read32(sp);
+            sp += 4;
+          }
+        }
+        //there is a write back exception.
+        if((ins->imm & (1 << ins->rn)) == 0)
+          reg_norm[ins->rn] = sp;
       }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //MOV(1) immediate
-    case Op::mov1: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
-      DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-      write_register(rd, rb);
-      do_nflag(rb);
-      do_zflag(rb);
-      return 0;
-    }
+      //LDR(1) two register immediate
+      INSTRUCTION(ldr1) {
+        DO_DISS(statusMsg << "ldr r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        reg_norm[ins->rd] = read32(reg_norm[ins->rn] + ins->imm);
+      }
+      NEXT_INSTRUCTION
 
-    //MOV(2) two low registers
-    case Op::mov2: {
-      rd = (inst >> 0) & 7;
-      rn = (inst >> 3) & 7;
-      DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
-      rc = read_register(rn);
-      //fprintf(stderr,"0x%08X\n",rc);
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag_bit(0);
-      do_vflag_bit(0);
-      return 0;
-    }
+      //LDR(2) three register
+      INSTRUCTION(ldr2) {
+        DO_DISS(statusMsg << "ldr r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        reg_norm[ins->rd] = read32(reg_norm[ins->rn] + reg_norm[ins->rm]);
+      }
+      NEXT_INSTRUCTION
 
-    //MOV(3)
-    case Op::mov3: {
-      rd  = (inst >> 0) & 0x7;
-      rd |= (inst >> 4) & 0x8;
-      rm  = (inst >> 3) & 0xF;
-      DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
-      rc = read_register(rm);
-      if((rd == 14) && (rm == 15))
-      {
-        //printf("mov lr,pc warning 0x%08X\n",pc-2);
-        //rc|=1;
+      //LDR(3)
+      INSTRUCTION(ldr3) {
+        DO_DISS(statusMsg << "ldr r" << dec << int(ins->rd) << ",[PC+#0x" << Base::HEX2 << ins->imm << "] ");
+        rb = (pc & ~3u) + ins->imm;
+        DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
+        reg_norm[ins->rd] = read32(rb);
       }
-      if(rd == 15)
-      {
-        //rc &= ~1; //write_register may do this as well
-        rc += 2;  //The program counter is special
+      NEXT_INSTRUCTION
+
+      //LDR(4)
+      INSTRUCTION(ldr4) {
+        DO_DISS(statusMsg << "ldr r" << dec << int(ins->rd) << ",[SP+#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        reg_norm[ins->rd] = read32(reg_norm[13] + ins->imm);
       }
-      write_register(rd, rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //MUL
-    case Op::mul: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra * rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      //LDRB(1)
+      INSTRUCTION(ldrb1) {
+        DO_DISS(statusMsg << "ldrb r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        rb = reg_norm[ins->rn] + ins->imm;
+#ifndef UNSAFE_OPTIMIZATIONS
+        rc = read16(rb & (~1u));
+#else
+        rc = read16(rb);
+#endif
+        if(rb & 1)
+          rc >>= 8;
+        reg_norm[ins->rd] = rc & 0xFF;
+      }
+      NEXT_INSTRUCTION
 
-    //MVN
-    case Op::mvn: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = (~ra);
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      //LDRB(2)
+      INSTRUCTION(ldrb2) {
+        DO_DISS(statusMsg << "ldrb r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        rb = reg_norm[ins->rn] + reg_norm[ins->rm];
+#ifndef UNSAFE_OPTIMIZATIONS
+        rc = read16(rb & (~1u));
+#else
+        rc = read16(rb);
+#endif
+        if(rb & 1)
+          rc >>= 8;
+        reg_norm[ins->rd] = rc & 0xFF;
+      }
+      NEXT_INSTRUCTION
 
-    //NEG
-    case Op::neg: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = 0 - ra;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(0, ~ra, 1);
-      do_vflag(0, ~ra, 1);
-      return 0;
-    }
+      //LDRH(1)
+      INSTRUCTION(ldrh1) {
+        DO_DISS(statusMsg << "ldrh r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        reg_norm[ins->rd] = read16(reg_norm[ins->rn] + ins->imm) & 0xFFFF;
+      }
+      NEXT_INSTRUCTION
 
-    //ORR
-    case Op::orr: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra | rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      //LDRH(2)
+      INSTRUCTION(ldrh2) {
+        DO_DISS(statusMsg << "ldrh r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        reg_norm[ins->rd] = read16(reg_norm[ins->rn] + reg_norm[ins->rm]) & 0xFFFF;
+      }
+      NEXT_INSTRUCTION
 
-    //POP
-    case Op::pop: {
-    #if defined(THUMB_DISS)
-      statusMsg << "pop {";
-      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
-      {
-        if(inst&rb)
+      //LDRSB
+      INSTRUCTION(ldrsb) {
+        DO_DISS(statusMsg << "ldrsb r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        rb = reg_norm[ins->rn] + reg_norm[ins->rm];
+#ifndef UNSAFE_OPTIMIZATIONS
+        rc = read16(rb & (~1u));
+#else
+        rc = read16(rb);
+#endif
+        if(rb & 1)
+          rc >>= 8;
+        rc &= 0xFF;
+        if(rc & 0x80)
+          rc |= ((~0u) << 8);
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
+
+      //LDRSH
+      INSTRUCTION(ldrsh) {
+        DO_DISS(statusMsg << "ldrsh r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        rc = read16(reg_norm[ins->rn] + reg_norm[ins->rm]) & 0xFFFF;
+        if(rc & 0x8000)
+          rc |= ((~0u) << 16);
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
+
+      //LSL(1)
+      INSTRUCTION(lsl1) {
+        DO_DISS(statusMsg << "lsls r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        rb = ins->imm;
+        rc = reg_norm[ins->rm];
+        if(rb == 0)
         {
-          if(rc) statusMsg << ",";
-          statusMsg << "r" << dec << ra;
-          rc++;
+          //if immed_5 == 0
+          //C unaffected
+          //result not shifted
         }
+        else
+        {
+          //else immed_5 > 0
+          c = (rc >> (32-rb)) & 1;
+          rc <<= rb;
+        }
+        nz = reg_norm[ins->rd] = rc;
       }
-      if(inst&0x100)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "pc";
-      }
-      statusMsg << "}" << endl;
-    #endif
+      NEXT_INSTRUCTION
 
-      sp = read_register(13);
-      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
-      {
-        if(inst & rb)
+      //LSL(2) two register
+      INSTRUCTION(lsl2) {
+        DO_DISS(statusMsg << "lsls r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rd];
+        rb = reg_norm[ins->rm] & 0xFF;
+        if(rb == 0)
         {
-          write_register(ra, read32(sp));
-          sp += 4;
         }
+        else if(rb < 32)
+        {
+          c = (rc >> (32-rb)) & 1;
+          rc <<= rb;
+        }
+        else if(rb == 32)
+        {
+          c = rc & 1;
+          rc = 0;
+        }
+        else
+        {
+          c = 0;
+          rc = 0;
+        }
+        nz = reg_norm[ins->rd] = rc;
       }
-      if(inst & 0x100)
-      {
-        rc = read32(sp);
-        rc += 2;
-        write_register(15, rc);
-        sp += 4;
-      }
-      write_register(13, sp);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //PUSH
-    case Op::push: {
-    #if defined(THUMB_DISS)
-      statusMsg << "push {";
-      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
-      {
-        if(inst&rb)
+      //LSR(1) two register immediate
+      INSTRUCTION(lsr1) {
+        DO_DISS(statusMsg << "lsrs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        rb = ins->imm;
+        rc = reg_norm[ins->rm];
+        if(rb == 0)
         {
-          if(rc) statusMsg << ",";
-          statusMsg << "r" << dec << ra;
-          rc++;
+          c = rc >> 31;
+          rc = 0;
         }
+        else
+        {
+          c = (rc >> (rb-1)) & 1;
+          rc >>= rb;
+        }
+        nz = reg_norm[ins->rd] = rc;
       }
-      if(inst&0x100)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "lr";
-      }
-      statusMsg << "}" << endl;
-    #endif
+      NEXT_INSTRUCTION
 
-      sp = read_register(13);
-      //fprintf(stderr,"sp 0x%08X\n",sp);
-      for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ++ra)
-      {
-        if(inst & rb)
+      //LSR(2) two register
+      INSTRUCTION(lsr2) {
+        DO_DISS(statusMsg << "lsrs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rd];
+        rb = reg_norm[ins->rm] & 0xFF;
+        if(rb == 0)
         {
-          ++rc;
         }
-      }
-      if(inst & 0x100) ++rc;
-      rc <<= 2;
-      sp -= rc;
-      rd = sp;
-      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
-      {
-        if(inst & rb)
+        else if(rb < 32)
         {
-          write32(rd, read_register(ra));
-          rd += 4;
+          c = (rc >> (rb-1)) & 1;
+          rc >>= rb;
         }
-      }
-      if(inst & 0x100)
-      {
-        rc = read_register(14);
-        write32(rd, rc);
-        if((rc & 1) == 0)
+        else if(rb == 32)
         {
-          // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+          c = rc >> 31;
+          rc = 0;
+        }
+        else
+        {
+          c = 0;
+          rc = 0;
         }
+        nz = reg_norm[ins->rd] = rc;
       }
-      write_register(13, sp);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //REV
-    case Op::rev: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
-      ra = read_register(rn);
-      rc  = ((ra >>  0) & 0xFF) << 24;
-      rc |= ((ra >>  8) & 0xFF) << 16;
-      rc |= ((ra >> 16) & 0xFF) <<  8;
-      rc |= ((ra >> 24) & 0xFF) <<  0;
-      write_register(rd, rc);
-      return 0;
-    }
+      //MOV(1) immediate
+      INSTRUCTION(mov1) {
+        DO_DISS(statusMsg << "movs r" << dec << int(ins->rd) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        nz = reg_norm[ins->rd] = ins->imm;
+      }
+      NEXT_INSTRUCTION
 
-    //REV16
-    case Op::rev16: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
-      ra = read_register(rn);
-      rc  = ((ra >>  0) & 0xFF) <<  8;
-      rc |= ((ra >>  8) & 0xFF) <<  0;
-      rc |= ((ra >> 16) & 0xFF) << 24;
-      rc |= ((ra >> 24) & 0xFF) << 16;
-      write_register(rd, rc);
-      return 0;
-    }
+      //MOV(2) two low registers
+      INSTRUCTION(mov2) {
+        DO_DISS(statusMsg << "movs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << endl);
+        nz = reg_norm[ins->rd] = reg_norm[ins->rn];
+        c = v = 0;
+      }
+      NEXT_INSTRUCTION
 
-    //REVSH
-    case Op::revsh: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
-      ra = read_register(rn);
-      rc  = ((ra >> 0) & 0xFF) << 8;
-      rc |= ((ra >> 8) & 0xFF) << 0;
-      if(rc & 0x8000) rc |= 0xFFFF0000;
-      else            rc &= 0x0000FFFF;
-      write_register(rd, rc);
-      return 0;
-    }
+      //MOV(3)
+      INSTRUCTION(mov3) {
+        DO_DISS(statusMsg << "mov r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[15] = pc;
+        rc = reg_norm[ins->rm];
+        if(ins->rd == 15)
+          pc = (rc + 2) & ~1u;  //The program counter is special
+        else
+          reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
 
-    //ROR
-    case Op::ror: {
-      rd = (inst >> 0) & 0x7;
-      rs = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
-      rc = read_register(rd);
-      ra = read_register(rs);
-      ra &= 0xFF;
-      if(ra == 0)
-      {
+      //MUL
+      INSTRUCTION(mul) {
+        DO_DISS(statusMsg << "muls r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] *= reg_norm[ins->rm];
       }
-      else
-      {
-        ra &= 0x1F;
+      NEXT_INSTRUCTION
+
+      //MVN
+      INSTRUCTION(mvn) {
+        DO_DISS(statusMsg << "mvns r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] = ~reg_norm[ins->rm];
+      }
+      NEXT_INSTRUCTION
+
+      //NEG
+      INSTRUCTION(neg) {
+        DO_DISS(statusMsg << "negs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = addWithFlags(0, ~reg_norm[ins->rm], 1);
+      }
+      NEXT_INSTRUCTION
+
+      //ORR
+      INSTRUCTION(orr) {
+        DO_DISS(statusMsg << "orrs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rd] |= reg_norm[ins->rm];
+      }
+      NEXT_INSTRUCTION
+
+      //POP
+      INSTRUCTION(pop) {
+      #if defined(THUMB_DISS)
+        statusMsg << "pop {";
+        for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
+        {
+          if(ins->imm&rb)
+          {
+            if(rc) statusMsg << ",";
+            statusMsg << "r" << dec << ra;
+            rc++;
+          }
+        }
+        if(ins->imm&0x100)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "pc";
+        }
+        statusMsg << "}" << endl;
+      #endif
+
+        sp = reg_norm[13];
+        for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
+        {
+          if(ins->imm & rb)
+          {
+            reg_norm[ra] = read32(sp);
+            sp += 4;
+          }
+        }
+        if(ins->imm & 0x100)
+        {
+          rc = read32(sp);
+          pc = (rc + 2) & ~1u;
+          sp += 4;
+        }
+        reg_norm[13] = sp;
+      }
+      NEXT_INSTRUCTION
+
+      //PUSH
+      INSTRUCTION(push) {
+      #if defined(THUMB_DISS)
+        statusMsg << "push {";
+        for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
+        {
+          if(ins->imm&rb)
+          {
+            if(rc) statusMsg << ",";
+            statusMsg << "r" << dec << ra;
+            rc++;
+          }
+        }
+        if(ins->imm&0x100)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "lr";
+        }
+        statusMsg << "}" << endl;
+      #endif
+
+        sp = reg_norm[13];
+        for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ++ra)
+        {
+          if(ins->imm & rb)
+          {
+            ++rc;
+          }
+        }
+        if(ins->imm & 0x100) ++rc;
+        rc <<= 2;
+        sp -= rc;
+        rc = sp;
+        for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
+        {
+          if(ins->imm & rb)
+          {
+            write32(rc, reg_norm[ra]);
+            rc += 4;
+          }
+        }
+        if(ins->imm & 0x100)
+          write32(rc, reg_norm[14]);
+        reg_norm[13] = sp;
+      }
+      NEXT_INSTRUCTION
+
+      //REV
+      INSTRUCTION(rev) {
+        DO_DISS(statusMsg << "rev r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << endl);
+        ra = reg_norm[ins->rn];
+        rc  = ((ra >>  0) & 0xFF) << 24;
+        rc |= ((ra >>  8) & 0xFF) << 16;
+        rc |= ((ra >> 16) & 0xFF) <<  8;
+        rc |= ((ra >> 24) & 0xFF) <<  0;
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
+
+      //REV16
+      INSTRUCTION(rev16) {
+        DO_DISS(statusMsg << "rev16 r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << endl);
+        ra = reg_norm[ins->rn];
+        rc  = ((ra >>  0) & 0xFF) <<  8;
+        rc |= ((ra >>  8) & 0xFF) <<  0;
+        rc |= ((ra >> 16) & 0xFF) << 24;
+        rc |= ((ra >> 24) & 0xFF) << 16;
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
+
+      //REVSH
+      INSTRUCTION(revsh) {
+        DO_DISS(statusMsg << "revsh r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << endl);
+        ra = reg_norm[ins->rn];
+        rc  = ((ra >> 0) & 0xFF) << 8;
+        rc |= ((ra >> 8) & 0xFF) << 0;
+        if(rc & 0x8000) rc |= 0xFFFF0000;
+        else            rc &= 0x0000FFFF;
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
+
+      //ROR
+      INSTRUCTION(ror) {
+        DO_DISS(statusMsg << "rors r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rd];
+        ra = reg_norm[ins->rm] & 0xFF;
         if(ra == 0)
         {
-          do_cflag_bit(rc & 0x80000000);
         }
         else
         {
-          do_cflag_bit(rc & (1 << (ra-1)));
-          rb = rc << (32-ra);
-          rc >>= ra;
-          rc |= rb;
+          ra &= 0x1F;
+          if(ra == 0)
+          {
+            c = rc >> 31;
+          }
+          else
+          {
+            c = (rc >> (ra-1)) & 1;
+            rb = rc << (32-ra);
+            rc >>= ra;
+            rc |= rb;
+          }
         }
+        nz = reg_norm[ins->rd] = rc;
       }
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //SBC
-    case Op::sbc: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rd);
-      rb = read_register(rm);
-      rc = ra - rb;
-      if(!(cpsr & CPSR_C)) --rc;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      if(cpsr & CPSR_C)
-      {
-        do_cflag(ra, ~rb, 1);
-        do_vflag(ra, ~rb, 1);
+      //SBC
+      INSTRUCTION(sbc) {
+        DO_DISS(statusMsg << "sbc r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rd], ~reg_norm[ins->rm], c);
       }
-      else
-      {
-        do_cflag(ra, ~rb, 0);
-        do_vflag(ra, ~rb, 0);
-      }
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
+      //SETEND
+      INSTRUCTION(setend) {
 #ifndef UNSAFE_OPTIMIZATIONS
-    //SETEND
-    case Op::setend: {
-      statusMsg << "setend not implemented" << endl;
-      return 1;
-    }
+        statusMsg << "setend not implemented" << endl;
 #endif
+        goto finished;
+      }
 
-    //STMIA
-    case Op::stmia: {
-      rn = (inst >> 8) & 0x7;
-    #if defined(THUMB_DISS)
-      statusMsg << "stmia r" << dec << rn << "!,{";
-      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
-      {
-        if(inst & rb)
+      //STMIA
+      INSTRUCTION(stmia) {
+      #if defined(THUMB_DISS)
+        statusMsg << "stmia r" << dec << int(ins->rn) << "!,{";
+        for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
         {
-          if(rc) statusMsg << ",";
-          statusMsg << "r" << dec << ra;
-          rc++;
+          if(ins->imm & rb)
+          {
+            if(rc) statusMsg << ",";
+            statusMsg << "r" << dec << ra;
+            rc++;
+          }
         }
-      }
-      statusMsg << "}" << endl;
-    #endif
+        statusMsg << "}" << endl;
+      #endif
 
-      sp = read_register(rn);
-      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
-      {
-        if(inst & rb)
+        sp = reg_norm[ins->rn];
+        for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
         {
-          write32(sp, read_register(ra));
-          sp += 4;
+          if(ins->imm & rb)
+          {
+            write32(sp, reg_norm[ra]);
+            sp += 4;
+          }
         }
+        reg_norm[ins->rn] = sp;
       }
-      write_register(rn, sp);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //STR(1)
-    case Op::str1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      rb <<= 2;
-      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-      rc = read_register(rd);
-      write32(rb, rc);
-      return 0;
-    }
+      //STR(1)
+      INSTRUCTION(str1) {
+        DO_DISS(statusMsg << "str r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        write32(reg_norm[ins->rn] + ins->imm, reg_norm[ins->rd]);
+      }
+      NEXT_INSTRUCTION
 
-    //STR(2)
-    case Op::str2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read_register(rd);
-      write32(rb, rc);
-      return 0;
-    }
+      //STR(2)
+      INSTRUCTION(str2) {
+        DO_DISS(statusMsg << "str r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        write32(reg_norm[ins->rn] + reg_norm[ins->rm], reg_norm[ins->rd]);
+      }
+      NEXT_INSTRUCTION
 
-    //STR(3)
-    case Op::str3: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
-      rb <<= 2;
-      DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(13) + rb;
-      //fprintf(stderr,"0x%08X\n",rb);
-      rc = read_register(rd);
-      write32(rb, rc);
-      return 0;
-    }
+      //STR(3)
+      INSTRUCTION(str3) {
+        DO_DISS(statusMsg << "str r" << dec << int(ins->rd) << ",[SP,#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        write32(reg_norm[13] + ins->imm, reg_norm[ins->rd]);
+      }
+      NEXT_INSTRUCTION
 
-    //STRB(1)
-    case Op::strb1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-      rc = read_register(rd);
+      //STRB(1)
+      INSTRUCTION(strb1) {
+        DO_DISS(statusMsg << "strb r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX8 << ins->imm << "]" << endl);
+        rb = reg_norm[ins->rn] + ins->imm;
+        rc = reg_norm[ins->rd];
 #ifndef UNSAFE_OPTIMIZATIONS
-      ra = read16(rb & (~1u));
+        ra = read16(rb & (~1u));
 #else
-      ra = read16(rb);
+        ra = read16(rb);
 #endif
-      if(rb & 1)
-      {
-        ra &= 0x00FF;
-        ra |= rc << 8;
-      }
-      else
-      {
-        ra &= 0xFF00;
-        ra |= rc & 0x00FF;
+        if(rb & 1)
+        {
+          ra &= 0x00FF;
+          ra |= rc << 8;
+        }
+        else
+        {
+          ra &= 0xFF00;
+          ra |= rc & 0x00FF;
+        }
+        write16(rb & (~1u), ra & 0xFFFF);
       }
-      write16(rb & (~1u), ra & 0xFFFF);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //STRB(2)
-    case Op::strb2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read_register(rd);
+      //STRB(2)
+      INSTRUCTION(strb2) {
+        DO_DISS(statusMsg << "strb r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << int(ins->rm) << "]" << endl);
+        rb = reg_norm[ins->rn] + reg_norm[ins->rm];
+        rc = reg_norm[ins->rd];
 #ifndef UNSAFE_OPTIMIZATIONS
-      ra = read16(rb & (~1u));
+        ra = read16(rb & (~1u));
 #else
-      ra = read16(rb);
+        ra = read16(rb);
 #endif
-      if(rb & 1)
-      {
-        ra &= 0x00FF;
-        ra |= rc << 8;
-      }
-      else
-      {
-        ra &= 0xFF00;
-        ra |= rc & 0x00FF;
+        if(rb & 1)
+        {
+          ra &= 0x00FF;
+          ra |= rc << 8;
+        }
+        else
+        {
+          ra &= 0xFF00;
+          ra |= rc & 0x00FF;
+        }
+        write16(rb & (~1u), ra & 0xFFFF);
       }
-      write16(rb & (~1u), ra & 0xFFFF);
-      return 0;
-    }
+      NEXT_INSTRUCTION
 
-    //STRH(1)
-    case Op::strh1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
-      rb <<= 1;
-      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-      rb = read_register(rn) + rb;
-      rc=  read_register(rd);
-      write16(rb, rc & 0xFFFF);
-      return 0;
-    }
-
-    //STRH(2)
-    case Op::strh2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-      rb = read_register(rn) + read_register(rm);
-      rc = read_register(rd);
-      write16(rb, rc & 0xFFFF);
-      return 0;
-    }
-
-    //SUB(1)
-    case Op::sub1: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rb = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rn);
-      rc = ra - rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
+      //STRH(1)
+      INSTRUCTION(strh1) {
+        DO_DISS(statusMsg << "strh r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << "]" << endl);
+        write16(reg_norm[ins->rn] + ins->imm, reg_norm[ins->rd] & 0xFFFF);
+      }
+      NEXT_INSTRUCTION
 
-    //SUB(2)
-    case Op::sub2: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
-      DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rd);
-      rc = ra - rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
+      //STRH(2)
+      INSTRUCTION(strh2) {
+        DO_DISS(statusMsg << "strh r" << dec << int(ins->rd) << ",[r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << "]" << endl);
+        write16(reg_norm[ins->rn] + reg_norm[ins->rm], reg_norm[ins->rd] & 0xFFFF);
+      }
+      NEXT_INSTRUCTION
 
-    //SUB(3)
-    case Op::sub3: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
-      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra - rb;
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
-      return 0;
-    }
+      //SUB(1)
+      INSTRUCTION(sub1) {
+        DO_DISS(statusMsg << "subs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rn], ~ins->imm, 1);
+      }
+      NEXT_INSTRUCTION
 
-    //SUB(4)
-    case Op::sub4: {
-      rb = inst & 0x7F;
-      rb <<= 2;
-      DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(13);
-      ra -= rb;
-      write_register(13, ra);
-      return 0;
-    }
+      //SUB(2)
+      INSTRUCTION(sub2) {
+        DO_DISS(statusMsg << "subs r" << dec << int(ins->rd) << ",#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rd], ~ins->imm, 1);
+      }
+      NEXT_INSTRUCTION
 
-    //SWI
-    case Op::swi: {
-      rb = inst & 0xFF;
-      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
+      //SUB(3)
+      INSTRUCTION(sub3) {
+        DO_DISS(statusMsg << "subs r" << dec << int(ins->rd) << ",r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = addWithFlags(reg_norm[ins->rn], ~reg_norm[ins->rm], 1);
+      }
+      NEXT_INSTRUCTION
 
-      if((inst & 0xFF) == 0xCC)
-      {
-        write_register(0, cpsr);
-        return 0;
+      //SUB(4)
+      INSTRUCTION(sub4) {
+        DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << ins->imm << endl);
+        reg_norm[13] -= ins->imm;
       }
-      else
-      {
+      NEXT_INSTRUCTION
+
+      //SWI
+      INSTRUCTION(swi) {
+        DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << ins->imm << endl);
+        if(ins->imm != 0xCC)
+        {
 #if defined(THUMB_DISS)
-        statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
+          statusMsg << endl << endl << "swi 0x" << Base::HEX2 << ins->imm << endl;
 #endif
-        return 1;
+          goto finished;
+        }
+        reg_norm[0] = flags(cpsr);
       }
-    }
+      NEXT_INSTRUCTION
 
-    //SXTB
-    case Op::sxtb: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = ra & 0xFF;
-      if(rc & 0x80)
-        rc |= (~0u) << 8;
-      write_register(rd, rc);
-      return 0;
-    }
+      //SXTB
+      INSTRUCTION(sxtb) {
+        DO_DISS(statusMsg << "sxtb r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rm] & 0xFF;
+        if(rc & 0x80)
+          rc |= (~0u) << 8;
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
 
-    //SXTH
-    case Op::sxth: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = ra & 0xFFFF;
-      if(rc & 0x8000)
-        rc |= (~0u) << 16;
-      write_register(rd, rc);
-      return 0;
-    }
+      //SXTH
+      INSTRUCTION(sxth) {
+        DO_DISS(statusMsg << "sxth r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        rc = reg_norm[ins->rm] & 0xFFFF;
+        if(rc & 0x8000)
+          rc |= (~0u) << 16;
+        reg_norm[ins->rd] = rc;
+      }
+      NEXT_INSTRUCTION
 
-    //TST
-    case Op::tst: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
-      ra = read_register(rn);
-      rb = read_register(rm);
-      rc = ra & rb;
-      do_nflag(rc);
-      do_zflag(rc);
-      return 0;
-    }
+      //TST
+      INSTRUCTION(tst) {
+        DO_DISS(statusMsg << "tst r" << dec << int(ins->rn) << ",r" << dec << int(ins->rm) << endl);
+        nz = reg_norm[ins->rn] & reg_norm[ins->rm];
+      }
+      NEXT_INSTRUCTION
 
-    //UXTB
-    case Op::uxtb: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = ra & 0xFF;
-      write_register(rd, rc);
-      return 0;
-    }
+      //UXTB
+      INSTRUCTION(uxtb) {
+        DO_DISS(statusMsg << "uxtb r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = reg_norm[ins->rm] & 0xFF;
+      }
+      NEXT_INSTRUCTION
 
-    //UXTH
-    case Op::uxth: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
-      DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
-      ra = read_register(rm);
-      rc = ra & 0xFFFF;
-      write_register(rd, rc);
-      return 0;
-    }
+      //UXTH
+      INSTRUCTION(uxth) {
+        DO_DISS(statusMsg << "uxth r" << dec << int(ins->rd) << ",r" << dec << int(ins->rm) << endl);
+        reg_norm[ins->rd] = reg_norm[ins->rm] & 0xFFFF;
+      }
+      NEXT_INSTRUCTION
 
+      INSTRUCTION(invalid) {
 #ifndef UNSAFE_OPTIMIZATIONS
-    case Op::invalid:
-      break;
-#else
-    default:
-      break;
+        statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << ins->imm << endl;
 #endif
+        goto finished;
+      }
+    }
+#ifndef THUMB_THREADED_DISPATCH
   }
-
-#ifndef UNSAFE_OPTIMIZATIONS
-  statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
 #endif
-  return 1;
+
+finished:
+  reg_norm[15] = pc;
+  cpsr = flags(cpsr);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2557,3 +2525,115 @@ int Thumbulator::reset()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Thumbulator::trapOnFatal = true;
 #endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::Profile::Profile()
+  : instructions(entries),
+    cycles(entries),
+    calls(entries)
+{
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::Profile::reset()
+{
+  std::fill(instructions.begin(), instructions.end(), 0);
+  std::fill(cycles.begin(), cycles.end(), 0);
+  std::fill(calls.begin(), calls.end(), 0);
+
+  runs = 0;
+  seconds = 0;
+  lastIndex = entries - 1;
+  callPending = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::Profile::index(uInt32 address)
+{
+  if(address < ROMSIZE)
+    return address >> 1;
+  else if(address >= 0x40000000 && address < 0x40000000 + RAMSIZE)
+    return (ROMSIZE + (address & RAMADDMASK)) >> 1;
+  else
+    return entries - 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::Profile::address(uInt32 index)
+{
+  return index < ROMSIZE / 2 ? index << 1 : 0x40000000 + (index << 1) - ROMSIZE;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 Thumbulator::Profile::totalInstructions() const
+{
+  uInt64 total = 0;
+  for(uInt32 i = 0; i < entries - 1; ++i)
+    total += instructions[i];
+
+  return total;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 Thumbulator::Profile::totalCycles() const
+{
+  uInt64 total = 0;
+  for(uInt32 i = 0; i < entries - 1; ++i)
+    total += cycles[i];
+
+  return total;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<Thumbulator::Profile::Function>
+Thumbulator::Profile::hotFunctions(uInt32 count) const
+{
+  vector<Function> functions;
+
+  // Code that is executed before any entry point in ROM or in RAM (the
+  // driver, or code the cart jumps to) gets a function of its own
+  for(uInt32 i = 0; i < entries - 1; ++i)
+  {
+    if(calls[i] > 0 || i == 0 || i == ROMSIZE / 2)
+      functions.push_back(Function{ address(i), calls[i], 0, 0 });
+
+    functions.back().instructions += instructions[i];
+    functions.back().cycles += cycles[i];
+  }
+
+  functions.erase(std::remove_if(functions.begin(), functions.end(),
+                                 [](const Function& f) { return f.instructions == 0; }),
+                  functions.end());
+  std::stable_sort(functions.begin(), functions.end(),
+                   [](const Function& a, const Function& b) { return a.cycles > b.cycles; });
+
+  if(functions.size() > count)
+    functions.resize(count);
+
+  return functions;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::Profile::print(ostream& out, uInt32 count) const
+{
+  const uInt64 total = totalCycles();
+
+  out << "ARM: " << runs << " runs, " << totalInstructions() << " instructions, "
+      << total << " cycles (estimated), "
+      << std::fixed << std::setprecision(3) << (seconds * 1000) << " ms host time"
+      << std::defaultfloat << std::setprecision(6) << endl;
+
+  if(total == 0)
+    return;
+
+  out << "      cycles      %  instructions     calls  function" << endl;
+  for(const Function& function: hotFunctions(count))
+    out << std::dec << std::setfill(' ') << std::setw(12) << function.cycles << " "
+        << std::fixed << std::setprecision(1) << std::setw(6) << (100.0 * function.cycles / total)
+        << std::setw(14) << function.instructions
+        << std::setw(10) << function.calls << "  "
+        << Base::HEX8 << function.address << endl;
+
+  out << std::dec << std::setfill(' ') << std::defaultfloat << std::setprecision(6);
+}
@@ -97,6 +97,78 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      An execution profile of the ARM code in ROM and RAM.  For each
+      instruction address, it counts the executions, the ARM cycles spent
+      (estimated from the ARM7TDMI timings, ignoring wait states) and the
+      calls to that address.  Calls are BL/BLX instructions, and the start
+      of each run().
+    */
+    struct Profile {
+      // A function of the ARM code, identified by its entry point
+      struct Function {
+        uInt32 address;
+        uInt64 calls;
+        uInt64 instructions;  // executed in the function itself
+        uInt64 cycles;
+      };
+
+      // The number of instruction addresses: ROM, RAM, and one entry for
+      // everything else
+      static constexpr uInt32 entries = ROMSIZE / 2 + RAMSIZE / 2 + 1;
+
+      // Per instruction address, indexed by index()
+      vector<uInt64> instructions, cycles, calls;
+
+      // The number of run() invocations, and the host time they took
+      uInt64 runs;
+      double seconds;
+
+      // The state of the current run, kept by Thumbulator::profileInstruction
+      uInt32 lastIndex;
+      bool callPending;
+
+      Profile();
+
+      void reset();
+
+      // Map an instruction address to its index in the counts, and back
+      static uInt32 index(uInt32 address);
+      static uInt32 address(uInt32 index);
+
+      uInt64 totalInstructions() const;
+      uInt64 totalCycles() const;
+
+      /**
+        The functions that took the most cycles, hottest first.  As in the
+        flat profile of gprof, each instruction is charged to the closest
+        entry point at or below it.
+
+        @param count  The maximum number of functions to return
+      */
+      vector<Function> hotFunctions(uInt32 count) const;
+
+      /**
+        Print the totals, followed by a listing of the hot functions.
+      */
+      void print(ostream& out, uInt32 count) const;
+    };
+
+    /**
+      Start or stop collecting an execution profile.  Profiling uses a
+      separate instance of the emulation loop, so it costs nothing while it
+      is disabled.  It is not available if built with NO_THUMB_STATS.
+
+      @param enable  Whether to collect a profile; enabling resets it
+    */
+    void enableProfiling(bool enable);
+
+    /**
+      The profile collected since profiling was enabled, or nullptr
+      if profiling is disabled.
+    */
+    Profile* profile() const { return profileData.get(); }
+
   private:
 
     enum class Op : uInt8 {
@@ -149,6 +221,31 @@ class Thumbulator
       uxth
     };
 
+    /**
+      A predecoded instruction: the operation, and its operands unpacked
+      from the instruction word.  Immediates are already scaled and sign
+      extended; branch offsets are relative to the pipelined PC.
+    */
+    struct Instruction {
+      Op op;
+      uInt8 rd, rn, rm;
+      uInt32 imm;
+    };
+
+    /**
+      The memory behind one 256MB region of the address space, which is
+      selected by the top four bits of an address.  Aligned accesses within
+      the given offsets go straight to the array; all others, and those to
+      the peripherals, take the slow path, which also does the checks.
+    */
+    struct MemoryRegion {
+      const uInt16* data;    // nullptr if not backed by ROM or RAM
+      uInt16* writableData;  // nullptr if read-only
+      uInt32 fetchStart;     // fetches from [fetchStart, readEnd)
+      uInt32 readEnd;        // reads from [0, readEnd)
+      uInt32 writeStart;     // writes to [writeStart, readEnd)
+    };
+
   private:
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
@@ -160,16 +257,18 @@ class Thumbulator
 #endif
     void write16(uInt32 addr, uInt32 data);
     void write32(uInt32 addr, uInt32 data);
+    uInt32 fetch16Slow(uInt32 addr);
+    uInt32 read16Slow(uInt32 addr);
+    uInt32 read32Slow(uInt32 addr);
+    void write16Slow(uInt32 addr, uInt32 data);
+    void write32Slow(uInt32 addr, uInt32 data);
+    void setupMemoryRegions();
     void updateTimer(uInt32 cycles);
 
     static Op decodeInstructionWord(uint16_t inst);
-
-    void do_zflag(uInt32 x);
-    void do_nflag(uInt32 x);
-    void do_cflag(uInt32 a, uInt32 b, uInt32 c);
-    void do_vflag(uInt32 a, uInt32 b, uInt32 c);
-    void do_cflag_bit(uInt32 x);
-    void do_vflag_bit(uInt32 x);
+    static Instruction decodeInstruction(uInt16 inst);
+    const Instruction* fetchInstruction(uInt32 addr, Instruction& decoded);
+    void profileInstruction(uInt32 addr, const Instruction& ins);
 
 #ifndef UNSAFE_OPTIMIZATIONS
     // Throw a runtime_error exception containing an error referencing the
@@ -181,14 +280,16 @@ class Thumbulator
     void dump_counters();
     void dump_regs();
 #endif
-    int execute();
+    template<bool profiled>
+    void execute();
     int reset();
 
   private:
     const uInt16* rom;
     uInt16 romSize;
-    const unique_ptr<Op[]> decodedRom;
+    const unique_ptr<Instruction[]> decodedRom;
     uInt16* ram;
+    MemoryRegion memoryRegions[16];
 
     uInt32 reg_norm[16]; // normal execution mode, do not have a thread mode
     uInt32 cpsr, mamcr;
@@ -200,6 +301,7 @@ class Thumbulator
 #ifndef NO_THUMB_STATS
     uInt64 fetches, reads, writes;
 #endif
+    unique_ptr<Profile> profileData;
 
     // For emulation of LPC2103's timer 1, used for NTSC/PAL/SECAM detection.
     // Register names from documentation:
@@ -0,0 +1,136 @@
+# Common part of the standalone builds of the emulation core (see
+# src/batch and src/bench), which need neither SDL nor 'configure'.  The
+# including Makefile sets CORE_DIR (the 'src' directory) and OBJDIR.
+
+CXX      ?= g++
+CXXFLAGS += -std=c++14 -Wall -Wextra -Wno-unused-parameter -Wno-multichar \
+            -Wunused -fno-rtti -Woverloaded-virtual -Wnon-virtual-dtor
+LDFLAGS  += -pthread
+
+# Same CPU dispatch as a default 'configure' build
+CPPFLAGS += -DTHREADED_DISPATCH
+
+ifeq ($(DEBUG), 1)
+   CXXFLAGS += -O0 -g
+else
+   CXXFLAGS += -O3 -DNDEBUG
+endif
+
+ifneq ($(findstring Darwin,$(shell uname -s)),)
+   CPPFLAGS += -DBSPF_MACOS
+   FSNODE   := $(CORE_DIR)/unix/FSNodePOSIX.cxx
+   INCFLAGS := -I$(CORE_DIR)/unix
+else ifneq ($(findstring MINGW,$(shell uname -s)),)
+   CPPFLAGS += -DBSPF_WINDOWS
+   FSNODE   := $(CORE_DIR)/windows/FSNodeWINDOWS.cxx
+   INCFLAGS := -I$(CORE_DIR)/windows
+else
+   CPPFLAGS += -DBSPF_UNIX
+   FSNODE   := $(CORE_DIR)/unix/FSNodePOSIX.cxx
+   INCFLAGS := -I$(CORE_DIR)/unix
+endif
+
+INCFLAGS += -I. -I$(CORE_DIR) -I$(CORE_DIR)/emucore -I$(CORE_DIR)/emucore/tia \
+            -I$(CORE_DIR)/emucore/tia/frame-manager -I$(CORE_DIR)/common \
+            -I$(CORE_DIR)/common/audio -I$(CORE_DIR)/common/tv_filters
+
+CORE_SOURCES_CXX := \
+	$(FSNODE) \
+	$(CORE_DIR)/common/AudioQueue.cxx \
+	$(CORE_DIR)/common/AudioSettings.cxx \
+	$(CORE_DIR)/common/Base.cxx \
+	$(CORE_DIR)/common/Logger.cxx \
+	$(CORE_DIR)/common/StaggeredLogger.cxx \
+	$(CORE_DIR)/common/TimerManager.cxx \
+	$(CORE_DIR)/emucore/Bankswitch.cxx \
+	$(CORE_DIR)/emucore/Cart.cxx \
+	$(CORE_DIR)/emucore/Cart0840.cxx \
+	$(CORE_DIR)/emucore/Cart2K.cxx \
+	$(CORE_DIR)/emucore/Cart3E.cxx \
+	$(CORE_DIR)/emucore/Cart3EPlus.cxx \
+	$(CORE_DIR)/emucore/Cart3F.cxx \
+	$(CORE_DIR)/emucore/Cart4A50.cxx \
+	$(CORE_DIR)/emucore/Cart4K.cxx \
+	$(CORE_DIR)/emucore/Cart4KSC.cxx \
+	$(CORE_DIR)/emucore/CartAR.cxx \
+	$(CORE_DIR)/emucore/CartBF.cxx \
+	$(CORE_DIR)/emucore/CartBFSC.cxx \
+	$(CORE_DIR)/emucore/CartBUS.cxx \
+	$(CORE_DIR)/emucore/CartCDF.cxx \
+	$(CORE_DIR)/emucore/CartCM.cxx \
+	$(CORE_DIR)/emucore/CartCTY.cxx \
+	$(CORE_DIR)/emucore/CartCV.cxx \
+	$(CORE_DIR)/emucore/CartCVPlus.cxx \
+	$(CORE_DIR)/emucore/CartDASH.cxx \
+	$(CORE_DIR)/emucore/CartDetector.cxx \
+	$(CORE_DIR)/emucore/CartDF.cxx \
+	$(CORE_DIR)/emucore/CartDFSC.cxx \
+	$(CORE_DIR)/emucore/CartDPC.cxx \
+	$(CORE_DIR)/emucore/CartDPCPlus.cxx \
+	$(CORE_DIR)/emucore/CartE0.cxx \
+	$(CORE_DIR)/emucore/CartE7.cxx \
+	$(CORE_DIR)/emucore/CartE78K.cxx \
+	$(CORE_DIR)/emucore/CartEF.cxx \
+	$(CORE_DIR)/emucore/CartEFSC.cxx \
+	$(CORE_DIR)/emucore/CartF0.cxx \
+	$(CORE_DIR)/emucore/CartF4.cxx \
+	$(CORE_DIR)/emucore/CartF4SC.cxx \
+	$(CORE_DIR)/emucore/CartF6.cxx \
+	$(CORE_DIR)/emucore/CartF6SC.cxx \
+	$(CORE_DIR)/emucore/CartF8.cxx \
+	$(CORE_DIR)/emucore/CartF8SC.cxx \
+	$(CORE_DIR)/emucore/CartFA.cxx \
+	$(CORE_DIR)/emucore/CartFA2.cxx \
+	$(CORE_DIR)/emucore/CartFE.cxx \
+	$(CORE_DIR)/emucore/CartMDM.cxx \
+	$(CORE_DIR)/emucore/CartMNetwork.cxx \
+	$(CORE_DIR)/emucore/CartSB.cxx \
+	$(CORE_DIR)/emucore/CartUA.cxx \
+	$(CORE_DIR)/emucore/CartWD.cxx \
+	$(CORE_DIR)/emucore/CartX07.cxx \
+	$(CORE_DIR)/emucore/Control.cxx \
+	$(CORE_DIR)/emucore/DispatchResult.cxx \
+	$(CORE_DIR)/emucore/EmulationTiming.cxx \
+	$(CORE_DIR)/emucore/FSNode.cxx \
+	$(CORE_DIR)/emucore/InputScript.cxx \
+	$(CORE_DIR)/emucore/Joystick.cxx \
+	$(CORE_DIR)/emucore/M6502.cxx \
+	$(CORE_DIR)/emucore/M6532.cxx \
+	$(CORE_DIR)/emucore/MD5.cxx \
+	$(CORE_DIR)/emucore/Props.cxx \
+	$(CORE_DIR)/emucore/Serializer.cxx \
+	$(CORE_DIR)/emucore/Settings.cxx \
+	$(CORE_DIR)/emucore/SubsystemTimer.cxx \
+	$(CORE_DIR)/emucore/Switches.cxx \
+	$(CORE_DIR)/emucore/System.cxx \
+	$(CORE_DIR)/emucore/Thumbulator.cxx \
+	$(CORE_DIR)/emucore/tia/Audio.cxx \
+	$(CORE_DIR)/emucore/tia/AudioChannel.cxx \
+	$(CORE_DIR)/emucore/tia/Background.cxx \
+	$(CORE_DIR)/emucore/tia/Ball.cxx \
+	$(CORE_DIR)/emucore/tia/DrawCounterDecodes.cxx \
+	$(CORE_DIR)/emucore/tia/LatchedInput.cxx \
+	$(CORE_DIR)/emucore/tia/Missile.cxx \
+	$(CORE_DIR)/emucore/tia/PaddleReader.cxx \
+	$(CORE_DIR)/emucore/tia/Player.cxx \
+	$(CORE_DIR)/emucore/tia/Playfield.cxx \
+	$(CORE_DIR)/emucore/tia/ScanlineCompositor.cxx \
+	$(CORE_DIR)/emucore/tia/TIA.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/AbstractFrameManager.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/FrameLayoutDetector.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/FrameLayoutYStartDetector.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/FrameManager.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/JitterEmulation.cxx \
+	$(CORE_DIR)/emucore/tia/frame-manager/YStartDetector.cxx
+
+# The objects go to a separate directory, so they don't clash with those of
+# the other builds sharing the same sources
+core_objects = $(addprefix $(OBJDIR)/,$(subst ../,,$(1:.cxx=.o)))
+
+$(OBJDIR)/%.o: $(CORE_DIR)/%.cxx
+	@mkdir -p $(@D)
+	$(CXX) $(INCFLAGS) $(CPPFLAGS) $(CXXFLAGS) -MMD -c -o $@ $<
+
+$(OBJDIR)/%.o: %.cxx
+	@mkdir -p $(@D)
+	$(CXX) $(INCFLAGS) $(CPPFLAGS) $(CXXFLAGS) -MMD -c -o $@ $<
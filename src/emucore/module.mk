@@ -61,6 +61,7 @@ MODULE_OBJS := \
 	src/emucore/FrameBuffer.o \
 	src/emucore/FBSurface.o \
 	src/emucore/FSNode.o \
+	src/emucore/InputScript.o \
 	src/emucore/Genesis.o \
 	src/emucore/Joystick.o \
 	src/emucore/Keyboard.o \
@@ -79,6 +80,7 @@ MODULE_OBJS := \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/SubsystemTimer.o \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASurface.o \
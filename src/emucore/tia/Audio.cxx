@@ -17,6 +17,7 @@
 
 #include "Audio.hxx"
 #include "AudioQueue.hxx"
+#include "SubsystemTimer.hxx"
 
 #include <cmath>
 
@@ -36,7 +37,8 @@ namespace {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Audio::Audio()
   : myAudioQueue(nullptr),
-    myCurrentFragment(nullptr)
+    myCurrentFragment(nullptr),
+    myOutputEnabled(true)
 {
   for (uInt8 i = 0; i <= 0x1e; ++i) myMixingTableSum[i] = mixingTableEntry(i, 0x1e);
   for (uInt8 i = 0; i <= 0x0f; ++i) myMixingTableIndividual[i] = mixingTableEntry(i, 0x0f);
@@ -83,13 +85,38 @@ void Audio::tick()
   if (++myCounter == 228) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::tick(uInt32 clocks)
+{
+  PROFILE_SUBSYSTEM(audio);
+
+  while (clocks > 0) {
+    // Distance to the next clock that triggers a phase event (see tick())
+    uInt32 toEvent;
+    if (myCounter <= 9)        toEvent = 9 - myCounter;
+    else if (myCounter <= 37)  toEvent = 37 - myCounter;
+    else if (myCounter <= 81)  toEvent = 81 - myCounter;
+    else if (myCounter <= 149) toEvent = 149 - myCounter;
+    else                       toEvent = 228 + 9 - myCounter;
+
+    if (toEvent >= clocks) {
+      myCounter = (myCounter + clocks) % 228;
+      return;
+    }
+
+    myCounter = (myCounter + toEvent) % 228;
+    clocks -= toEvent + 1;
+    tick();
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Audio::phase1()
 {
   uInt8 sample0 = myChannel0.phase1();
   uInt8 sample1 = myChannel1.phase1();
 
-  if (!myAudioQueue) return;
+  if (!myAudioQueue || !myOutputEnabled) return;
 
   if (myAudioQueue->isStereo()) {
     myCurrentFragment[2*mySampleIndex] = myMixingTableIndividual[sample0];
@@ -33,8 +33,20 @@ class Audio : public Serializable
 
     void setAudioQueue(shared_ptr<AudioQueue> queue);
 
+    /**
+      Enable or disable passing samples to the audio queue. While disabled,
+      the channels are still clocked, but their output is discarded.
+     */
+    void enableOutput(bool enable) { myOutputEnabled = enable; }
+
     void tick();
 
+    /**
+      Advance by the given number of clocks; equivalent to calling tick()
+      that many times, but skips the clocks between two phase events.
+     */
+    void tick(uInt32 clocks);
+
     AudioChannel& channel0();
 
     AudioChannel& channel1();
@@ -62,6 +74,8 @@ class Audio : public Serializable
     Int16* myCurrentFragment;
     uInt32 mySampleIndex;
 
+    bool myOutputEnabled;
+
   private:
     Audio(const Audio&) = delete;
     Audio(Audio&&) = delete;
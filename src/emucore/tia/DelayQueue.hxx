@@ -43,6 +43,17 @@ class DelayQueue : public Serializable
 
     template<class T> void execute(T executor);
 
+    /**
+      Answers whether there are no pending writes in the queue.
+     */
+    bool isEmpty() const { return mySize == 0; }
+
+    /**
+      Advance the queue by the given number of clocks without executing
+      anything. Only valid if the queue is empty.
+     */
+    void skip(uInt32 clocks);
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -54,6 +65,9 @@ class DelayQueue : public Serializable
     uInt8 myIndex;
     uInt8 myIndices[0xFF];
 
+    // Total number of pending writes across all members
+    uInt32 mySize;
+
   private:
     DelayQueue(const DelayQueue&) = delete;
     DelayQueue(DelayQueue&&) = delete;
@@ -68,7 +82,8 @@ class DelayQueue : public Serializable
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 DelayQueue<length, capacity>::DelayQueue()
-  : myIndex(0)
+  : myIndex(0),
+    mySize(0)
 {
   memset(myIndices, 0xFF, 0xFF);
 }
@@ -82,11 +97,14 @@ void DelayQueue<length, capacity>::push(uInt8 address, uInt8 value, uInt8 delay)
 
   uInt8 currentIndex = myIndices[address];
 
-  if (currentIndex < length)
+  if (currentIndex < length) {
     myMembers[currentIndex].remove(address);
+    --mySize;
+  }
 
   uInt8 index = smartmod<length>(myIndex + delay);
   myMembers[index].push(address, value);
+  ++mySize;
 
   myIndices[address] = index;
 }
@@ -99,6 +117,7 @@ void DelayQueue<length, capacity>::reset()
     myMembers[i].clear();
 
   myIndex = 0;
+  mySize = 0;
   memset(myIndices, 0xFF, 0xFF);
 }
 
@@ -114,11 +133,19 @@ void DelayQueue<length, capacity>::execute(T executor)
     myIndices[currentMember.myEntries[i].address] = 0xFF;
   }
 
+  mySize -= currentMember.mySize;
   currentMember.clear();
 
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::skip(uInt32 clocks)
+{
+  myIndex = (myIndex + clocks) % length;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
@@ -150,8 +177,11 @@ bool DelayQueue<length, capacity>::load(Serializer& in)
   {
     if (in.getInt() != length) throw runtime_error("delay queue length mismatch");
 
-    for (uInt8 i = 0; i < length; ++i)
+    mySize = 0;
+    for (uInt8 i = 0; i < length; ++i) {
       myMembers[i].load(in);
+      mySize += myMembers[i].mySize;
+    }
 
     myIndex = in.getByte();
     in.getByteArray(myIndices, 0xFF);
@@ -223,18 +223,18 @@ void Playfield::applyColors()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 Playfield::getColor() const
+uInt8 Playfield::getColor(uInt32 x) const
 {
   if (!myDebugEnabled)
-    return myX < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
+    return x < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
   else
   {
-    if (myX < TIAConstants::H_PIXEL / 2)
+    if (x < TIAConstants::H_PIXEL / 2)
     {
       // left side:
-      if(myX < 16)
+      if(x < 16)
         return myDebugColor - 2;    // PF0
-      if(myX < 48)
+      if(x < 48)
         return myDebugColor;        // PF1
     }
     else
@@ -242,16 +242,16 @@ uInt8 Playfield::getColor() const
       // right side:
       if(!myReflected)
       {
-        if(myX < TIAConstants::H_PIXEL / 2 + 16)
+        if(x < TIAConstants::H_PIXEL / 2 + 16)
           return myDebugColor - 2;  // PF0
-        if(myX < TIAConstants::H_PIXEL / 2 + 48)
+        if(x < TIAConstants::H_PIXEL / 2 + 48)
           return myDebugColor;      // PF1
       }
       else
       {
-        if(myX >= TIAConstants::H_PIXEL - 16)
+        if(x >= TIAConstants::H_PIXEL - 16)
           return myDebugColor - 2;  // PF0
-        if(myX >= TIAConstants::H_PIXEL - 48)
+        if(x >= TIAConstants::H_PIXEL - 48)
           return myDebugColor;      // PF1
       }
     }
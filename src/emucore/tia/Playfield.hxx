@@ -116,9 +116,15 @@ class Playfield : public Serializable
     bool isOn() const { return (collision & 0x8000); }
 
     /**
-      Get the current color.
+      Get the color at the given pixel.
      */
-    uInt8 getColor() const;
+    uInt8 getColor(uInt32 x) const;
+
+    /**
+      Is "debug colors" mode active? The color depends on the playfield
+      register (and not only on the screen half) in that case.
+     */
+    bool debugColorsEnabled() const { return myDebugEnabled; }
 
     /**
       Serializable methods (see that class for more information).
@@ -0,0 +1,244 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "ScanlineCompositor.hxx"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define COMPOSITOR_SSE2
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define COMPOSITOR_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace {
+
+  /**
+    Expands each bit of a byte into a byte (0x00 or 0xff) of a 64 bit word.
+   */
+  struct ByteMaskTable
+  {
+    uInt64 entry[256];
+
+    ByteMaskTable() {
+      for (uInt32 bits = 0; bits < 256; ++bits) {
+        entry[bits] = 0;
+
+        for (uInt32 i = 0; i < 8; ++i)
+          if (bits & (1 << i)) entry[bits] |= uInt64(0xff) << (8 * i);
+      }
+    }
+  };
+
+  const ByteMaskTable ourByteMasks;
+
+  /**
+    Primitives for processing a group of pixels at once.
+   */
+#if defined(COMPOSITOR_SSE2)
+  using Pixels = __m128i;
+  constexpr uInt32 GROUP_SIZE = 16;
+
+  inline Pixels loadPixels(const uInt8* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  inline void storePixels(uInt8* p, Pixels v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  inline Pixels splatPixels(uInt8 color) {
+    return _mm_set1_epi8(static_cast<char>(color));
+  }
+  inline Pixels expandBits(uInt32 bits) {
+    return _mm_set_epi64x(static_cast<long long>(ourByteMasks.entry[bits >> 8]),
+                          static_cast<long long>(ourByteMasks.entry[bits & 0xff]));
+  }
+  inline Pixels selectPixels(Pixels mask, Pixels a, Pixels b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+  }
+#elif defined(COMPOSITOR_NEON)
+  using Pixels = uint8x16_t;
+  constexpr uInt32 GROUP_SIZE = 16;
+
+  inline Pixels loadPixels(const uInt8* p) { return vld1q_u8(p); }
+  inline void storePixels(uInt8* p, Pixels v) { vst1q_u8(p, v); }
+  inline Pixels splatPixels(uInt8 color) { return vdupq_n_u8(color); }
+  inline Pixels expandBits(uInt32 bits) {
+    return vcombine_u8(vcreate_u8(ourByteMasks.entry[bits & 0xff]),
+                       vcreate_u8(ourByteMasks.entry[bits >> 8]));
+  }
+  inline Pixels selectPixels(Pixels mask, Pixels a, Pixels b) {
+    return vbslq_u8(mask, a, b);
+  }
+#else
+  using Pixels = uInt64;
+  constexpr uInt32 GROUP_SIZE = 8;
+
+  inline Pixels loadPixels(const uInt8* p) {
+    Pixels v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+  inline void storePixels(uInt8* p, Pixels v) { memcpy(p, &v, sizeof(v)); }
+  inline Pixels splatPixels(uInt8 color) { return 0x0101010101010101ULL * color; }
+  inline Pixels expandBits(uInt32 bits) { return ourByteMasks.entry[bits]; }
+  inline Pixels selectPixels(Pixels mask, Pixels a, Pixels b) {
+    return (mask & a) | (~mask & b);
+  }
+#endif
+
+  constexpr uInt64 GROUP_MASK = (uInt64(1) << GROUP_SIZE) - 1;
+
+  // Set if all objects are visible at the same time (this mirrors the
+  // visibility bit of the individual object collision masks)
+  constexpr uInt32 ALL_VISIBLE = 0x8000;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScanlineCompositor::ScanlineCompositor(const uInt32 (&collisionMasks)[numObjects])
+  : myXStart(0),
+    myXEnd(0)
+{
+  memcpy(myCollisionMasks, collisionMasks, sizeof(myCollisionMasks));
+  memset(myObjects, 0, sizeof(myObjects));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScanlineCompositor::reset()
+{
+  if (myXEnd > 0)
+    memset(myObjects, 0, sizeof(myObjects));
+
+  myXStart = myXEnd = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ScanlineCompositor::resolve(uInt8* line, const Object (&order)[numObjects],
+                                   const Colors& colors, bool vblank)
+{
+  if (isEmpty()) return 0;
+
+  Mask masks[numObjects];
+  buildMasks(masks);
+
+  // Collisions: each pair of overlapping objects sets the bit shared by
+  // their collision masks
+  uInt32 collisions = 0;
+  for (uInt32 i = 0; i < numObjects; ++i)
+    for (uInt32 j = i + 1; j < numObjects; ++j) {
+      const Mask& a = masks[i];
+      const Mask& b = masks[j];
+
+      if ((a.word[0] & b.word[0]) | (a.word[1] & b.word[1]) | (a.word[2] & b.word[2]))
+        collisions |= myCollisionMasks[i] & myCollisionMasks[j];
+    }
+
+  Mask all = masks[0];
+  for (uInt32 i = 1; i < numObjects; ++i)
+    for (uInt32 w = 0; w < 3; ++w) all.word[w] &= masks[i].word[w];
+  if (!all.isEmpty()) collisions |= ALL_VISIBLE;
+
+  // Priorities: paint the segment background first, then the objects in
+  // order of increasing priority
+  if (line) {
+    Mask segment = { { 0, 0, 0 } };
+    for (uInt32 w = 0; w < 3; ++w) {
+      const uInt32 first = std::max(myXStart, w * 64), last = std::min(myXEnd, w * 64 + 64);
+      if (first >= last) continue;
+
+      const uInt32 width = last - first;
+      segment.word[w] = (width == 64 ? ~uInt64(0) : ((uInt64(1) << width) - 1)) << (first - w * 64);
+    }
+
+    if (vblank)
+      paint(line, segment, 0);
+    else {
+      paint(line, segment, colors.background);
+
+      for (const Object object: order) {
+        if (masks[object].isEmpty()) continue;
+
+        if (object == PF)
+          paintPlayfield(line, masks[object], colors);
+        else
+          paint(line, masks[object], colors.object[object]);
+      }
+    }
+  }
+
+  memset(myObjects + myXStart, 0, myXEnd - myXStart);
+  myXStart = myXEnd = 0;
+
+  return collisions;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScanlineCompositor::buildMasks(Mask (&masks)[numObjects]) const
+{
+  memset(masks, 0, sizeof(masks));
+
+#if defined(COMPOSITOR_SSE2)
+  // Bit i of each byte is moved to the top of the byte, where it is picked
+  // up by movemask
+  for (uInt32 x = myXStart & ~15u; x < myXEnd; x += 16) {
+    const __m128i objects = loadPixels(myObjects + x);
+
+    for (uInt32 i = 0; i < numObjects; ++i) {
+      const uInt32 bits = _mm_movemask_epi8(_mm_sll_epi16(objects, _mm_cvtsi32_si128(7 - i)));
+      masks[i].word[x >> 6] |= uInt64(bits) << (x & 63);
+    }
+  }
+#else
+  for (uInt32 x = myXStart; x < myXEnd; ++x) {
+    const uInt32 objects = myObjects[x];
+
+    for (uInt32 i = 0; i < numObjects; ++i)
+      masks[i].word[x >> 6] |= uInt64((objects >> i) & 0x01) << (x & 63);
+  }
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScanlineCompositor::paint(uInt8* line, const Mask& mask, uInt8 color) const
+{
+  const Pixels colorPixels = splatPixels(color);
+
+  for (uInt32 x = myXStart & ~(GROUP_SIZE - 1); x < myXEnd; x += GROUP_SIZE) {
+    const uInt32 bits = uInt32((mask.word[x >> 6] >> (x & 63)) & GROUP_MASK);
+    if (bits == 0) continue;
+
+    storePixels(line + x, selectPixels(expandBits(bits), colorPixels, loadPixels(line + x)));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScanlineCompositor::paintPlayfield(uInt8* line, const Mask& mask,
+                                        const Colors& colors) const
+{
+  const Pixels left = splatPixels(colors.object[PF]), right = splatPixels(colors.playfieldRight);
+
+  // The screen halves are aligned to the group size, so each group has
+  // a single color (unless debug colors are active)
+  for (uInt32 x = myXStart & ~(GROUP_SIZE - 1); x < myXEnd; x += GROUP_SIZE) {
+    const uInt32 bits = uInt32((mask.word[x >> 6] >> (x & 63)) & GROUP_MASK);
+    if (bits == 0) continue;
+
+    const Pixels color = colors.playfieldRow ?
+      loadPixels(colors.playfieldRow + x) : (x < TIAConstants::H_PIXEL / 2 ? left : right);
+
+    storePixels(line + x, selectPixels(expandBits(bits), color, loadPixels(line + x)));
+  }
+}
@@ -0,0 +1,155 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIA_SCANLINE_COMPOSITOR
+#define TIA_SCANLINE_COMPOSITOR
+
+#include "bspf.hxx"
+#include "TIAConstants.hxx"
+
+/**
+  The compositor collects the visibility of the six graphics objects for a
+  contiguous segment of a scanline while the TIA clocks the objects. Once the
+  segment is complete (i.e. before any state that affects rendering changes),
+  the segment is resolved in one go: a 160 bit coverage mask is built for each
+  object, and priorities and collisions are resolved with bitwise operations
+  on those masks. The colors are then written to the scanline 8 (or 16, if
+  SSE2 / NEON is available) pixels at a time.
+*/
+class ScanlineCompositor
+{
+  public:
+
+    /**
+      The graphics objects, in the order of the bits passed to record().
+     */
+    enum Object: uInt8 { P0, M0, P1, M1, PF, BL, numObjects };
+
+    /**
+      Colors used for rendering a segment.
+     */
+    struct Colors
+    {
+      // Color of each object; for the playfield, this is the color of the
+      // left half of the screen
+      uInt8 object[numObjects];
+      // Playfield color on the right half of the screen
+      uInt8 playfieldRight;
+      // If set, per pixel playfield colors override the above (debug colors)
+      const uInt8* playfieldRow;
+      uInt8 background;
+    };
+
+  public:
+
+    /**
+      The collision masks of the objects are injected at construction; two
+      overlapping objects set the bit that their masks have in common.
+     */
+    explicit ScanlineCompositor(const uInt32 (&collisionMasks)[numObjects]);
+
+  public:
+
+    /**
+      Discard the current segment.
+     */
+    void reset();
+
+    /**
+      Is the current segment empty?
+     */
+    bool isEmpty() const { return myXEnd == 0; }
+
+    /**
+      Record the visibility of the objects at pixel x (0 .. 159). The pixels
+      of a segment must be recorded in increasing order without gaps. Bit n of
+      'objects' is the visibility of the object with index n.
+     */
+    void record(uInt32 x, uInt8 objects) {
+      if (myXEnd == 0) myXStart = x;
+      myObjects[x] = objects;
+      myXEnd = x + 1;
+    }
+
+    /**
+      Resolve the current segment and start a new one.
+
+      @param line       The scanline to render to, or nullptr if nothing is
+                        to be rendered
+      @param order      The objects in the order of increasing priority
+      @param colors     The colors of the objects
+      @param vblank     Render the segment black if true
+
+      @return  The collision bits (as in the TIA collision mask) for all
+               pixels in the segment
+     */
+    uInt32 resolve(uInt8* line, const Object (&order)[numObjects],
+                   const Colors& colors, bool vblank);
+
+  private:
+    /**
+      A 160 bit mask with one bit per pixel.
+     */
+    struct Mask
+    {
+      uInt64 word[3];
+
+      bool isEmpty() const { return (word[0] | word[1] | word[2]) == 0; }
+    };
+
+    /**
+      Build the coverage masks for all objects from the recorded pixels.
+     */
+    void buildMasks(Mask (&masks)[numObjects]) const;
+
+    /**
+      Paint 'color' to all pixels of 'line' for which 'mask' is set.
+     */
+    void paint(uInt8* line, const Mask& mask, uInt8 color) const;
+
+    /**
+      Paint the playfield; its color depends on the pixel position.
+     */
+    void paintPlayfield(uInt8* line, const Mask& mask, const Colors& colors) const;
+
+  private:
+
+    /**
+      Collision masks of the objects.
+     */
+    uInt32 myCollisionMasks[numObjects];
+
+    /**
+      Visibility bits for each pixel. Pixels outside the current segment
+      are always zero.
+     */
+    uInt8 myObjects[TIAConstants::H_PIXEL];
+
+    /**
+      Pixel range [myXStart, myXEnd) of the current segment.
+     */
+    uInt32 myXStart;
+    uInt32 myXEnd;
+
+  private:
+    ScanlineCompositor(const ScanlineCompositor&) = delete;
+    ScanlineCompositor(ScanlineCompositor&&) = delete;
+    ScanlineCompositor& operator=(const ScanlineCompositor&) = delete;
+    ScanlineCompositor& operator=(ScanlineCompositor&&) = delete;
+};
+
+#endif // TIA_SCANLINE_COMPOSITOR
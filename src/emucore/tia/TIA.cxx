@@ -24,6 +24,7 @@
 #include "frame-manager/FrameManager.hxx"
 #include "AudioQueue.hxx"
 #include "DispatchResult.hxx"
+#include "SubsystemTimer.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "CartDebug.hxx"
@@ -65,6 +66,12 @@ enum ResxCounter: uInt8 {
 // 70, the G.I. Joe will show an artifact (hole in roof).
 static constexpr uInt8 resxLateHblankThreshold = TIAConstants::H_CYCLES - 3;
 
+// Collision masks in the object order used by the scanline compositor
+static constexpr uInt32 compositorCollisionMasks[ScanlineCompositor::numObjects] = {
+  CollisionMask::player0, CollisionMask::missile0, CollisionMask::player1,
+  CollisionMask::missile1, CollisionMask::playfield, CollisionMask::ball
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIA::TIA(ConsoleIO& console, ConsoleTimingProvider timingProvider, Settings& settings)
   : myConsole(console),
@@ -77,6 +84,11 @@ TIA::TIA(ConsoleIO& console, ConsoleTimingProvider timingProvider, Settings& set
     myPlayer0(~CollisionMask::player0 & 0x7FFF),
     myPlayer1(~CollisionMask::player1 & 0x7FFF),
     myBall(~CollisionMask::ball & 0x7FFF),
+    myCompositor(compositorCollisionMasks),
+    mySegmentCollisions(false),
+    myHeadless(false),
+    myAudioOutputEnabled(true),
+    myFrameSerial(0),
     mySpriteEnabledBits(0xFF),
     myCollisionsEnabledBits(0xFF)
 {
@@ -117,6 +129,20 @@ void TIA::setAudioQueue(shared_ptr<AudioQueue> queue)
   myAudio.setAudioQueue(queue);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::enableAudioOutput(bool enable)
+{
+  myAudioOutputEnabled = enable;
+  myAudio.enableOutput(myAudioOutputEnabled && !myHeadless);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setHeadless(bool headless)
+{
+  myHeadless = headless;
+  myAudio.enableOutput(myAudioOutputEnabled && !myHeadless);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearFrameManager()
 {
@@ -139,6 +165,8 @@ void TIA::reset()
   myCollisionMask = 0;
   myLinesSinceChange = 0;
   myCollisionUpdateRequired = myCollisionUpdateScheduled = false;
+  myCompositor.reset();
+  mySegmentCollisions = false;
   myColorLossEnabled = myColorLossActive = false;
   myColorHBlank = 0;
   myLastCycle = 0;
@@ -172,14 +200,17 @@ void TIA::reset()
   if (myFrameManager)
     myFrameManager->reset();
 
-  myFrontBufferScanlines = myFrameBufferScanlines = 0;
-
   myFramesSinceLastRender = 0;
 
+  myBackFrame = 0;
+  myReadyFrame = 1;
+  myFrontFrame = 2;
+  myBackBuffer = myFrameBuffers[myBackFrame];
+
   // Blank the various framebuffers; they may contain graphical garbage
-  memset(myBackBuffer, 0,  TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-  memset(myFrontBuffer, 0, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-  memset(myFramebuffer, 0, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+  memset(myFrameBuffers, 0, sizeof(myFrameBuffers));
+  memset(myFrameScanlines, 0, sizeof(myFrameScanlines));
+  markAllLinesChanged();
 
   applyDeveloperSettings();
 
@@ -277,8 +308,8 @@ bool TIA::save(Serializer& out) const
 
     out.putLong(myCyclesAtFrameStart);
 
-    out.putInt(myFrameBufferScanlines);
-    out.putInt(myFrontBufferScanlines);
+    out.putInt(myFrameScanlines[myFrontFrame]);
+    out.putInt(myFrameScanlines[myReadyFrame.load() & FRAME_INDEX]);
 
     out.putByte(myPFBitsDelay);
     out.putByte(myPFColorDelay);
@@ -325,6 +356,8 @@ bool TIA::load(Serializer& in)
     myCollisionUpdateRequired = in.getBool();
     myCollisionUpdateScheduled = in.getBool();
     myCollisionMask = in.getInt();
+    myCompositor.reset();
+    mySegmentCollisions = false;
 
     myMovementClock = in.getInt();
     myMovementInProgress = in.getBool();
@@ -348,8 +381,8 @@ bool TIA::load(Serializer& in)
 
     myCyclesAtFrameStart = in.getLong();
 
-    myFrameBufferScanlines = in.getInt();
-    myFrontBufferScanlines = in.getInt();
+    myFrameScanlines[myFrontFrame] = in.getInt();
+    myFrameScanlines[myReadyFrame.load() & FRAME_INDEX] = in.getInt();
 
     myPFBitsDelay = in.getByte();
     myPFColorDelay = in.getByte();
@@ -790,10 +823,12 @@ bool TIA::saveDisplay(Serializer& out) const
 {
   try
   {
-    out.putByteArray(myFramebuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-    out.putByteArray(myBackBuffer,  TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-    out.putByteArray(myFrontBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    out.putByteArray(myFrameBuffers[myFrontFrame], TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    out.putByteArray(myBackBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    out.putByteArray(myFrameBuffers[myReadyFrame.load() & FRAME_INDEX],
+                     TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
     out.putInt(myFramesSinceLastRender);
+    out.putBool(myReadyFrame.load() & FRAME_FRESH);
   }
   catch(...)
   {
@@ -810,10 +845,15 @@ bool TIA::loadDisplay(Serializer& in)
   try
   {
     // Reset frame buffer pointer and data
-    in.getByteArray(myFramebuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-    in.getByteArray(myBackBuffer,  TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
-    in.getByteArray(myFrontBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    const uInt32 readyFrame = myReadyFrame.load() & FRAME_INDEX;
+
+    in.getByteArray(myFrameBuffers[myFrontFrame], TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    in.getByteArray(myBackBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+    in.getByteArray(myFrameBuffers[readyFrame], TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
     myFramesSinceLastRender = in.getInt();
+    myReadyFrame = readyFrame | (in.getBool() ? FRAME_FRESH : 0);
+
+    markAllLinesChanged();
   }
   catch(...)
   {
@@ -879,15 +919,21 @@ void TIA::update(DispatchResult& result, uInt64 maxCycles)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::renderToFrameBuffer()
+void TIA::acquireLatestFrame()
 {
-  if (myFramesSinceLastRender == 0) return;
+  if (!newFramePending()) return;
 
   myFramesSinceLastRender = 0;
 
-  memcpy(myFramebuffer, myFrontBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+  // Hand our previous frame to the emulation and take the latest one
+  myFrontFrame = myReadyFrame.exchange(myFrontFrame) & FRAME_INDEX;
+}
 
-  myFrameBufferScanlines = myFrontBufferScanlines;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::clearPendingFrame()
+{
+  myFramesSinceLastRender = 0;
+  myReadyFrame &= FRAME_INDEX;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1190,6 +1236,8 @@ uInt8 TIA::registerValue(uInt8 reg) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateEmulation()
 {
+  PROFILE_SUBSYSTEM(tia);
+
   const uInt64 systemCycles = mySystem->cycles();
 
   if (mySubClock > TIAConstants::CYCLE_CLOCKS - 1)
@@ -1234,6 +1282,16 @@ void TIA::onFrameComplete()
   mySystem->m6502().stop();
   myCyclesAtFrameStart = mySystem->cycles();
 
+  // Nothing has been drawn, so there is nothing to publish either. Line
+  // hashes from before switching to headless mode are stale now.
+  if (myHeadless) {
+    ++myFrameSerial;
+    ++myFramesSinceLastRender;
+    return;
+  }
+
+  PROFILE_SUBSYSTEM(render);
+
   if (myXAtRenderingStart > 0)
     memset(myBackBuffer, 0, myXAtRenderingStart);
 
@@ -1242,9 +1300,13 @@ void TIA::onFrameComplete()
   if (missingScanlines > 0)
     memset(myBackBuffer + TIAConstants::H_PIXEL * myFrameManager->getY(), 0, missingScanlines * TIAConstants::H_PIXEL);
 
-  memcpy(myFrontBuffer, myBackBuffer, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight);
+  myFrameScanlines[myBackFrame] = scanlinesLastFrame();
+  updateLineChanges();
 
-  myFrontBufferScanlines = scanlinesLastFrame();
+  // Publish the frame and continue with the buffer that is not in use by
+  // the renderer (either the previous ready frame or the last acquired one)
+  myBackFrame = myReadyFrame.exchange(myBackFrame | FRAME_FRESH) & FRAME_INDEX;
+  myBackBuffer = myFrameBuffers[myBackFrame];
 
   ++myFramesSinceLastRender;
 }
@@ -1262,6 +1324,15 @@ void TIA::cycle(uInt32 colorClocks)
 {
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
+    // Fast forward over clocks in which nothing observable happens
+    const uInt32 idleClocks = clocksUntilNextEvent(colorClocks - i);
+    if (idleClocks > 1) {
+      skipClocks(idleClocks);
+      i += idleClocks - 1;
+
+      continue;
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
@@ -1272,23 +1343,73 @@ void TIA::cycle(uInt32 colorClocks)
     if (myLinesSinceChange < 2) {
       tickMovement();
 
-      if (myHstate == HState::blank)
+      if (myHstate == HState::blank) {
         tickHblank();
-      else
+
+        if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
+      }
+      else {
         tickHframe();
 
-      if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
+        // Collisions of visible pixels are latched in bulk by the compositor,
+        // unless the debugger has disabled some of them
+        if (!myFrameManager->vblank()) {
+          if (myHctr - TIAConstants::H_BLANK_CLOCKS - myHctrDelta < TIAConstants::H_PIXEL &&
+              (myCollisionsEnabledBits & 0x3F) == 0x3F)
+            mySegmentCollisions = true;
+          else
+            updateCollision();
+        }
+      }
     }
 
     if (++myHctr >= TIAConstants::H_CLOCKS)
       nextLine();
 
-    #ifdef SOUND_SUPPORT
-      myAudio.tick();
-    #endif
-
     ++myTimestamp;
   }
+
+  resolveSegment();
+
+  // Audio registers are only written between two runs, so the audio can
+  // catch up in a single batch
+  #ifdef SOUND_SUPPORT
+    myAudio.tick(colorClocks);
+  #endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::clocksUntilNextEvent(uInt32 maxClocks) const
+{
+  // Pending register writes and collision updates are handled clock by clock
+  if (myCollisionUpdateScheduled || !myDelayQueue.isEmpty()) return 0;
+
+  uInt32 clocks;
+
+  if (myLinesSinceChange >= 2)
+    // The line is cloned, so nothing happens until the end of the line
+    clocks = TIAConstants::H_CLOCKS - myHctr;
+  else if (myHstate == HState::blank && !myMovementInProgress && !myExtendedHblank &&
+           myHctr < TIAConstants::H_BLANK_CLOCKS - 1)
+    // Plain HBLANK: nothing happens until the transition to the visible frame
+    clocks = TIAConstants::H_BLANK_CLOCKS - 1 - myHctr;
+  else
+    return 0;
+
+  return std::min(clocks, maxClocks);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::skipClocks(uInt32 clocks)
+{
+  myDelayQueue.skip(clocks);
+  myCollisionUpdateRequired = false;
+
+  myHctr += clocks;
+  if (myHctr >= TIAConstants::H_CLOCKS)
+    nextLine();
+
+  myTimestamp += clocks;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1342,7 +1463,6 @@ void TIA::tickHblank()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::tickHframe()
 {
-  const uInt32 y = myFrameManager->getY();
   const uInt32 x = myHctr - TIAConstants::H_BLANK_CLOCKS - myHctrDelta;
 
   myCollisionUpdateRequired = true;
@@ -1354,8 +1474,15 @@ void TIA::tickHframe()
   myPlayer1.tick();
   myBall.tick();
 
-  if (myFrameManager->isRendering())
-    renderPixel(x, y);
+  if (x < TIAConstants::H_PIXEL)
+    myCompositor.record(x,
+      ((myPlayer0.collision  >> 15) << ScanlineCompositor::P0) |
+      ((myMissile0.collision >> 15) << ScanlineCompositor::M0) |
+      ((myPlayer1.collision  >> 15) << ScanlineCompositor::P1) |
+      ((myMissile1.collision >> 15) << ScanlineCompositor::M1) |
+      ((myPlayfield.collision >> 15) << ScanlineCompositor::PF) |
+      ((myBall.collision     >> 15) << ScanlineCompositor::BL)
+    );
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1364,7 +1491,7 @@ void TIA::applyRsync()
   const uInt32 x = myHctr > TIAConstants::H_BLANK_CLOCKS ? myHctr - TIAConstants::H_BLANK_CLOCKS : 0;
 
   myHctrDelta = TIAConstants::H_CLOCKS - 3 - myHctr;
-  if (myFrameManager->isRendering())
+  if (drawsPixels())
     memset(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL + x, 0, TIAConstants::H_PIXEL - x);
 
   myHctr = TIAConstants::H_CLOCKS - 3;
@@ -1373,10 +1500,25 @@ void TIA::applyRsync()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::nextLine()
 {
-  if (myLinesSinceChange >= 2) {
+  resolveSegment();
+
+  const bool cloned = myLinesSinceChange >= 2;
+  if (cloned) {
     cloneLastLine();
   }
 
+  if (drawsPixels()) {
+    const auto y = myFrameManager->getY();
+
+    // A cloned line has the same hash as its predecessor
+    if (cloned && y > 0) {
+      myLineHashes[y] = myLineHashes[y - 1];
+      myLineHashSerials[y] = myLineHashSerials[y - 1];
+    }
+    else
+      hashLine(y);
+  }
+
   myHctr = 0;
 
   if (!myMovementInProgress && myLinesSinceChange < 2) ++myLinesSinceChange;
@@ -1402,13 +1544,77 @@ void TIA::cloneLastLine()
 {
   const auto y = myFrameManager->getY();
 
-  if (!myFrameManager->isRendering() || y == 0) return;
+  if (!drawsPixels() || y == 0) return;
+
+  PROFILE_SUBSYSTEM(render);
 
   uInt8* buffer = myBackBuffer;
 
   memcpy(buffer + y * TIAConstants::H_PIXEL, buffer + (y-1) * TIAConstants::H_PIXEL, TIAConstants::H_PIXEL);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::hashLine(uInt32 y)
+{
+  const uInt8* line = myBackBuffer + y * TIAConstants::H_PIXEL;
+  uInt64 hash = 0xcbf29ce484222325ULL, word;
+
+  for (uInt32 x = 0; x < TIAConstants::H_PIXEL; x += sizeof(word))
+  {
+    memcpy(&word, line + x, sizeof(word));
+    hash = (hash ^ word) * 0x100000001b3ULL;
+    hash ^= hash >> 29;
+  }
+
+  myLineHashes[y] = hash;
+  myLineHashSerials[y] = myFrameSerial + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateLineChanges()
+{
+  // The first line and the missing lines have been blanked after drawing
+  if (myXAtRenderingStart > 0) hashLine(0);
+
+  const uInt32 firstMissing = std::min<uInt32>(myFrameManager->getY(), TIAConstants::frameBufferHeight);
+  const uInt32 lastMissing = std::min<uInt32>(
+    firstMissing + std::max<Int32>(myFrameManager->missingScanlines(), 0), TIAConstants::frameBufferHeight);
+  for (uInt32 y = firstMissing; y < lastMissing; ++y)
+    hashLine(y);
+
+  const uInt64 serial = ++myFrameSerial;
+
+  for (uInt32 y = 0; y < TIAConstants::frameBufferHeight; ++y)
+  {
+    // Lines that were not hashed in this frame are always considered changed
+    if (myLineHashSerials[y] != serial || myLineHashes[y] != myPreviousLineHashes[y])
+      myLineChanges[y] = serial;
+
+    myPreviousLineHashes[y] = myLineHashSerials[y] == serial ? myLineHashes[y] : 0;
+  }
+
+  myFrameSerials[myBackFrame] = serial;
+  memcpy(myFrameLineChanges[myBackFrame], myLineChanges, sizeof(myLineChanges));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::markAllLinesChanged()
+{
+  const uInt64 serial = ++myFrameSerial;
+
+  for (uInt32 y = 0; y < TIAConstants::frameBufferHeight; ++y)
+  {
+    myLineChanges[y] = serial;
+    myLineHashSerials[y] = 0;
+  }
+
+  for (uInt32 i = 0; i < 3; ++i)
+  {
+    myFrameSerials[i] = serial;
+    memcpy(myFrameLineChanges[i], myLineChanges, sizeof(myLineChanges));
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::scheduleCollisionUpdate()
 {
@@ -1429,61 +1635,71 @@ void TIA::updateCollision()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::renderPixel(uInt32 x, uInt32 y)
-{
-  if (x >= TIAConstants::H_PIXEL) return;
-
-  uInt8 color = 0;
-
-  if (!myFrameManager->vblank())
-  {
-    switch (myPriority)
-    {
-      case Priority::pfp:  // CTRLPF D2=1, D1=ignored
-        // Playfield has priority so ScoreBit isn't used
-        // Priority from highest to lowest:
-        //   BL/PF => P0/M0 => P1/M1 => BK
-        if (myPlayfield.isOn())       color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else if (myPlayer0.isOn())    color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else                          color = myBackground.getColor();
-        break;
-
-      case Priority::score:  // CTRLPF D2=0, D1=1
-        // Formally we have (priority from highest to lowest)
-        //   PF/P0/M0 => P1/M1 => BL => BK
-        // for the first half and
-        //   P0/M0 => PF/P1/M1 => BL => BK
-        // for the second half. However, the first ordering is equivalent
-        // to the second (PF has the same color as P0/M0), so we can just
-        // write
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
-
-      case Priority::normal:  // CTRLPF D2=0, D1=0
-        // Priority from highest to lowest:
-        //   P0/M0 => P1/M1 => BL/PF => BK
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
+void TIA::resolveSegment()
+{
+  using Object = ScanlineCompositor::Object;
+
+  // Objects in the order of increasing priority for each mode of the
+  // priority encoder
+  static constexpr Object order[3][ScanlineCompositor::numObjects] = {
+    // Priority::pfp (CTRLPF D2=1, D1=ignored)
+    // Playfield has priority so ScoreBit isn't used
+    // Priority from highest to lowest:
+    //   BL/PF => P0/M0 => P1/M1 => BK
+    { ScanlineCompositor::M1, ScanlineCompositor::P1, ScanlineCompositor::M0,
+      ScanlineCompositor::P0, ScanlineCompositor::BL, ScanlineCompositor::PF },
+    // Priority::score (CTRLPF D2=0, D1=1)
+    // Formally we have (priority from highest to lowest)
+    //   PF/P0/M0 => P1/M1 => BL => BK
+    // for the first half and
+    //   P0/M0 => PF/P1/M1 => BL => BK
+    // for the second half. However, the first ordering is equivalent
+    // to the second (PF has the same color as P0/M0), so we can just
+    // use the second
+    { ScanlineCompositor::BL, ScanlineCompositor::M1, ScanlineCompositor::P1,
+      ScanlineCompositor::PF, ScanlineCompositor::M0, ScanlineCompositor::P0 },
+    // Priority::normal (CTRLPF D2=0, D1=0)
+    // Priority from highest to lowest:
+    //   P0/M0 => P1/M1 => BL/PF => BK
+    { ScanlineCompositor::BL, ScanlineCompositor::PF, ScanlineCompositor::M1,
+      ScanlineCompositor::P1, ScanlineCompositor::M0, ScanlineCompositor::P0 }
+  };
+
+  if (myCompositor.isEmpty()) return;
+
+  PROFILE_SUBSYSTEM(render);
+
+  uInt8* line = nullptr;
+  uInt8 playfieldRow[TIAConstants::H_PIXEL];
+  ScanlineCompositor::Colors colors;
+
+  if (drawsPixels()) {
+    line = myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL;
+
+    colors.object[ScanlineCompositor::P0] = myPlayer0.getColor();
+    colors.object[ScanlineCompositor::M0] = myMissile0.getColor();
+    colors.object[ScanlineCompositor::P1] = myPlayer1.getColor();
+    colors.object[ScanlineCompositor::M1] = myMissile1.getColor();
+    colors.object[ScanlineCompositor::PF] = myPlayfield.getColor(0);
+    colors.object[ScanlineCompositor::BL] = myBall.getColor();
+    colors.playfieldRight = myPlayfield.getColor(TIAConstants::H_PIXEL / 2);
+    colors.background = myBackground.getColor();
+    colors.playfieldRow = nullptr;
+
+    if (myPlayfield.debugColorsEnabled()) {
+      for (uInt32 x = 0; x < TIAConstants::H_PIXEL; ++x)
+        playfieldRow[x] = myPlayfield.getColor(x);
+
+      colors.playfieldRow = playfieldRow;
     }
   }
 
-  myBackBuffer[y * TIAConstants::H_PIXEL + x] = color;
+  const uInt32 collisions = myCompositor.resolve(
+    line, order[static_cast<uInt32>(myPriority)], colors, myFrameManager->vblank()
+  );
+
+  if (mySegmentCollisions) myCollisionMask |= collisions;
+  mySegmentCollisions = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1492,6 +1708,7 @@ void TIA::flushLineCache()
   const bool wasCaching = myLinesSinceChange >= 2;
 
   myLinesSinceChange = 0;
+  resolveSegment();
 
   if (wasCaching) {
     const auto rewindCycles = myHctr;
@@ -1502,13 +1719,16 @@ void TIA::flushLineCache()
       else
         tickHframe();
     }
+
+    // The replayed pixels are rendered, but don't trigger collisions
+    resolveSegment();
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearHmoveComb()
 {
-  if (myFrameManager->isRendering() && myHstate == HState::blank)
+  if (drawsPixels() && myHstate == HState::blank)
     memset(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL, myColorHBlank, 8);
 }
 
@@ -1559,6 +1779,8 @@ void TIA::setBlInvertedPhaseClock(bool enable)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::delayedWrite(uInt8 address, uInt8 value)
 {
+  resolveSegment();
+
   if (address < 64)
     myShadowRegisters[address] = value;
 
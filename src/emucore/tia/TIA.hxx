@@ -19,6 +19,7 @@
 #define TIA_TIA
 
 #include <functional>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "ConsoleIO.hxx"
@@ -37,6 +38,7 @@
 #include "Missile.hxx"
 #include "Player.hxx"
 #include "Ball.hxx"
+#include "ScanlineCompositor.hxx"
 #include "LatchedInput.hxx"
 #include "PaddleReader.hxx"
 #include "DelayQueueIterator.hxx"
@@ -131,6 +133,24 @@ class TIA : public Device
     */
     void setAudioQueue(shared_ptr<AudioQueue> audioQueue);
 
+    /**
+      Enable or disable passing generated audio to the audio queue. Used
+      while emulating frames whose audio must not be heard (e.g. run-ahead).
+    */
+    void enableAudioOutput(bool enable);
+    bool isAudioOutputEnabled() const { return myAudioOutputEnabled; }
+
+    /**
+      Enable or disable headless mode. A headless TIA keeps the exact
+      register, collision and timing behaviour, but doesn't draw any pixels,
+      doesn't publish completed frames and doesn't generate audio. This is
+      meant for emulation whose output is thrown away anyway (autodetection,
+      run-ahead, profiling); switch it between frames, since a frame that
+      was only partly drawn is never presented correctly.
+    */
+    void setHeadless(bool headless);
+    bool isHeadless() const { return myHeadless; }
+
     /**
       Clear the configured frame manager and deteach the lifecycle callbacks.
      */
@@ -216,22 +236,24 @@ class TIA : public Device
     /**
       Did we generate a new frame?
      */
-    bool newFramePending() { return myFramesSinceLastRender  > 0; }
+    bool newFramePending() const { return myReadyFrame.load() & FRAME_FRESH; }
 
     /**
      * Clear any pending frames.
      */
-    void clearPendingFrame() { myFramesSinceLastRender = 0; }
+    void clearPendingFrame();
 
     /**
       The number of frames since we did last render to the front buffer.
      */
-    uInt32 framesSinceLastRender() { return myFramesSinceLastRender; }
+    uInt32 framesSinceLastRender() const { return myFramesSinceLastRender; }
 
     /**
-      Render the pending frame to the framebuffer and clear the flag.
+      Make the latest complete frame (if any new frame is pending) the frame
+      returned by frameBuffer() and clear the flag. Frames are handed over by
+      swapping buffer indices, so this is O(1) and lock-free.
      */
-    void renderToFrameBuffer();
+    void acquireLatestFrame();
 
     /**
       Return the buffer that holds the currently drawing TIA frame
@@ -240,9 +262,26 @@ class TIA : public Device
     uInt8* outputBuffer() { return myBackBuffer; }
 
     /**
-      Returns a pointer to the internal frame buffer.
+      Returns a pointer to the latest complete frame acquired by
+      acquireLatestFrame(). The buffer is stable until the next call.
     */
-    uInt8* frameBuffer() { return static_cast<uInt8*>(myFramebuffer); }
+    uInt8* frameBuffer() { return myFrameBuffers[myFrontFrame]; }
+
+    /**
+      Answers the serial number of the frame returned by frameBuffer(). Serial
+      numbers increase with every completed frame.
+    */
+    uInt64 frameSerial() const { return myFrameSerials[myFrontFrame]; }
+
+    /**
+      Did the given line of the frame returned by frameBuffer() change after
+      the frame with the given serial number (see frameSerial())? Lines are
+      compared against the same line of the preceding frame when a frame
+      completes, so unchanged lines need not be converted and uploaded again.
+    */
+    bool lineChangedSince(uInt32 y, uInt64 serial) const {
+      return myFrameLineChanges[myFrontFrame][y] > serial;
+    }
 
     /**
       Answers dimensional info about the framebuffer.
@@ -307,7 +346,7 @@ class TIA : public Device
     /**
       The same, but for the frame in the frame buffer.
      */
-    uInt32 frameBufferScanlinesLastFrame() const { return myFrameBufferScanlines; }
+    uInt32 frameBufferScanlinesLastFrame() const { return myFrameScanlines[myFrontFrame]; }
 
     /**
       Answers the total system cycles from the start of the emulation.
@@ -535,7 +574,7 @@ class TIA : public Device
     enum class HState {blank, frame};
 
     /**
-     * The three different modes of the priority encoder. Check TIA::renderPixel
+     * The three different modes of the priority encoder. Check TIA::resolveSegment
      * for a precise definition.
      */
     enum class Priority {pfp, score, normal};
@@ -570,6 +609,19 @@ class TIA : public Device
      */
     void cycle(uInt32 colorClocks);
 
+    /**
+     * Answers the number of clocks (up to maxClocks) until the next clock that
+     * has to be emulated individually (a pending delayed write, collision
+     * update, HBLANK edge, movement tick or the end of the scanline). Zero
+     * means that the next clock must be executed individually.
+     */
+    uInt32 clocksUntilNextEvent(uInt32 maxClocks) const;
+
+    /**
+     * Advance the given number of idle clocks (see clocksUntilNextEvent) in bulk.
+     */
+    void skipClocks(uInt32 clocks);
+
     /**
      * Advance the movement logic by a single clock.
      */
@@ -596,9 +648,28 @@ class TIA : public Device
     void applyRsync();
 
     /**
-     * Render the current pixel into the framebuffer.
+     * Hash the given (complete) line of the back buffer.
+     */
+    void hashLine(uInt32 y);
+
+    /**
+     * Determine the lines of the completed frame that differ from the
+     * previous frame.
+     */
+    void updateLineChanges();
+
+    /**
+     * Mark all lines of all frames as changed (e.g. after the buffers have
+     * been overwritten).
+     */
+    void markAllLinesChanged();
+
+    /**
+     * Render the pixels collected since the last call into the framebuffer and
+     * latch their collisions. This must happen before any state that affects
+     * rendering changes.
      */
-    void renderPixel(uInt32 x, uInt32 y);
+    void resolveSegment();
 
     /**
      * Clear the first 8 pixels of a scanline with black if we are in hblank
@@ -606,6 +677,11 @@ class TIA : public Device
      */
     void clearHmoveComb();
 
+    /**
+     * Are pixels of the current scanline drawn into the frame buffer?
+     */
+    bool drawsPixels() const { return !myHeadless && myFrameManager->isRendering(); }
+
     /**
      * Advance a line and update our state accordingly.
      */
@@ -735,8 +811,26 @@ class TIA : public Device
     Player myPlayer1;
     Ball myBall;
 
+    /**
+     * Collects the pixels of the current scanline segment and resolves their
+     * priorities and collisions in bulk.
+     */
+    ScanlineCompositor myCompositor;
+
+    /**
+     * Do the pixels of the current segment contribute to the collision latches?
+     */
+    bool mySegmentCollisions;
+
     Audio myAudio;
 
+    /**
+     * Headless mode (see setHeadless()) and whether audio output has been
+     * enabled independently of it.
+     */
+    bool myHeadless;
+    bool myAudioOutputEnabled;
+
     /**
      * The paddle readout circuits.
      */
@@ -748,20 +842,48 @@ class TIA : public Device
     LatchedInput myInput0;
     LatchedInput myInput1;
 
-    // Pointer to the internal color-index-based frame buffer
-    uInt8 myFramebuffer[TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight];
+    // Triple buffered, color-index-based frame buffers. At any time, one buffer
+    // is being drawn by the TIA (back), one holds the frame handed to the
+    // renderer (front), and one holds the latest complete frame (ready).
+    // Frames are handed over by swapping indices instead of copying.
+    uInt8 myFrameBuffers[3][TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight];
+
+    // We snapshot frame statistics when a frame is completed
+    uInt32 myFrameScanlines[3];
+
+    // The serial number of each frame, and the serial number of the
+    // frame in which each line of the frame changed last
+    uInt64 myFrameSerials[3];
+    uInt64 myFrameLineChanges[3][TIAConstants::frameBufferHeight];
+
+    // Serial number of the last completed frame
+    uInt64 myFrameSerial;
+
+    // Hashes of the lines of the frame being drawn, the serial number of the
+    // frame they were computed in, and the hashes of the previous frame
+    uInt64 myLineHashes[TIAConstants::frameBufferHeight];
+    uInt64 myLineHashSerials[TIAConstants::frameBufferHeight];
+    uInt64 myPreviousLineHashes[TIAConstants::frameBufferHeight];
+
+    // The serial number of the frame in which each line changed last
+    uInt64 myLineChanges[TIAConstants::frameBufferHeight];
+
+    // The buffer that the TIA currently draws to, and its index (only
+    // accessed by the emulation)
+    uInt8* myBackBuffer;
+    uInt32 myBackFrame;
 
-    // The frame is rendered to the backbuffer and only copied to the framebuffer
-    // upon completion
-    uInt8 myBackBuffer[TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight];
-    uInt8 myFrontBuffer[TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight];
+    // The index of the buffer returned by frameBuffer() (only accessed
+    // by the renderer)
+    uInt32 myFrontFrame;
 
-    // We snapshot frame statistics when the back buffer is copied to the front buffer
-    // and when the front buffer is copied to the frame buffer
-    uInt32 myFrontBufferScanlines, myFrameBufferScanlines;
+    // The index of the latest complete frame, shared by emulation and
+    // renderer; FRAME_FRESH is set if the frame has not been acquired yet
+    static constexpr uInt32 FRAME_INDEX = 0x03, FRAME_FRESH = 0x04;
+    std::atomic<uInt32> myReadyFrame;
 
     // Frames since the last time a frame was rendered to the render buffer
-    uInt32 myFramesSinceLastRender;
+    std::atomic<uInt32> myFramesSinceLastRender;
 
     /**
      * Setting this to true injects random values into undefined reads.
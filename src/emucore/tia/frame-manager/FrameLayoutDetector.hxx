@@ -37,6 +37,12 @@ class FrameLayoutDetector: public AbstractFrameManager {
      */
     FrameLayout detectedLayout() const;
 
+    /**
+     * The number of frames that were classified as NTSC / PAL so far.
+     */
+    uInt32 ntscFrames() const { return myNtscFrames; }
+    uInt32 palFrames() const { return myPalFrames; }
+
   protected:
 
     /**
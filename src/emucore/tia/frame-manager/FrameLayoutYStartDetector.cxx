@@ -0,0 +1,154 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FrameLayoutYStartDetector.hxx"
+#include "TIAConstants.hxx"
+
+/**
+ * Misc. numeric constants used in the algorithm.
+ */
+enum Metrics: uInt32 {
+  // the number of frames the layout detector used to run on its own; the
+  // layout decision is final once it cannot change anymore during this span
+  layoutFrames              = 60,
+
+  // the layout is considered stable if the leading layout has been detected
+  // for this many frames more than the other one
+  minLayoutLead             = 20,
+
+  // ystart is considered stable if the detector has been locked on the same
+  // value for this many frames
+  minStableYStartFrames     = 10,
+
+  // these frames will not be considered for detection
+  initialGarbageFrames      = TIAConstants::initialGarbageFrames
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameLayoutYStartDetector::FrameLayoutYStartDetector()
+  : myLayoutFixed(false)
+{
+  myYStartDetectorNTSC.setLayout(FrameLayout::ntsc);
+  myYStartDetectorPAL.setLayout(FrameLayout::pal);
+
+  myLayoutDetector.setHandlers(
+    [this] () { notifyFrameStart(); },
+    [this] () { onLayoutFrameComplete(); }
+  );
+
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameLayout FrameLayoutYStartDetector::detectedLayout() const
+{
+  return myLayoutFixed ? layout() : myLayoutDetector.detectedLayout();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FrameLayoutYStartDetector::detectedYStart() const
+{
+  return yStartDetector(detectedLayout()).detectedYStart();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameLayoutYStartDetector::isStable() const
+{
+  if (!myLayoutFixed) {
+    const uInt32
+      ntscFrames = myLayoutDetector.ntscFrames(),
+      palFrames = myLayoutDetector.palFrames(),
+      lead = ntscFrames > palFrames ? ntscFrames - palFrames : palFrames - ntscFrames,
+      detectedFrames = ntscFrames + palFrames,
+      remainingFrames = detectedFrames < Metrics::layoutFrames - Metrics::initialGarbageFrames ?
+        Metrics::layoutFrames - Metrics::initialGarbageFrames - detectedFrames : 0;
+
+    if (lead <= remainingFrames && lead < Metrics::minLayoutLead) return false;
+  }
+
+  const uInt32 stableYStartFrames = detectedLayout() == FrameLayout::pal ?
+    myStableYStartFramesPAL : myStableYStartFramesNTSC;
+
+  return stableYStartFrames >= Metrics::minStableYStartFrames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::setLayout(FrameLayout layout)
+{
+  myLayoutFixed = true;
+  this->layout(layout);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::onReset()
+{
+  myYStartDetectorNTSC.reset();
+  myYStartDetectorPAL.reset();
+  myLayoutDetector.reset();
+
+  myStableYStartFramesNTSC = myStableYStartFramesPAL = 0;
+  myLastYStartNTSC = myLastYStartPAL = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::onSetVblank()
+{
+  myYStartDetectorNTSC.setVblank(myVblank);
+  myYStartDetectorPAL.setVblank(myVblank);
+  myLayoutDetector.setVblank(myVblank);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::onSetVsync()
+{
+  myYStartDetectorNTSC.setVsync(myVsync);
+  myYStartDetectorPAL.setVsync(myVsync);
+  myLayoutDetector.setVsync(myVsync);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::onNextLine()
+{
+  myYStartDetectorNTSC.nextLine();
+  myYStartDetectorPAL.nextLine();
+  myLayoutDetector.nextLine();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameLayoutYStartDetector::onLayoutFrameComplete()
+{
+  auto updateStableFrames = [] (const YStartDetector& detector, uInt32& stableFrames,
+                                uInt32& lastYStart) {
+    if (detector.isLocked() && detector.detectedYStart() == lastYStart)
+      ++stableFrames;
+    else
+      stableFrames = 0;
+
+    lastYStart = detector.detectedYStart();
+  };
+
+  updateStableFrames(myYStartDetectorNTSC, myStableYStartFramesNTSC, myLastYStartNTSC);
+  updateStableFrames(myYStartDetectorPAL, myStableYStartFramesPAL, myLastYStartPAL);
+
+  notifyFrameComplete();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const YStartDetector& FrameLayoutYStartDetector::yStartDetector(FrameLayout layout) const
+{
+  return layout == FrameLayout::pal ? myYStartDetectorPAL : myYStartDetectorNTSC;
+}
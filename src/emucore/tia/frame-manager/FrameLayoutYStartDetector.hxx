@@ -0,0 +1,134 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIA_FRAME_LAYOUT_YSTART_DETECTOR
+#define TIA_FRAME_LAYOUT_YSTART_DETECTOR
+
+#include "AbstractFrameManager.hxx"
+#include "FrameLayoutDetector.hxx"
+#include "YStartDetector.hxx"
+
+/**
+ * This frame manager detects frame layout and ystart in a single run. It feeds
+ * a frame layout detector and a ystart detector for each layout with the same
+ * signals, so the emulation has to be run only once. The frame boundaries are
+ * those of the layout detector.
+ *
+ * Detection is finished once both results have settled (see isStable()); the
+ * caller is expected to stop running the emulation at this point.
+ */
+class FrameLayoutYStartDetector: public AbstractFrameManager {
+  public:
+
+    FrameLayoutYStartDetector();
+
+  public:
+
+    /**
+     * The maximum number of frames that detection should be allowed to run.
+     */
+    static constexpr uInt32 maxFrames = 80;
+
+    /**
+     * Return the detected frame layout (or the layout configured via setLayout).
+     */
+    FrameLayout detectedLayout() const;
+
+    /**
+     * Return the ystart value detected for the frame layout above.
+     */
+    uInt32 detectedYStart() const;
+
+    /**
+     * Have both frame layout and ystart settled, so that running more frames
+     * would not change the result?
+     */
+    bool isStable() const;
+
+    /**
+     * Fix the frame layout from outside. Only ystart is detected in this case.
+     */
+    void setLayout(FrameLayout layout) override;
+
+  protected:
+
+    /**
+     * Forward vblank changes.
+     */
+    void onSetVblank() override;
+
+    /**
+     * Forward vsync changes.
+     */
+    void onSetVsync() override;
+
+    /**
+     * Reset hook.
+     */
+    void onReset() override;
+
+    /**
+     * Forward line changes.
+     */
+    void onNextLine() override;
+
+  private:
+
+    /**
+     * Frame completion handler for the layout detector. Updates the stability
+     * statistics and signals the frame to the TIA.
+     */
+    void onLayoutFrameComplete();
+
+    /**
+     * The ystart detector for the given frame layout.
+     */
+    const YStartDetector& yStartDetector(FrameLayout layout) const;
+
+  private:
+
+    /**
+     * The detectors that do the actual work.
+     */
+    FrameLayoutDetector myLayoutDetector;
+    YStartDetector myYStartDetectorNTSC, myYStartDetectorPAL;
+
+    /**
+     * Has the layout been fixed via setLayout?
+     */
+    bool myLayoutFixed;
+
+    /**
+     * The number of consecutive frames the respective ystart detector has been
+     * locked on the same value.
+     */
+    uInt32 myStableYStartFramesNTSC, myStableYStartFramesPAL;
+
+    /**
+     * The ystart values of the respective detectors on the last frame.
+     */
+    uInt32 myLastYStartNTSC, myLastYStartPAL;
+
+  private:
+
+    FrameLayoutYStartDetector(const FrameLayoutYStartDetector&) = delete;
+    FrameLayoutYStartDetector(FrameLayoutYStartDetector&&) = delete;
+    FrameLayoutYStartDetector& operator=(const FrameLayoutYStartDetector&) = delete;
+    FrameLayoutYStartDetector& operator=(FrameLayoutYStartDetector&&) = delete;
+};
+
+#endif // TIA_FRAME_LAYOUT_YSTART_DETECTOR
@@ -37,6 +37,11 @@ class YStartDetector: public AbstractFrameManager {
      */
     uInt32 detectedYStart() const;
 
+    /**
+     * Has the detector settled on a frame start?
+     */
+    bool isLocked() const { return myVblankMode == VblankMode::locked; }
+
     /**
      * We require frame layout to be set from outside.
      */
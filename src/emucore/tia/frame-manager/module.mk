@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	src/emucore/tia/frame-manager/FrameManager.o \
 	src/emucore/tia/frame-manager/AbstractFrameManager.o \
 	src/emucore/tia/frame-manager/FrameLayoutDetector.o \
+	src/emucore/tia/frame-manager/FrameLayoutYStartDetector.o \
 	src/emucore/tia/frame-manager/YStartDetector.o \
 	src/emucore/tia/frame-manager/JitterEmulation.o
 
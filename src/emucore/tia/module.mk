@@ -3,6 +3,7 @@ MODULE := src/emucore/tia
 MODULE_OBJS := \
 	src/emucore/tia/TIA.o \
 	src/emucore/tia/Playfield.o \
+	src/emucore/tia/ScanlineCompositor.o \
 	src/emucore/tia/DrawCounterDecodes.o \
 	src/emucore/tia/Missile.o \
 	src/emucore/tia/Player.o \
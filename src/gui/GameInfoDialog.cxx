@@ -38,6 +38,7 @@
 #include "TIA.hxx"
 #include "Switches.hxx"
 #include "AudioSettings.hxx"
+#include "StateManager.hxx"
 
 #include "GameInfoDialog.hxx"
 
@@ -127,6 +128,13 @@ GameInfoDialog::GameInfoDialog(
   mySound = new CheckboxWidget(myTab, font, HBORDER, ypos + 1, "Stereo sound");
   wid.push_back(mySound);
 
+  ypos += lineHeight + VGAP * 4;
+  myRunAhead = new SliderWidget(myTab, font, HBORDER, ypos,
+                                "Run-ahead ", 0, kRunAheadChanged, 4 * fontWidth, " frames");
+  myRunAhead->setMinValue(0); myRunAhead->setMaxValue(StateManager::MAX_RUN_AHEAD_FRAMES);
+  myRunAhead->setTickmarkInterval(4);
+  wid.push_back(myRunAhead);
+
   // Add message concerning usage
   ypos = myTab->getHeight() - 5 - fontHeight - ifont.getFontHeight() - 10;
   new StaticTextWidget(myTab, ifont, HBORDER, ypos,
@@ -405,6 +413,9 @@ void GameInfoDialog::loadEmulationProperties(const Properties& props)
   mySound->setState(props.get(PropType::Cart_Sound) == "STEREO");
   // if stereo is always enabled, disable game specific stereo setting
   mySound->setEnabled(!instance().audioSettings().stereo());
+
+  const string& runAhead = props.get(PropType::Display_RunAhead);
+  myRunAhead->setValue(atoi(runAhead.c_str()));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -517,6 +528,8 @@ void GameInfoDialog::saveConfig()
   myGameProperties.set(PropType::Display_PPBlend, myPPBlend->getValueLabel() == "Off" ? "0" :
                        myPPBlend->getValueLabel());
   myGameProperties.set(PropType::Cart_Sound, mySound->getState() ? "STEREO" : "MONO");
+  myGameProperties.set(PropType::Display_RunAhead, myRunAhead->getValueLabel() == "Off" ? "0" :
+                       myRunAhead->getValueLabel());
 
   // Console properties
   myGameProperties.set(PropType::Console_LeftDiff, myLeftDiffGroup->getSelected() ? "B" : "A");
@@ -559,6 +572,7 @@ void GameInfoDialog::saveConfig()
     instance().console().setFormat(myFormat->getSelected());
     instance().frameBuffer().tiaSurface().enablePhosphor(myPhosphor->getState(), myPPBlend->getValue());
     instance().console().initializeAudio();
+    instance().state().setRunAheadFrames(myRunAhead->getValue());
 
     // update 'Console' tab settings immediately
     instance().console().switches().setTvColor(myTVTypeGroup->getSelected() == 0);
@@ -710,6 +724,16 @@ void GameInfoDialog::handleCommand(CommandSender* sender, int cmd,
         myPPBlend->setValueUnit("%");
       break;
 
+    case kRunAheadChanged:
+      if(myRunAhead->getValue() == 0)
+      {
+        myRunAhead->setValueLabel("Off");
+        myRunAhead->setValueUnit("");
+      }
+      else
+        myRunAhead->setValueUnit(myRunAhead->getValue() == 1 ? " frame" : " frames");
+      break;
+
     case kMCtrlChanged:
     {
       bool state = myMouseControl->getState();
@@ -68,6 +68,7 @@ class GameInfoDialog : public Dialog, public CommandSender
     CheckboxWidget*   myPhosphor;
     SliderWidget*     myPPBlend;
     CheckboxWidget*   mySound;
+    SliderWidget*     myRunAhead;
 
     // Console properties
     RadioButtonGroup* myLeftDiffGroup;
@@ -102,6 +103,7 @@ class GameInfoDialog : public Dialog, public CommandSender
     enum {
       kPhosphorChanged = 'PPch',
       kPPBlendChanged = 'PBch',
+      kRunAheadChanged = 'RAch',
       kLeftCChanged    = 'LCch',
       kRightCChanged   = 'RCch',
       kMCtrlChanged    = 'MCch',
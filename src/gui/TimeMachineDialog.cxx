@@ -175,7 +175,7 @@ TimeMachineDialog::TimeMachineDialog(OSystem& osystem, DialogContainer& parent,
 
   // Set real dimensions
   _w = width;  // Parent determines our width (based on window size)
-  _h = V_BORDER * 2 + rowHeight + buttonHeight + 2;
+  _h = V_BORDER * 2 + rowHeight * 2 + buttonHeight + 2;
 
   this->clearFlags(Widget::FLAG_CLEARBG); // does only work combined with blending (0..100)!
   this->clearFlags(Widget::FLAG_BORDER);
@@ -236,6 +236,13 @@ TimeMachineDialog::TimeMachineDialog(OSystem& osystem, DialogContainer& parent,
   myMessageWidget = new StaticTextWidget(this, font, xpos, ypos + 3, "                                             ",
                                          TextAlign::Left, kBGColor);
   myMessageWidget->setTextColor(kColorInfo);
+
+  // Add memory and timing statistics
+  xpos = H_BORDER;
+  ypos += buttonHeight + 2;
+  myStatsWidget = new StaticTextWidget(this, font, xpos, ypos, _w - H_BORDER * 2, font.getFontHeight(),
+                                       "", TextAlign::Left, kBGColor);
+  myStatsWidget->setTextColor(kColorInfo);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -411,6 +418,13 @@ void TimeMachineDialog::handleWinds(Int32 numWinds)
   // Update index
   myCurrentIdxWidget->setValue(r.getCurrentIdx());
   myLastIdxWidget->setValue(r.getLastIdx());
+  // Update statistics
+  const size_t memory = r.memoryUsage();
+  ostringstream stats;
+  stats << "Memory " << (memory + 1023) / 1024 << " KB, "
+        << (r.getLastIdx() ? memory / r.getLastIdx() : 0) << " bytes/state, "
+        << "encode " << r.encodeTime() << " us, decode " << r.decodeTime() << " us";
+  myStatsWidget->setLabel(stats.str());
   // Enable/disable buttons
   myRewindAllWidget->setEnabled(!r.atFirst());
   myRewind1Widget->setEnabled(!r.atFirst());
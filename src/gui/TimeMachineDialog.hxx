@@ -79,6 +79,7 @@ class TimeMachineDialog : public Dialog
     StaticTextWidget* myCurrentIdxWidget;
     StaticTextWidget* myLastIdxWidget;
     StaticTextWidget* myMessageWidget;
+    StaticTextWidget* myStatsWidget;
 
     Int32 _enterWinds;
 
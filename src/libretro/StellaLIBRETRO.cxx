@@ -156,8 +156,14 @@ void StellaLIBRETRO::destroy()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void StellaLIBRETRO::runFrame()
+void StellaLIBRETRO::runFrame(bool video, bool audio)
 {
+  TIA& tia = myOSystem->console().tia();
+
+  // don't draw or mix anything the frontend is going to discard
+  tia.setHeadless(!video && !audio);
+  tia.enableAudioOutput(audio);
+
   // write ram updates
   for(int lcv = 0; lcv <= 127; lcv++)
     myOSystem->console().system().m6532().poke(lcv | 0x80, system_ram[lcv]);
@@ -201,6 +207,9 @@ void StellaLIBRETRO::updateVideo()
     if(!beam_y) break;
   }
 
+  // run ahead on a hidden snapshot, so the presented frame already
+  // reflects the current input
+  myOSystem->state().runAhead();
 
   video_ready = tia.newFramePending();
 
@@ -208,7 +217,7 @@ void StellaLIBRETRO::updateVideo()
   {
     FrameBuffer& frame = myOSystem->frameBuffer();
 
-    tia.renderToFrameBuffer();
+    tia.acquireLatestFrame();
     frame.updateInEmulationMode(0);
   }
 }
@@ -224,6 +233,7 @@ bool StellaLIBRETRO::loadState(const void* data, size_t size)
 {
   Serializer state;
 
+  state.reserve(size);
   state.putByteArray(reinterpret_cast<const uInt8*>(data), static_cast<uInt32>(size));
 
   if(!myOSystem->state().loadState(state))
@@ -244,7 +254,7 @@ bool StellaLIBRETRO::saveState(void* data, size_t size)
   if (state.size() > size)
     return false;
 
-  state.getByteArray(reinterpret_cast<uInt8*>(data), static_cast<uInt32>(state.size()));
+  memcpy(data, state.data(), state.size());
   return true;
 }
 
@@ -49,7 +49,7 @@ class StellaLIBRETRO
     void destroy();
     void reset() { myOSystem->console().system().reset(); }
 
-    void runFrame();
+    void runFrame(bool video = true, bool audio = true);
 
     bool loadState(const void* data, size_t size);
     bool saveState(void* data, size_t size);
@@ -562,8 +562,12 @@ void retro_run()
 
   update_input();
 
+  // the frontend may not need the output of this frame (e.g. run-ahead)
+  int av_enable = 3;
+  if(!environ_cb(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &av_enable))
+    av_enable = 3;
 
-  stella.runFrame();
+  stella.runFrame(av_enable & 1, av_enable & 2);
 
   if(stella.getVideoResize())
     update_geometry();
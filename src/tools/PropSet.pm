@@ -23,7 +23,8 @@ my %prop_type = (
   "Display.Format"          => 17,
   "Display.YStart"          => 18,
   "Display.Phosphor"        => 19,
-  "Display.PPBlend"         => 20
+  "Display.PPBlend"         => 20,
+  "Display.RunAhead"        => 21
 );
 my @prop_type_as_string = (
   "Cart.MD5",
@@ -46,7 +47,8 @@ my @prop_type_as_string = (
   "Display.Format",
   "Display.YStart",
   "Display.Phosphor",
-  "Display.PPBlend"
+  "Display.PPBlend",
+  "Display.RunAhead"
 );
 
 my @prop_defaults = (
@@ -70,6 +72,7 @@ my @prop_defaults = (
   "AUTO",
   "0",
   "NO",
+  "0",
   "0"
 );
 